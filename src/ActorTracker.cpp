@@ -0,0 +1,76 @@
+#include <algorithm>
+#include <bit>
+#include "ActorTracker.h"
+#include "Trace.h"
+
+ActorTracker::ActorTracker() {
+	this->reset();
+}
+
+auto ActorTracker::reset() -> void {
+	this->runtimeIds.fill(-1);
+	this->lastBehaviours.fill(ECompiledBehaviorType::BT_Invalid);
+	this->highestTension.fill(0);
+	this->scanned.fill(0);
+	this->tense.fill(0);
+	this->targets.fill(0);
+	std::fill_n(this->repoIds.begin(), this->described, RepoId());
+	this->described = 0;
+	this->cursor = 0;
+	this->sliceMicroseconds = 0;
+	this->frame = 0;
+	this->latency = 0;
+	this->changeCount = 0;
+}
+
+auto ActorTracker::beginFrame(ActorSource& source, ActorFrame& frame) -> size_t {
+	auto const count = std::min(source.getActorCount(), MaxActors);
+	++this->frame;
+
+	size_t newTargets = 0;
+	for (; this->described < count; ++this->described) {
+		auto const index = this->described;
+		auto description = source.describe(index);
+		this->repoIds[index] = description.repoId;
+		if (!description.isTarget) continue;
+		this->targets[index / 64] |= uint64_t(1) << (index % 64);
+		this->newTargets[newTargets++] = static_cast<uint16_t>(index);
+	}
+	frame.newTargets = std::span(this->newTargets).first(newTargets);
+
+	return count;
+}
+
+// Done once the scan is, as building the records would keep the scan's loop from staying in registers.
+auto ActorTracker::traceChanges() -> void {
+	if (Trace::isEnabled()) {
+		for (auto const index : std::span(this->changes).first(this->changeCount)) {
+			auto const behaviour = this->lastBehaviours[index];
+			if (behaviour == ECompiledBehaviorType::BT_Act) continue;
+
+			Trace::push(TraceRecord::behaviourChanged(index, this->repoIds[index], static_cast<int32_t>(behaviour), getBehaviourTension(behaviour)));
+		}
+	}
+	this->changeCount = 0;
+}
+
+auto ActorTracker::prioritize(size_t count) -> std::span<const uint16_t> {
+	size_t priority = 0;
+	for (size_t word = 0; word * 64 < count; ++word) {
+		for (auto bits = this->tense[word] | this->targets[word]; bits; bits &= bits - 1) {
+			auto const index = word * 64 + std::countr_zero(bits);
+			if (index < count) this->priority[priority++] = static_cast<uint16_t>(index);
+		}
+	}
+	return std::span(this->priority).first(priority);
+}
+
+// Every actor in a slice goes as long between scans as the slice does, bar those scanned every frame, so the latency
+// is kept per slice rather than per actor.
+auto ActorTracker::markScanned(size_t first, size_t count) -> void {
+	for (auto slice = first / SliceSize; slice * SliceSize < first + count; ++slice) {
+		auto const last = this->scanned[slice];
+		if (last) this->latency = std::max(this->latency, this->frame - last);
+		this->scanned[slice] = this->frame;
+	}
+}
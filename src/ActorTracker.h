@@ -0,0 +1,233 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include "Enums.h"
+#include "RepoId.h"
+
+// Where the ActorTracker reads actors from each frame: the game's actor manager in the mod, or synthetic actors in the
+// benchmarks. Sources are final classes, which the tracker is given as such so their reads are inlined into its scan.
+class ActorSource
+{
+public:
+	struct Description
+	{
+		RepoId repoId;
+		bool isTarget = false;
+	};
+
+	// Actors without a spatial entity or runtime ID have -1 and ActorTracker::NoBehaviour, as do the behaviours of
+	// those without a current one.
+	struct State
+	{
+		int32_t runtimeId = -1;
+		ECompiledBehaviorType behaviour = static_cast<ECompiledBehaviorType>(-1);
+	};
+
+	virtual ~ActorSource() = default;
+
+	// Number of activated actors. Those past ActorTracker::MaxActors aren't tracked.
+	virtual auto getActorCount() -> size_t = 0;
+	// Describes the actor at the index, the first time it's seen in the contract.
+	virtual auto describe(size_t index) -> Description = 0;
+	// The behaviour runtime ID and current behaviour of the actor at the index.
+	virtual auto read(size_t index) -> State = 0;
+};
+
+// What changed in a frame, for the stats to be updated from.
+struct ActorFrame
+{
+	// Tension added by actors reaching a higher level than they had this contract, and the number of them.
+	int tension = 0;
+	int tensionRaises = 0;
+	int closeCombatEngagements = 0;
+	// Indices of targets seen for the first time.
+	std::span<const uint16_t> newTargets;
+};
+
+// Per-actor state for the contract, by actor index, kept as columns. The columns written every frame (runtime IDs and
+// last behaviours) are separate from those only touched when an actor is first seen (repo IDs and targets), so the
+// per-frame pass over 1000 actors streams through a few KB. Each actor is read, compared and, in the rare case its
+// behaviour changed, applied to the frame in that one pass, which never calls out of line so the loop stays in
+// registers. Tracing the changes is left until after it.
+// With a budget set, only the targets and actors in a tense behaviour are scanned every frame. The rest are scanned a
+// slice at a time, round-robin, for as long as the budget allows, so each is visited every few frames instead.
+class ActorTracker
+{
+public:
+	static constexpr size_t MaxActors = 1000;
+	static constexpr size_t SliceSize = 64;
+	static constexpr auto NoBehaviour = static_cast<ECompiledBehaviorType>(-1);
+
+	ActorTracker();
+
+	auto reset() -> void;
+
+	template<std::derived_from<ActorSource> TSource>
+	auto update(TSource& source) -> ActorFrame {
+		auto frame = ActorFrame{};
+		auto const count = this->beginFrame(source, frame);
+
+		if (this->budget <= 0) {
+			this->scan(source, 0, count, frame);
+			this->markScanned(0, count);
+		}
+		else this->scanWithinBudget(source, count, frame);
+
+		this->traceChanges();
+		return frame;
+	}
+
+	// Microseconds each frame may spend scanning actors, or 0 to scan them all. Those scanned every frame are scanned
+	// regardless, as is at least one slice of the rest however small the budget.
+	auto setBudget(double microseconds) -> void {
+		this->budget = microseconds;
+	}
+
+	// The most frames between two scans of the same actor this contract.
+	auto getScanLatency() const -> uint32_t {
+		return this->latency;
+	}
+
+	// Number of actors seen this contract.
+	auto size() const -> size_t {
+		return this->described;
+	}
+
+	auto getRepoId(size_t index) const -> const RepoId& {
+		return this->repoIds[index];
+	}
+
+	auto isTarget(size_t index) const -> bool {
+		return this->targets[index / 64] >> (index % 64) & 1;
+	}
+
+	auto getRuntimeId(size_t index) const -> int32_t {
+		return this->runtimeIds[index];
+	}
+
+	auto getLastBehaviour(size_t index) const -> ECompiledBehaviorType {
+		return this->lastBehaviours[index];
+	}
+
+	auto getHighestTension(size_t index) const -> int {
+		return this->highestTension[index];
+	}
+
+private:
+	using Microseconds = std::chrono::duration<double, std::micro>;
+
+	// Describes the actors new this frame, and returns how many there are to scan.
+	auto beginFrame(ActorSource& source, ActorFrame& frame) -> size_t;
+	auto traceChanges() -> void;
+
+	template<typename TSource>
+	auto scanWithinBudget(TSource& source, size_t count, ActorFrame& frame) -> void {
+		if (!count) return;
+
+		auto const sliceCount = (count + SliceSize - 1) / SliceSize;
+		auto slices = sliceCount;
+
+		// While every slice fits, they're all scanned and nothing need be first.
+		if (this->sliceMicroseconds <= 0 || this->sliceMicroseconds * static_cast<double>(sliceCount) > this->budget) {
+			auto const start = std::chrono::steady_clock::now();
+
+			// Targets and actors in a tense behaviour are scanned every frame, so one going on to something tenser
+			// isn't missed. A calm actor is only missed entering a tense behaviour if it leaves before its slice comes
+			// round.
+			for (auto const index : this->prioritize(count)) this->scan(source, index, 1, frame);
+
+			// Then as many slices of the rest as the time left fits, going by how long they've been taking. Checking
+			// the clock after each would cost more than some slices do.
+			auto const remaining = this->budget - Microseconds(std::chrono::steady_clock::now() - start).count();
+			slices = 1;
+			if (this->sliceMicroseconds > 0 && remaining > this->sliceMicroseconds)
+				slices = std::min(static_cast<size_t>(remaining / this->sliceMicroseconds), sliceCount);
+		}
+
+		auto const slicesStart = std::chrono::steady_clock::now();
+
+		for (size_t i = 0; i < slices; ++i) {
+			if (this->cursor >= count) this->cursor = 0;
+
+			auto const size = std::min(SliceSize, count - this->cursor);
+			this->scan(source, this->cursor, size, frame);
+			this->markScanned(this->cursor, size);
+			this->cursor += size;
+		}
+
+		auto const elapsed = Microseconds(std::chrono::steady_clock::now() - slicesStart).count() / static_cast<double>(slices);
+		this->sliceMicroseconds = this->sliceMicroseconds > 0 ? this->sliceMicroseconds * 0.9 + elapsed * 0.1 : elapsed;
+	}
+
+	// Reads each actor and applies its behaviour if it differs from the last it had, which it becomes. Those without a
+	// behaviour this frame keep the last one.
+	template<typename TSource>
+	auto scan(TSource& source, size_t first, size_t count, ActorFrame& frame) -> void {
+		for (auto i = first; i < first + count; ++i) {
+			auto const state = source.read(i);
+			auto const last = this->lastBehaviours[i];
+			auto const present = state.behaviour != NoBehaviour;
+			this->runtimeIds[i] = state.runtimeId;
+			this->lastBehaviours[i] = present ? state.behaviour : last;
+			if (present & (state.behaviour != last)) [[unlikely]] this->applyChange(i, frame);
+		}
+	}
+
+	auto applyChange(size_t index, ActorFrame& frame) -> void {
+		auto const behaviour = this->lastBehaviours[index];
+		auto const tension = getBehaviourTension(behaviour);
+		this->changes[this->changeCount++] = static_cast<uint16_t>(index);
+
+		auto const bit = uint64_t(1) << (index % 64);
+		if (!tension) {
+			this->tense[index / 64] &= ~bit;
+			return;
+		}
+		this->tense[index / 64] |= bit;
+
+		if (behaviour == ECompiledBehaviorType::BT_CloseCombat)
+			++frame.closeCombatEngagements;
+
+		auto& highest = this->highestTension[index];
+		if (tension > highest) {
+			frame.tension += tension - highest;
+			++frame.tensionRaises;
+			highest = tension;
+		}
+	}
+
+	// The targets and actors in a tense behaviour, among the first count.
+	auto prioritize(size_t count) -> std::span<const uint16_t>;
+	auto markScanned(size_t first, size_t count) -> void;
+
+private:
+	// Hot columns, written every frame.
+	std::array<int32_t, MaxActors> runtimeIds;
+	std::array<ECompiledBehaviorType, MaxActors> lastBehaviours;
+	std::array<int32_t, MaxActors> highestTension;
+	// A bit per actor, set for those scanned every frame.
+	std::array<uint64_t, (MaxActors + 63) / 64> tense;
+	std::array<uint64_t, (MaxActors + 63) / 64> targets;
+
+	// Cold columns, written when an actor is first seen.
+	std::array<RepoId, MaxActors> repoIds;
+	std::array<uint16_t, MaxActors> newTargets;
+	std::array<uint16_t, MaxActors> priority;
+	// Actors whose behaviour changed this frame. Scanning one again in the same frame finds no change, so there's
+	// room for every actor.
+	std::array<uint16_t, MaxActors> changes;
+	size_t changeCount = 0;
+	// Frame each slice was last scanned in.
+	std::array<uint32_t, (MaxActors + SliceSize - 1) / SliceSize> scanned;
+	size_t described = 0;
+	size_t cursor = 0;
+	double sliceMicroseconds = 0;
+	uint32_t frame = 0;
+	uint32_t latency = 0;
+	double budget = 0;
+};
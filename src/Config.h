@@ -32,6 +32,14 @@ struct ConfigData
 	DockMode overlayDockMode = DockMode::None;
 	OverlayDetailMode overlayDetail = OverlayDetailMode::WithNames;
 	bool overlayTransparency = true;
+	bool threadedEvents = false;
+	bool recordJournal = false;
+	bool trace = false;
+	bool recordTimeline = false;
+	// Seconds of game time witness events are kept for (see WitnessEventStore).
+	int witnessRetention = 60;
+	// Microseconds per frame the actor scan may take (see ActorTracker), or 0 to scan every actor every frame.
+	int actorScanBudget = 0;
 	bool liveSplitEnabled = false;
 	std::string liveSplitIP = "127.0.0.1";
 	uint16_t liveSplitPort = 16834;
@@ -49,6 +57,12 @@ public:
 		data.externalWindowOnTop = plugin.GetSettingBool("general", "external_window_on_top", data.externalWindowOnTop);
 		data.inGameOverlay = plugin.GetSettingBool("general", "overlay", data.inGameOverlay);
 		data.inGameOverlayDetailed = plugin.GetSettingBool("general", "overlay_detailed", data.inGameOverlayDetailed);
+		data.threadedEvents = plugin.GetSettingBool("general", "threaded_events", data.threadedEvents);
+		data.recordJournal = plugin.GetSettingBool("general", "record_journal", data.recordJournal);
+		data.trace = plugin.GetSettingBool("general", "trace", data.trace);
+		data.recordTimeline = plugin.GetSettingBool("general", "record_timeline", data.recordTimeline);
+		data.witnessRetention = plugin.GetSettingInt("general", "witness_retention", data.witnessRetention);
+		data.actorScanBudget = plugin.GetSettingInt("general", "actor_scan_budget", data.actorScanBudget);
 		data.liveSplitEnabled = plugin.GetSettingBool("livesplit", "enabled", data.liveSplitEnabled);
 		data.liveSplitIP = plugin.GetSetting("livesplit", "ip", data.liveSplitIP);
 		data.liveSplitPort = plugin.GetSettingInt("livesplit", "port", data.liveSplitPort);
@@ -85,6 +99,12 @@ public:
 		plugin.SetSettingBool("general", "overlay_detailed", data.inGameOverlayDetailed);
 		plugin.SetSettingBool("general", "overlay_transparency", data.overlayTransparency);
 		plugin.SetSettingBool("general", "use_extended_shorthand", data.useExtendedShorthand);
+		plugin.SetSettingBool("general", "threaded_events", data.threadedEvents);
+		plugin.SetSettingBool("general", "record_journal", data.recordJournal);
+		plugin.SetSettingBool("general", "trace", data.trace);
+		plugin.SetSettingBool("general", "record_timeline", data.recordTimeline);
+		plugin.SetSettingInt("general", "witness_retention", data.witnessRetention);
+		plugin.SetSettingInt("general", "actor_scan_budget", data.actorScanBudget);
 		plugin.SetSettingBool("livesplit", "enabled", data.liveSplitEnabled);
 		plugin.SetSetting("livesplit", "ip", data.liveSplitIP);
 		plugin.SetSettingInt("livesplit", "port", data.liveSplitPort);
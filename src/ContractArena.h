@@ -0,0 +1,179 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "Memory.h"
+
+// Monotonic arena for the containers which only live as long as a contract. Allocation bumps a pointer through a list
+// of blocks and freeing does nothing, so a contract's stats are thrown away by rewinding the arena in one go instead of
+// destroying every node. The blocks are kept, so after the first few contracts a mission usually runs without touching
+// the heap at all.
+class ContractArena
+{
+public:
+	// Makes an arena the one ContractAllocator allocates from on this thread, until the scope ends.
+	class Scope
+	{
+	public:
+		explicit Scope(ContractArena& arena) : previous(current) {
+			current = &arena;
+		}
+
+		~Scope() {
+			current = this->previous;
+		}
+
+		Scope(const Scope&) = delete;
+		auto operator=(const Scope&) -> Scope& = delete;
+
+	private:
+		ContractArena* previous;
+	};
+
+	ContractArena() = default;
+	ContractArena(const ContractArena&) = delete;
+	auto operator=(const ContractArena&) -> ContractArena& = delete;
+
+	~ContractArena() {
+		this->release();
+	}
+
+	// The arena for this thread, or a fallback one for the thread if there's no scope. The fallback only ever holds
+	// what containers allocate while being default constructed outside one (some standard libraries allocate a
+	// sentinel node up front), such as a tracker's stats before its constructor runs. It's never released or destroyed,
+	// not even when its thread exits, as those containers may outlive the thread.
+	static auto get() -> ContractArena& {
+		if (current) return *current;
+		static thread_local auto* const unscoped = new ContractArena();
+		return *unscoped;
+	}
+
+	auto allocate(size_t bytes, size_t alignment, MemorySubsystem subsystem) -> void* {
+		auto offset = (this->offset + alignment - 1) & ~(alignment - 1);
+
+		while (this->block >= this->blocks.size() || offset + bytes > this->blocks[this->block].size) {
+			if (this->block < this->blocks.size()) ++this->block;
+			if (this->block == this->blocks.size()) this->addBlock(bytes + alignment);
+			offset = 0;
+		}
+
+		auto const ptr = this->blocks[this->block].data.get() + offset;
+		this->offset = offset + bytes;
+		this->used[static_cast<size_t>(subsystem)] += bytes;
+		++this->allocations;
+		Memory::getCounters(subsystem).allocated(bytes);
+		return ptr;
+	}
+
+	// Rewinds to the start of the first block. Anything allocated since the last release must no longer be used.
+	auto release() -> void {
+		for (size_t i = 0; i < this->used.size(); ++i) {
+			if (this->used[i]) Memory::getCounters(static_cast<MemorySubsystem>(i)).released(this->used[i]);
+		}
+
+		this->used.fill(0);
+		this->allocations = 0;
+		this->block = 0;
+		this->offset = 0;
+	}
+
+	// Allocations since the last release.
+	auto getAllocations() const -> uint64_t {
+		return this->allocations;
+	}
+
+	// Bytes handed out since the last release, not counting alignment padding or what was skipped at the end of a block.
+	auto getBytesUsed() const -> size_t {
+		size_t total = 0;
+		for (auto bytes : this->used) total += bytes;
+		return total;
+	}
+
+	auto getBytesReserved() const -> size_t {
+		size_t total = 0;
+		for (auto const& block : this->blocks) total += block.size;
+		return total;
+	}
+
+	auto getBlockCount() const -> size_t {
+		return this->blocks.size();
+	}
+
+private:
+	struct Block
+	{
+		std::unique_ptr<std::byte[]> data;
+		size_t size = 0;
+	};
+
+	// Each block doubles the size of the last, so a long contract needs few of them.
+	auto addBlock(size_t minSize) -> void {
+		auto size = this->blocks.empty() ? InitialBlockSize : this->blocks.back().size * 2;
+		size = std::max(size, minSize);
+		this->blocks.push_back(Block{std::make_unique_for_overwrite<std::byte[]>(size), size});
+	}
+
+private:
+	static constexpr size_t InitialBlockSize = 64 * 1024;
+	static inline thread_local ContractArena* current = nullptr;
+
+	std::vector<Block> blocks;
+	size_t block = 0;
+	size_t offset = 0;
+	uint64_t allocations = 0;
+	std::array<size_t, static_cast<size_t>(MemorySubsystem::Count)> used{};
+};
+
+// Allocates from the current thread's ContractArena (see ContractArena::Scope), counting into the subsystem as
+// CountingAllocator does. Deallocation is a no-op: the memory comes back when the arena is released, so a container
+// using this must not outlive the contract, and anything it erases stays allocated until then.
+template<typename T, MemorySubsystem Subsystem>
+struct ContractAllocator
+{
+	using value_type = T;
+
+	template<typename U>
+	struct rebind
+	{
+		using other = ContractAllocator<U, Subsystem>;
+	};
+
+	ContractAllocator() = default;
+
+	template<typename U>
+	ContractAllocator(const ContractAllocator<U, Subsystem>&) noexcept {}
+
+	auto allocate(size_t n) -> T* {
+		return static_cast<T*>(ContractArena::get().allocate(n * sizeof(T), alignof(T), Subsystem));
+	}
+
+	auto deallocate(T*, size_t) noexcept -> void {}
+
+	template<typename U>
+	friend auto operator==(const ContractAllocator&, const ContractAllocator<U, Subsystem>&) -> bool {
+		return true;
+	}
+};
+
+template<typename T, MemorySubsystem Subsystem = MemorySubsystem::Stats>
+using ContractVector = std::vector<T, ContractAllocator<T, Subsystem>>;
+
+template<typename T, MemorySubsystem Subsystem = MemorySubsystem::Stats>
+using ContractSet = std::set<T, std::less<T>, ContractAllocator<T, Subsystem>>;
+
+template<typename K, typename V, MemorySubsystem Subsystem = MemorySubsystem::Stats>
+using ContractMap = std::map<K, V, std::less<K>, ContractAllocator<std::pair<const K, V>, Subsystem>>;
+
+template<typename K, typename V, MemorySubsystem Subsystem = MemorySubsystem::Stats>
+using ContractUnorderedMap = std::unordered_map<K, V, std::hash<K>, std::equal_to<K>, ContractAllocator<std::pair<const K, V>, Subsystem>>;
+
+template<MemorySubsystem Subsystem>
+using ContractString = std::basic_string<char, std::char_traits<char>, ContractAllocator<char, Subsystem>>;
@@ -0,0 +1,136 @@
+#include <optional>
+#include <utility>
+#include "CumulativeIdList.h"
+#include "Events.h"
+
+static auto isSpace(char c) -> bool {
+	return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+// Finds where the array of the top-level "Value" starts, at its '['.
+static auto findArray(std::string_view data) -> std::optional<size_t> {
+	constexpr auto key = std::string_view("\"Value\"");
+	auto i = data.find(key);
+	if (i == data.npos) return std::nullopt;
+
+	for (i += key.size(); i < data.size() && isSpace(data[i]); ++i);
+	if (i == data.size() || data[i] != ':') return std::nullopt;
+	for (++i; i < data.size() && isSpace(data[i]); ++i);
+	if (i == data.size() || data[i] != '[') return std::nullopt;
+	return i;
+}
+
+// Parses array elements up to and including the closing ']', from just after the '[' or after the last element read
+// (in which case a comma comes first), and returns the length parsed. Only unescaped strings are accepted, as lists of
+// IDs always are; anything else is left to the general decoder.
+static auto parseElements(std::string_view json, bool expectComma, CountedVector<RepoId, MemorySubsystem::EventLists>& ids) -> std::optional<size_t> {
+	size_t i = 0;
+	auto const skipSpace = [&] {
+		while (i < json.size() && isSpace(json[i])) ++i;
+	};
+
+	for (;;) {
+		skipSpace();
+		if (i == json.size()) return std::nullopt;
+		if (json[i] == ']') return i + 1;
+
+		if (expectComma) {
+			if (json[i] != ',') return std::nullopt;
+			++i;
+			skipSpace();
+		}
+
+		if (i == json.size() || json[i] != '"') return std::nullopt;
+		auto const end = json.find('"', i + 1);
+		if (end == json.npos) return std::nullopt;
+
+		auto const value = json.substr(i + 1, end - i - 1);
+		if (value.contains('\\')) return std::nullopt;
+		RepoId::parse(value, ids.emplace_back());
+		i = end + 1;
+		expectComma = true;
+	}
+}
+
+auto CumulativeIdList::reset() -> void {
+	this->array.clear();
+	this->members.clear();
+	this->added.clear();
+	this->removed.clear();
+	this->hasArray = false;
+}
+
+auto CumulativeIdList::decode(std::string_view data, ServerEventHeader& header) -> Result {
+	this->added.clear();
+	this->removed.clear();
+
+	if (auto const begin = findArray(data)) {
+		// The previous text is a whole array, so if the event continues with it that's where its array ends too.
+		auto const rest = data.substr(*begin);
+		if (this->hasArray && rest.starts_with(this->array)) return Result::Unchanged;
+
+		auto length = std::optional<size_t>();
+		auto const previous = std::string_view(this->array);
+		auto const head = previous.substr(0, previous.size() - 1);
+
+		if (this->hasArray && !this->members.empty() && rest.starts_with(head)) {
+			if (auto const tail = this->append(rest.substr(head.size())))
+				length = head.size() + *tail;
+		}
+
+		if (!length) {
+			this->added.clear();
+			this->parsed.clear();
+			if (auto const elements = parseElements(rest.substr(1), false, this->parsed)) {
+				length = 1 + *elements;
+				this->update(this->parsed);
+			}
+		}
+
+		if (length) {
+			this->array.assign(rest.substr(0, *length));
+			this->hasArray = true;
+			this->headerData.assign(data.substr(0, *begin));
+			this->headerData += "null";
+			this->headerData += rest.substr(*length);
+			EventDecoder::decode(this->headerData, header);
+			return Result::Changed;
+		}
+	}
+
+	RepoIdArrayEventValue value;
+	EventDecoder::decode(data, header, getEventFieldObject(value), getEventFieldTable<RepoIdArrayEventValue>());
+	this->update(value.value);
+	return Result::Changed;
+}
+
+auto CumulativeIdList::update(std::span<const RepoId> ids) -> void {
+	this->added.clear();
+	this->removed.clear();
+	this->incoming.clear();
+
+	for (auto const& id : ids) {
+		if (this->incoming.insert(id).second && !this->members.contains(id))
+			this->added.push_back(id);
+	}
+	for (auto const& id : this->members) {
+		if (!this->incoming.contains(id))
+			this->removed.push_back(id);
+	}
+
+	this->members.swap(this->incoming);
+	this->hasArray = false;
+}
+
+// The new elements following the previous list, starting from where its closing bracket was. Returns the length parsed.
+auto CumulativeIdList::append(std::string_view tail) -> std::optional<size_t> {
+	this->parsed.clear();
+	auto const length = parseElements(tail, true, this->parsed);
+	if (!length) return std::nullopt;
+
+	for (auto const& id : this->parsed) {
+		if (this->members.insert(id).second)
+			this->added.push_back(id);
+	}
+	return length;
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include "EventDecoder.h"
+#include "Memory.h"
+#include "RepoId.h"
+
+// Value of the events which carry a cumulative list of IDs (Spotted, Witnesses). The game resends the whole list each
+// time, but handlers are only given what changed since the previous event of that type in the contract.
+struct RepoIdListChange
+{
+	// IDs which weren't in the previous list, in the order they appear.
+	std::span<const RepoId> added;
+	// IDs which have dropped out of it, in no particular order.
+	std::span<const RepoId> removed;
+};
+
+// The last list one event type carried, turned into a RepoIdListChange for each new event.
+// The JSON array is compared with the previous one as text first, so a repeated list isn't decoded at all, and one that
+// only appends to the previous list (as they normally grow) has just the new tail parsed. Either way the event header
+// is decoded with the array cut out, so the cost of an event follows what changed rather than the length of the list.
+class CumulativeIdList
+{
+public:
+	enum class Result
+	{
+		Unchanged,
+		Changed,
+	};
+
+	auto reset() -> void;
+
+	// Decodes the header and the change to the list. Throws nlohmann::json::exception.
+	auto decode(std::string_view data, ServerEventHeader& header) -> Result;
+
+	// Replaces the list with one decoded elsewhere, such as from a DOM.
+	auto update(std::span<const RepoId> ids) -> void;
+
+	auto getChange() const -> RepoIdListChange {
+		return {this->added, this->removed};
+	}
+
+private:
+	auto append(std::string_view tail) -> std::optional<size_t>;
+
+private:
+	CountedString<MemorySubsystem::EventLists> array;
+	CountedString<MemorySubsystem::EventLists> headerData;
+	CountedUnorderedSet<RepoId, MemorySubsystem::EventLists> members;
+	CountedUnorderedSet<RepoId, MemorySubsystem::EventLists> incoming;
+	CountedVector<RepoId, MemorySubsystem::EventLists> parsed;
+	CountedVector<RepoId, MemorySubsystem::EventLists> added;
+	CountedVector<RepoId, MemorySubsystem::EventLists> removed;
+	// Whether array holds the text of the current list, which it doesn't after a DOM update or a fallback decode.
+	bool hasArray = false;
+};
@@ -1,7 +1,12 @@
 #pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <utility>
 #include <Glacier/Enums.h>
 
 enum class MissionType {
@@ -78,6 +83,25 @@ enum class Events {
 	Witnesses,
 };
 
+// Number of Events enumerators. Must follow the last one.
+inline constexpr auto EventCount = static_cast<size_t>(Events::Witnesses) + 1;
+
+enum class ItemInfoType {
+	None,
+	Key,
+	Intel,
+	Detonator,
+	Coin,
+	Firearm,
+	AmmoBox,
+	Explosive,
+	Melee,
+	LethalMelee,
+	Poison,
+	Briefcase,
+	Other,
+};
+
 enum class SecuritySystemRecorderEvent {
 	Undefined,
 	Spotted,
@@ -86,7 +110,7 @@ enum class SecuritySystemRecorderEvent {
 	CameraDestroyed,
 };
 
-inline auto getSecuritySystemRecorderEventFromString(const std::string& str) {
+inline auto getSecuritySystemRecorderEventFromString(std::string_view str) {
 	if (str == "spotted") return SecuritySystemRecorderEvent::Spotted;
 	if (str == "erased") return SecuritySystemRecorderEvent::Erased;
 	if (str == "destroyed") return SecuritySystemRecorderEvent::Destroyed;
@@ -94,6 +118,104 @@ inline auto getSecuritySystemRecorderEventFromString(const std::string& str) {
 	return SecuritySystemRecorderEvent::Undefined;
 }
 
+// The KillClass, KillMethodBroad and KillMethodStrict of kill and pacify events, interned when they're decoded. Only
+// the values the stats tell apart are listed; anything else the game sends is Other.
+enum class KillClass : uint8_t {
+	Other,
+	Melee,
+};
+
+enum class KillMethodBroad : uint8_t {
+	Other,
+	Throw,
+	Unarmed,
+	Pistol,
+	SMG,
+	Shotgun,
+	CloseCombatPistolElimination,
+};
+
+enum class KillMethodStrict : uint8_t {
+	None,
+	Other,
+	AccidentDrown,
+	AccidentPush,
+	AccidentBurn,
+	AccidentExplosion,
+	AccidentSuspendedObject,
+};
+
+// Looks str up in a constexpr table of names, for interning strings the game sends. The tables are a handful of
+// entries, so a linear search beats hashing.
+template<typename T, size_t N>
+constexpr auto findNamedValue(const std::array<std::pair<std::string_view, T>, N>& names, std::string_view str, T otherwise) -> T {
+	for (auto const& [name, value] : names) {
+		if (name == str) return value;
+	}
+	return otherwise;
+}
+
+inline constexpr auto killClassNames = std::array{
+	std::pair{std::string_view("melee"), KillClass::Melee},
+};
+
+inline constexpr auto killMethodBroadNames = std::array{
+	std::pair{std::string_view("throw"), KillMethodBroad::Throw},
+	std::pair{std::string_view("unarmed"), KillMethodBroad::Unarmed},
+	std::pair{std::string_view("pistol"), KillMethodBroad::Pistol},
+	std::pair{std::string_view("smg"), KillMethodBroad::SMG},
+	std::pair{std::string_view("shotgun"), KillMethodBroad::Shotgun},
+	std::pair{std::string_view("close_combat_pistol_elimination"), KillMethodBroad::CloseCombatPistolElimination},
+};
+
+inline constexpr auto killMethodStrictNames = std::array{
+	std::pair{std::string_view(""), KillMethodStrict::None},
+	std::pair{std::string_view("accident_drown"), KillMethodStrict::AccidentDrown},
+	std::pair{std::string_view("accident_push"), KillMethodStrict::AccidentPush},
+	std::pair{std::string_view("accident_burn"), KillMethodStrict::AccidentBurn},
+	std::pair{std::string_view("accident_explosion"), KillMethodStrict::AccidentExplosion},
+	std::pair{std::string_view("accident_suspended_object"), KillMethodStrict::AccidentSuspendedObject},
+};
+
+constexpr auto getKillClassFromString(std::string_view str) -> KillClass {
+	return findNamedValue(killClassNames, str, KillClass::Other);
+}
+
+constexpr auto getKillMethodBroadFromString(std::string_view str) -> KillMethodBroad {
+	return findNamedValue(killMethodBroadNames, str, KillMethodBroad::Other);
+}
+
+constexpr auto getKillMethodStrictFromString(std::string_view str) -> KillMethodStrict {
+	return findNamedValue(killMethodStrictNames, str, KillMethodStrict::Other);
+}
+
+static_assert(getKillMethodBroadFromString("close_combat_pistol_elimination") == KillMethodBroad::CloseCombatPistolElimination);
+static_assert(getKillMethodStrictFromString("") == KillMethodStrict::None);
+static_assert(getKillMethodStrictFromString("accident_ice") == KillMethodStrict::Other);
+
+// Classifies a repo.json item by its ItemType and InventoryCategoryIcon. Run by stealthometer-repogen, which stores
+// the result in the repo index.
+inline auto getItemInfoTypeFromRepo(std::string_view itemType, std::string_view inventoryCategoryIcon) -> ItemInfoType {
+	if (itemType == "eOther_Keycard_A") return ItemInfoType::Key;
+	if (itemType == "eDetonator" && inventoryCategoryIcon == "remote") return ItemInfoType::Detonator;
+	if (itemType == "eCC_Brick") return ItemInfoType::Other;
+	if (itemType == "eDetonator" && inventoryCategoryIcon == "distraction") return ItemInfoType::Coin;
+	if (itemType == "eItemAmmo") return ItemInfoType::AmmoBox;
+	if (inventoryCategoryIcon == "QuestItem" || inventoryCategoryIcon == "questitem") return ItemInfoType::Intel;
+	if (inventoryCategoryIcon == "poison") return ItemInfoType::Poison;
+	if (inventoryCategoryIcon == "melee") return itemType == "eCC_Knife" ? ItemInfoType::LethalMelee : ItemInfoType::Melee;
+	if (inventoryCategoryIcon == "explosives") return ItemInfoType::Explosive;
+	if (
+		inventoryCategoryIcon == "pistol"
+		|| inventoryCategoryIcon == "smg"
+		|| inventoryCategoryIcon == "shotgun"
+		|| inventoryCategoryIcon == "assaultrifle"
+		|| inventoryCategoryIcon == "sniperrifle"
+	)
+		return ItemInfoType::Firearm;
+	return ItemInfoType::Other;
+}
+
 inline auto getMissionTypeFromString(const std::string& str) -> std::optional<MissionType> {
 	static const std::unordered_map<std::string, MissionType> map = {{
 		{"arcade", MissionType::Arcade},
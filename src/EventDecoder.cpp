@@ -0,0 +1,179 @@
+#include "EventDecoder.h"
+
+EventDecoder::EventDecoder(ServerEventHeader& header, void* value, EventFieldTable valueTable, bool peek) :
+	value(value), valueTable(valueTable), peeking(peek)
+{
+	this->frames[0] = Frame{&header, getEventFieldTable<ServerEventHeader>()};
+}
+
+auto EventDecoder::decode(std::string_view data, ServerEventHeader& header, void* value, EventFieldTable valueTable) -> void {
+	auto decoder = EventDecoder(header, value, valueTable, false);
+	nlohmann::json::sax_parse(data.data(), data.data() + data.size(), &decoder);
+}
+
+auto EventDecoder::peek(std::string_view data) -> ServerEventHeader {
+	ServerEventHeader header;
+	auto decoder = EventDecoder(header, nullptr, {}, true);
+	nlohmann::json::sax_parse(data.data(), data.data() + data.size(), &decoder);
+	return header;
+}
+
+auto EventDecoder::push(Frame frame) -> bool {
+	if (this->depth == MaxDepth) ++this->skipDepth;
+	else this->frames[this->depth++] = frame;
+	return true;
+}
+
+auto EventDecoder::enterValue(bool isArray) -> bool {
+	this->readingValue = false;
+	if (!isArray) return this->push(Frame{this->value, this->valueTable});
+
+	auto const self = this->valueTable.find("");
+	if (self && self->beginArray) {
+		self->beginArray(this->value);
+		return this->push(Frame{this->value, this->valueTable, self, true});
+	}
+
+	++this->skipDepth;
+	return true;
+}
+
+template<typename TFunc>
+auto EventDecoder::scalar(TFunc&& apply) -> bool {
+	if (this->skipDepth || !this->depth) return true;
+
+	if (this->readingValue) {
+		this->readingValue = false;
+		if (auto const self = this->valueTable.find(""))
+			apply(*self, this->value);
+		return true;
+	}
+
+	auto& frame = this->current();
+	if (frame.field) apply(*frame.field, frame.obj);
+	if (!frame.isArray) frame.field = nullptr;
+	return true;
+}
+
+auto EventDecoder::null() -> bool {
+	return this->scalar([](const EventField&, void*) {});
+}
+
+auto EventDecoder::boolean(bool val) -> bool {
+	return this->scalar([val](const EventField& field, void* obj) {
+		if (field.setBool) field.setBool(obj, val);
+	});
+}
+
+auto EventDecoder::number_integer(nlohmann::json::number_integer_t val) -> bool {
+	return this->number_float(static_cast<double>(val), {});
+}
+
+auto EventDecoder::number_unsigned(nlohmann::json::number_unsigned_t val) -> bool {
+	return this->number_float(static_cast<double>(val), {});
+}
+
+auto EventDecoder::number_float(nlohmann::json::number_float_t val, const std::string&) -> bool {
+	return this->scalar([val](const EventField& field, void* obj) {
+		if (field.setNumber) field.setNumber(obj, val);
+	});
+}
+
+auto EventDecoder::string(std::string& val) -> bool {
+	// When peeking, stop as soon as the top-level name has been read.
+	auto const isName = this->peeking && this->depth == 1 && !this->skipDepth && !this->readingValue
+		&& this->current().field && this->current().field->name == "Name";
+
+	this->scalar([&val](const EventField& field, void* obj) {
+		if (field.setString) field.setString(obj, val);
+	});
+	return !isName;
+}
+
+auto EventDecoder::binary(nlohmann::json::binary_t&) -> bool {
+	return this->scalar([](const EventField&, void*) {});
+}
+
+auto EventDecoder::start_object(std::size_t) -> bool {
+	if (this->skipDepth) {
+		++this->skipDepth;
+		return true;
+	}
+
+	// The root frame is set up on construction.
+	if (!this->depth) {
+		this->depth = 1;
+		return true;
+	}
+
+	if (this->readingValue) return this->enterValue(false);
+
+	auto& frame = this->current();
+	auto const field = frame.field;
+	if (!frame.isArray) frame.field = nullptr;
+
+	if (field && field->enterObject) {
+		auto const nested = field->enterObject(frame.obj);
+		return this->push(Frame{nested.obj, nested.table});
+	}
+
+	++this->skipDepth;
+	return true;
+}
+
+auto EventDecoder::key(std::string& val) -> bool {
+	if (this->skipDepth) return true;
+
+	auto& frame = this->current();
+
+	if (this->depth == 1 && this->value && val == "Value") {
+		this->readingValue = true;
+		frame.field = nullptr;
+		return true;
+	}
+
+	frame.field = frame.table.find(val);
+	if (frame.field && frame.field->setPresent)
+		frame.field->setPresent(frame.obj);
+	return true;
+}
+
+auto EventDecoder::end_object() -> bool {
+	if (this->skipDepth) --this->skipDepth;
+	else if (this->depth) --this->depth;
+	return true;
+}
+
+auto EventDecoder::start_array(std::size_t) -> bool {
+	if (this->skipDepth || !this->depth) {
+		++this->skipDepth;
+		return true;
+	}
+
+	if (this->readingValue) return this->enterValue(true);
+
+	auto& frame = this->current();
+	if (frame.isArray) {
+		++this->skipDepth;
+		return true;
+	}
+
+	auto const field = frame.field;
+	frame.field = nullptr;
+
+	if (field && field->beginArray) {
+		field->beginArray(frame.obj);
+		return this->push(Frame{frame.obj, frame.table, field, true});
+	}
+
+	++this->skipDepth;
+	return true;
+}
+
+auto EventDecoder::end_array() -> bool {
+	return this->end_object();
+}
+
+auto EventDecoder::parse_error(std::size_t, const std::string&, const nlohmann::json::exception& ex) -> bool {
+	throw ex;
+}
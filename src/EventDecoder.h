@@ -0,0 +1,82 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "json.hpp"
+#include "EventFields.h"
+
+struct ServerEventHeader
+{
+	std::string ContractSessionId;
+	std::string ContractId;
+	std::string Name;
+	double Timestamp = 0;
+};
+
+template<>
+struct EventValueFields<ServerEventHeader> : EventFieldBuilder<ServerEventHeader> {
+	static constexpr auto Fields = std::array{
+		field<&Type::ContractSessionId>("ContractSessionId"),
+		field<&Type::ContractId>("ContractId"),
+		field<&Type::Name>("Name"),
+		field<&Type::Timestamp>("Timestamp"),
+	};
+};
+
+// Streaming decoder that fills an event header and typed value straight from the event JSON via nlohmann's SAX
+// interface, guided by the compile-time field tables. No DOM is built and unknown keys are skipped in place.
+class EventDecoder
+{
+public:
+	// Decodes the header and, if value is given, the "Value" member into it. Throws nlohmann::json::exception.
+	static auto decode(std::string_view data, ServerEventHeader& header, void* value = nullptr, EventFieldTable valueTable = {}) -> void;
+
+	// Reads only as far as the event name (and the timestamp, if it comes first).
+	static auto peek(std::string_view data) -> ServerEventHeader;
+
+public:
+	auto null() -> bool;
+	auto boolean(bool val) -> bool;
+	auto number_integer(nlohmann::json::number_integer_t val) -> bool;
+	auto number_unsigned(nlohmann::json::number_unsigned_t val) -> bool;
+	auto number_float(nlohmann::json::number_float_t val, const std::string& str) -> bool;
+	auto string(std::string& val) -> bool;
+	auto binary(nlohmann::json::binary_t& val) -> bool;
+	auto start_object(std::size_t elements) -> bool;
+	auto key(std::string& val) -> bool;
+	auto end_object() -> bool;
+	auto start_array(std::size_t elements) -> bool;
+	auto end_array() -> bool;
+	auto parse_error(std::size_t position, const std::string& lastToken, const nlohmann::json::exception& ex) -> bool;
+
+private:
+	struct Frame
+	{
+		void* obj = nullptr;
+		EventFieldTable table;
+		// Field of the key being read, or the element field while inside an array.
+		const EventField* field = nullptr;
+		bool isArray = false;
+	};
+
+	EventDecoder(ServerEventHeader& header, void* value, EventFieldTable valueTable, bool peek);
+
+	auto current() -> Frame& { return this->frames[this->depth - 1]; }
+	auto push(Frame frame) -> bool;
+	auto enterValue(bool isArray) -> bool;
+
+	template<typename TFunc>
+	auto scalar(TFunc&& apply) -> bool;
+
+private:
+	static constexpr size_t MaxDepth = 16;
+
+	std::array<Frame, MaxDepth> frames;
+	size_t depth = 0;
+	size_t skipDepth = 0;
+	void* value = nullptr;
+	EventFieldTable valueTable;
+	bool readingValue = false;
+	bool peeking = false;
+};
@@ -0,0 +1,156 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "RepoId.h"
+
+struct EventField;
+
+// View over the compile-time field table of an event value struct.
+struct EventFieldTable
+{
+	const EventField* fields = nullptr;
+	size_t size = 0;
+
+	constexpr auto find(std::string_view name) const -> const EventField*;
+};
+
+// Describes how a JSON value maps onto a member of an event value struct.
+// Setters are type-erased so the streaming decoder can fill any event value without building a DOM first.
+struct EventField
+{
+	struct Nested
+	{
+		void* obj = nullptr;
+		EventFieldTable table;
+	};
+
+	std::string_view name;
+	auto (*setBool)(void* obj, bool value) -> void = nullptr;
+	auto (*setNumber)(void* obj, double value) -> void = nullptr;
+	auto (*setString)(void* obj, std::string_view value) -> void = nullptr;
+	auto (*beginArray)(void* obj) -> void = nullptr;
+	auto (*enterObject)(void* obj) -> Nested = nullptr;
+	auto (*setPresent)(void* obj) -> void = nullptr;
+};
+
+constexpr auto EventFieldTable::find(std::string_view name) const -> const EventField* {
+	for (size_t i = 0; i < this->size; ++i) {
+		if (this->fields[i].name == name)
+			return &this->fields[i];
+	}
+	return nullptr;
+}
+
+// Specialized with a constexpr `Fields` array next to each event value struct.
+// A field named "" describes the value itself, for events whose Value is a plain string or array.
+template<typename T>
+struct EventValueFields;
+
+template<typename T>
+concept HasEventFields = requires { EventValueFields<T>::Fields; };
+
+template<typename T>
+constexpr auto getEventFieldTable() -> EventFieldTable {
+	return {EventValueFields<T>::Fields.data(), EventValueFields<T>::Fields.size()};
+}
+
+// Pointer to hand to the setters of T's field table. T may reuse the table of one of its bases.
+template<typename T>
+auto getEventFieldObject(T& value) -> void* {
+	return static_cast<typename EventValueFields<T>::Type*>(&value);
+}
+
+template<typename T>
+struct EventFieldBuilder
+{
+	using Type = T;
+
+private:
+	template<typename>
+	struct MemberType;
+
+	template<typename C, typename M>
+	struct MemberType<M C::*>
+	{
+		using Type = M;
+	};
+
+	template<typename>
+	struct VectorElement
+	{
+		using Type = void;
+	};
+
+	template<typename E>
+	struct VectorElement<std::vector<E>>
+	{
+		using Type = E;
+	};
+
+	template<auto Member>
+	static auto get(void* obj) -> auto& {
+		return static_cast<T*>(obj)->*Member;
+	}
+
+public:
+	// Maps a JSON value onto a member, picking the setter from the member type.
+	// Convert optionally transforms the value first: f(int) for enums sent as numbers, f(std::string_view) for values
+	// sent as strings, or f(Member&, double) to write part of a member (e.g. one component of a vector).
+	template<auto Member, auto Convert = nullptr>
+	static constexpr auto field(std::string_view name) -> EventField {
+		using M = typename MemberType<decltype(Member)>::Type;
+		using E = typename VectorElement<M>::Type;
+		using C = decltype(Convert);
+
+		EventField field{name};
+
+		if constexpr (!std::is_same_v<C, std::nullptr_t>) {
+			if constexpr (std::is_invocable_v<C, M&, double>)
+				field.setNumber = [](void* obj, double value) { Convert(get<Member>(obj), value); };
+			else if constexpr (std::is_invocable_v<C, std::string_view>)
+				field.setString = [](void* obj, std::string_view value) { get<Member>(obj) = Convert(value); };
+			else {
+				static_assert(std::is_invocable_v<C, int>, "unsupported event field converter");
+				field.setNumber = [](void* obj, double value) { get<Member>(obj) = Convert(static_cast<int>(value)); };
+			}
+		}
+		else if constexpr (std::is_same_v<M, bool>)
+			field.setBool = [](void* obj, bool value) { get<Member>(obj) = value; };
+		else if constexpr (std::is_arithmetic_v<M>)
+			field.setNumber = [](void* obj, double value) { get<Member>(obj) = static_cast<M>(value); };
+		else if constexpr (std::is_same_v<M, std::string>)
+			field.setString = [](void* obj, std::string_view value) { get<Member>(obj).assign(value); };
+		else if constexpr (std::is_same_v<M, RepoId>)
+			field.setString = [](void* obj, std::string_view value) { RepoId::parse(value, get<Member>(obj)); };
+		else if constexpr (std::is_same_v<E, std::string> || std::is_same_v<E, RepoId>) {
+			field.beginArray = [](void* obj) { get<Member>(obj).clear(); };
+			field.setString = [](void* obj, std::string_view value) { get<Member>(obj).emplace_back(value); };
+		}
+		else if constexpr (HasEventFields<E>) {
+			field.beginArray = [](void* obj) { get<Member>(obj).clear(); };
+			field.enterObject = [](void* obj) {
+				return EventField::Nested{getEventFieldObject(get<Member>(obj).emplace_back()), getEventFieldTable<E>()};
+			};
+		}
+		else {
+			static_assert(HasEventFields<M>, "unsupported event field type");
+			field.enterObject = [](void* obj) {
+				return EventField::Nested{getEventFieldObject(get<Member>(obj)), getEventFieldTable<M>()};
+			};
+		}
+		return field;
+	}
+
+	// Sets a bool member to true when the key is present, whatever its value.
+	template<auto Member>
+	static constexpr auto presence(std::string_view name) -> EventField {
+		EventField field{name};
+		field.setPresent = [](void* obj) { get<Member>(obj) = true; };
+		return field;
+	}
+};
@@ -0,0 +1,103 @@
+#include <algorithm>
+#include <cstring>
+#include "EventHistory.h"
+#include "EventNames.h"
+#include "Log.h"
+
+EventHistory::EventHistory() : records(RecordCapacity), payloads(PayloadCapacity)
+{ }
+
+auto EventHistory::add(Events event, double timestamp, std::string_view data, bool handled) -> bool {
+	auto const ordinal = static_cast<size_t>(event);
+	this->record(static_cast<uint16_t>(ordinal), timestamp, data, handled);
+	if (handled) {
+		++this->handledCounts[ordinal];
+		return false;
+	}
+	return !this->unhandledCounts[ordinal]++;
+}
+
+auto EventHistory::addUnknown(std::string_view name, double timestamp, std::string_view data) -> bool {
+	name = name.substr(0, MaxUnknownName);
+	auto const slot = this->findUnknown(name);
+	this->record(static_cast<uint16_t>(EventCount + slot.value_or(UnknownNameSlots)), timestamp, data, false);
+
+	if (!slot) {
+		++this->otherUnknownCount;
+		return false;
+	}
+	return !this->unknownCounts[*slot]++;
+}
+
+auto EventHistory::getPayload(const EventRecord& record) const -> std::optional<std::string_view> {
+	if (record.payload + PayloadCapacity < this->payloadEnd) return std::nullopt;
+	return std::string_view(this->payloads.data() + record.payload % PayloadCapacity, record.payloadSize);
+}
+
+auto EventHistory::getName(const EventRecord& record) const -> std::string_view {
+	if (record.name < EventCount) return getEventName(static_cast<Events>(record.name));
+	auto const slot = record.name - EventCount;
+	return slot < this->unknownNameCount ? this->getUnknownName(slot) : std::string_view("(other)");
+}
+
+auto EventHistory::log(size_t recent) const -> void {
+	Logger::Info("Event history: {} events recorded, last {} held", this->total, this->count);
+
+	for (size_t i = 0; i < EventCount; ++i) {
+		if (!this->handledCounts[i] && !this->unhandledCounts[i]) continue;
+		Logger::Info("Event history: {}: {} handled, {} unhandled", getEventName(static_cast<Events>(i)), this->handledCounts[i], this->unhandledCounts[i]);
+	}
+
+	this->forEachUnknown([](std::string_view name, uint64_t count) {
+		Logger::Info("Event history: unknown {}: {}", name, count);
+	});
+
+	for (auto i = this->count - std::min(recent, this->count); i < this->count; ++i) {
+		auto const& record = this->getRecord(i);
+		auto const payload = this->getPayload(record);
+		Logger::Info(
+			"Event history: {:.3f} {}{}: {}{}",
+			record.timestamp,
+			this->getName(record),
+			record.handled ? "" : " (unhandled)",
+			payload.value_or("(overwritten)"),
+			record.truncated ? "..." : ""
+		);
+	}
+}
+
+auto EventHistory::record(uint16_t name, double timestamp, std::string_view data, bool handled) -> void {
+	auto const size = std::min(data.size(), MaxPayload);
+
+	// Payloads are kept contiguous, skipping what's left at the end of the ring if one doesn't fit there.
+	auto const offset = this->payloadEnd % PayloadCapacity;
+	if (offset + size > PayloadCapacity) this->payloadEnd += PayloadCapacity - offset;
+
+	auto const payload = this->payloadEnd;
+	if (size) std::memcpy(this->payloads.data() + payload % PayloadCapacity, data.data(), size);
+	this->payloadEnd += size;
+
+	this->records[this->next] = EventRecord{
+		.timestamp = timestamp,
+		.payload = payload,
+		.payloadSize = static_cast<uint32_t>(size),
+		.name = name,
+		.handled = handled,
+		.truncated = size < data.size(),
+	};
+	this->next = (this->next + 1) % RecordCapacity;
+	this->count = std::min(this->count + 1, RecordCapacity);
+	++this->total;
+}
+
+auto EventHistory::findUnknown(std::string_view name) -> std::optional<size_t> {
+	for (size_t i = 0; i < this->unknownNameCount; ++i) {
+		if (this->getUnknownName(i) == name) return i;
+	}
+	if (this->unknownNameCount == UnknownNameSlots) return std::nullopt;
+
+	auto const slot = this->unknownNameCount++;
+	std::copy(name.begin(), name.end(), this->unknownNames[slot].begin());
+	this->unknownNameLengths[slot] = static_cast<uint8_t>(name.size());
+	return slot;
+}
@@ -0,0 +1,104 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include "Enums.h"
+#include "Memory.h"
+
+// One event the tracker was sent, as kept in the EventHistory.
+struct EventRecord
+{
+	double timestamp = 0;
+	// Absolute position of the event's text in the payload ring (see EventHistory::getPayload).
+	uint64_t payload = 0;
+	uint32_t payloadSize = 0;
+	// An Events ordinal, or EventCount plus the slot of a name the mod doesn't know.
+	uint16_t name = 0;
+	bool handled = false;
+	bool truncated = false;
+};
+
+// What the tracker has been sent over the session: the most recent events in a fixed ring of records, their text in a
+// fixed ring of bytes, and counts of every event by name, with those nothing handled counted separately. All of it is
+// allocated up front, so recording an event never allocates however long the game runs. Old records and payloads are
+// overwritten as the rings wrap, and names the mod doesn't know beyond the slots for them are only counted as "other".
+class EventHistory
+{
+public:
+	static constexpr size_t RecordCapacity = 4096;
+	static constexpr size_t PayloadCapacity = 512 * 1024;
+	// Events are cut short past this, so a single huge one can't flush the payload ring.
+	static constexpr size_t MaxPayload = 16 * 1024;
+	static constexpr size_t UnknownNameSlots = 64;
+	static constexpr size_t MaxUnknownName = 63;
+
+	EventHistory();
+
+	// Records an event known by name. Returns true if it's the first of its kind to go unhandled, so worth logging.
+	auto add(Events event, double timestamp, std::string_view data, bool handled) -> bool;
+	// Records an event whose name isn't known. Returns true if it's the first with that name.
+	auto addUnknown(std::string_view name, double timestamp, std::string_view data) -> bool;
+
+	// Number of records held, up to RecordCapacity.
+	auto size() const -> size_t {
+		return this->count;
+	}
+
+	// The index-th oldest record held.
+	auto getRecord(size_t index) const -> const EventRecord& {
+		return this->records[(this->next + RecordCapacity - this->count + index) % RecordCapacity];
+	}
+
+	// The record's event text, unless it's since been overwritten.
+	auto getPayload(const EventRecord& record) const -> std::optional<std::string_view>;
+	auto getName(const EventRecord& record) const -> std::string_view;
+
+	// Total events recorded, including those no longer held.
+	auto getTotal() const -> uint64_t {
+		return this->total;
+	}
+
+	auto getHandledCount(Events event) const -> uint64_t {
+		return this->handledCounts[static_cast<size_t>(event)];
+	}
+
+	auto getUnhandledCount(Events event) const -> uint64_t {
+		return this->unhandledCounts[static_cast<size_t>(event)];
+	}
+
+	// Calls func(name, count) for each name of unknown events, then "(other)" for those which didn't fit a slot.
+	template<typename TFunc>
+	auto forEachUnknown(TFunc&& func) const -> void {
+		for (size_t i = 0; i < this->unknownNameCount; ++i)
+			func(this->getUnknownName(i), this->unknownCounts[i]);
+		if (this->otherUnknownCount) func(std::string_view("(other)"), this->otherUnknownCount);
+	}
+
+	// Logs the counters, the unhandled histogram and the last few records.
+	auto log(size_t recent = 20) const -> void;
+
+private:
+	auto record(uint16_t name, double timestamp, std::string_view data, bool handled) -> void;
+	auto findUnknown(std::string_view name) -> std::optional<size_t>;
+
+	auto getUnknownName(size_t slot) const -> std::string_view {
+		return {this->unknownNames[slot].data(), this->unknownNameLengths[slot]};
+	}
+
+private:
+	CountedVector<EventRecord, MemorySubsystem::EventHistory> records;
+	CountedVector<char, MemorySubsystem::EventHistory> payloads;
+	size_t next = 0;
+	size_t count = 0;
+	uint64_t payloadEnd = 0;
+	uint64_t total = 0;
+	std::array<uint64_t, EventCount> handledCounts = {};
+	std::array<uint64_t, EventCount> unhandledCounts = {};
+	std::array<std::array<char, MaxUnknownName>, UnknownNameSlots> unknownNames = {};
+	std::array<uint8_t, UnknownNameSlots> unknownNameLengths = {};
+	std::array<uint64_t, UnknownNameSlots> unknownCounts = {};
+	size_t unknownNameCount = 0;
+	uint64_t otherUnknownCount = 0;
+};
@@ -0,0 +1,432 @@
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <utility>
+#include "json.hpp"
+#include "EventJournal.h"
+#include "EventNames.h"
+
+using EventJournal::Token;
+
+namespace
+{
+	auto writeVarint(std::string& out, uint64_t value) -> void {
+		while (value >= 0x80) {
+			out += static_cast<char>((value & 0x7F) | 0x80);
+			value >>= 7;
+		}
+		out += static_cast<char>(value);
+	}
+
+	auto writeZigzag(std::string& out, int64_t value) -> void {
+		writeVarint(out, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+	}
+
+	auto writeToken(std::string& out, Token token) -> void {
+		out += static_cast<char>(token);
+	}
+
+	auto hexValue(char c) -> int {
+		if (c >= '0' && c <= '9') return c - '0';
+		if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+		return -1;
+	}
+
+	// Writes visited values back out as compact JSON text.
+	struct JsonWriter
+	{
+		std::string& out;
+		bool separate = false;
+
+		auto separator() -> void {
+			if (this->separate) this->out += ',';
+			this->separate = true;
+		}
+
+		auto quoted(std::string_view str) -> void {
+			static constexpr char hex[] = "0123456789abcdef";
+
+			this->out += '"';
+			while (!str.empty()) {
+				auto const special = std::find_if(str.begin(), str.end(), [](char c) {
+					return c == '"' || c == '\\' || static_cast<unsigned char>(c) < 0x20;
+				});
+				this->out.append(str.begin(), special);
+				if (special == str.end()) break;
+
+				auto const c = *special;
+				switch (c) {
+					case '"': this->out += "\\\""; break;
+					case '\\': this->out += "\\\\"; break;
+					case '\b': this->out += "\\b"; break;
+					case '\f': this->out += "\\f"; break;
+					case '\n': this->out += "\\n"; break;
+					case '\r': this->out += "\\r"; break;
+					case '\t': this->out += "\\t"; break;
+					default:
+						this->out += "\\u00";
+						this->out += hex[(c >> 4) & 0xF];
+						this->out += hex[c & 0xF];
+						break;
+				}
+				str.remove_prefix(special - str.begin() + 1);
+			}
+			this->out += '"';
+		}
+
+		template<typename T>
+		auto scalar(T value) -> void {
+			char buffer[32];
+			auto const res = std::to_chars(buffer, buffer + sizeof(buffer), value);
+			this->out.append(buffer, res.ptr);
+		}
+
+		auto null() -> void { this->separator(); this->out += "null"; }
+		auto boolean(bool val) -> void { this->separator(); this->out += val ? "true" : "false"; }
+		auto integer(int64_t val) -> void { this->separator(); this->scalar(val); }
+		auto unsignedInteger(uint64_t val) -> void { this->separator(); this->scalar(val); }
+		auto string(std::string_view val) -> void { this->separator(); this->quoted(val); }
+		auto raw(std::string_view val) -> void { this->separator(); this->out += val; }
+
+		auto number(double val) -> void {
+			this->separator();
+			if (!std::isfinite(val)) {
+				this->out += "null";
+				return;
+			}
+
+			// Keep integral floats looking like floats so they decode as the same JSON type.
+			auto const start = this->out.size();
+			this->scalar(val);
+			if (this->out.find_first_of(".e", start) == std::string::npos)
+				this->out += ".0";
+		}
+
+		auto key(std::string_view val) -> void {
+			this->separator();
+			this->quoted(val);
+			this->out += ':';
+			this->separate = false;
+		}
+
+		auto beginObject() -> void { this->separator(); this->out += '{'; this->separate = false; }
+		auto endObject() -> void { this->out += '}'; this->separate = true; }
+		auto beginArray() -> void { this->separator(); this->out += '['; this->separate = false; }
+		auto endArray() -> void { this->out += ']'; this->separate = true; }
+	};
+}
+
+auto EventJournal::parseText(std::string_view text) -> std::vector<EventJournalEntry> {
+	std::vector<EventJournalEntry> entries;
+
+	auto const parseField = [](std::string_view& line, uint64_t& value) {
+		auto const end = line.find('\t');
+		if (end == line.npos) return false;
+		auto const res = std::from_chars(line.data(), line.data() + end, value);
+		if (res.ec != std::errc{} || res.ptr != line.data() + end) return false;
+		line.remove_prefix(end + 1);
+		return true;
+	};
+
+	while (!text.empty()) {
+		auto const end = text.find('\n');
+		auto line = text.substr(0, end);
+		text.remove_prefix(end == text.npos ? text.size() : end + 1);
+
+		if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+
+		EventJournalEntry entry;
+		if (!parseField(line, entry.time) || !parseField(line, entry.frame) || line.empty()) continue;
+		entry.data = line;
+		entries.push_back(entry);
+	}
+
+	return entries;
+}
+
+auto EventJournal::appendText(std::string& out, const EventJournalEntry& entry) -> void {
+	out += std::to_string(entry.time);
+	out += '\t';
+	out += std::to_string(entry.frame);
+	out += '\t';
+	for (auto c : entry.data) {
+		if (c != '\n') out += c;
+	}
+	out += '\n';
+}
+
+// Tokenizes an event as nlohmann parses it. Dictionary entries added for the event are remembered so they can be
+// taken back out if the event turns out to be malformed and is stored raw instead.
+struct EventJournalEncoder::Sax
+{
+	enum class TopKey
+	{
+		Other,
+		Name,
+		Timestamp,
+	};
+
+	EventJournalEncoder& encoder;
+	std::vector<std::pair<std::unordered_map<std::string, uint32_t>*, std::string>> added;
+	std::vector<size_t> namesAdded;
+	int64_t timestamp;
+	int depth = 0;
+	TopKey topKey = TopKey::Other;
+
+	Sax(EventJournalEncoder& encoder) : encoder(encoder), timestamp(encoder.lastTimestamp)
+	{ }
+
+	auto out() -> std::string& {
+		return this->encoder.record;
+	}
+
+	auto isTop(TopKey key) const -> bool {
+		return this->depth == 1 && this->topKey == key;
+	}
+
+	auto rollback() -> void {
+		for (auto& [dictionary, str] : this->added)
+			dictionary->erase(str);
+		for (auto ordinal : this->namesAdded)
+			this->encoder.namesDefined[ordinal] = false;
+	}
+
+	auto null() -> bool {
+		writeToken(this->out(), Token::Null);
+		return true;
+	}
+
+	auto boolean(bool val) -> bool {
+		writeToken(this->out(), val ? Token::True : Token::False);
+		return true;
+	}
+
+	auto number_integer(nlohmann::json::number_integer_t val) -> bool {
+		writeToken(this->out(), Token::Integer);
+		writeZigzag(this->out(), val);
+		return true;
+	}
+
+	auto number_unsigned(nlohmann::json::number_unsigned_t val) -> bool {
+		writeToken(this->out(), Token::Unsigned);
+		writeVarint(this->out(), val);
+		return true;
+	}
+
+	auto number_float(nlohmann::json::number_float_t val, const std::string&) -> bool {
+		// Game timestamps are printed to the microsecond, so they're stored as small deltas whenever that's exact.
+		if (this->isTop(TopKey::Timestamp) && std::abs(val) < 1e12) {
+			auto const micros = std::llround(val * 1e6);
+			if (static_cast<double>(micros) / 1e6 == val) {
+				writeToken(this->out(), Token::Timestamp);
+				writeZigzag(this->out(), micros - this->timestamp);
+				this->timestamp = micros;
+				return true;
+			}
+		}
+
+		char bytes[sizeof(double)];
+		std::memcpy(bytes, &val, sizeof(double));
+		writeToken(this->out(), Token::Float);
+		this->out().append(bytes, sizeof(double));
+		return true;
+	}
+
+	auto string(std::string& val) -> bool {
+		if (this->isTop(TopKey::Name)) {
+			auto const info = lookupEventName(val);
+			if (info.kind == EventNameKind::Event) {
+				auto const ordinal = static_cast<size_t>(info.event);
+				if (this->encoder.namesDefined[ordinal]) {
+					writeToken(this->out(), Token::NameRef);
+					writeVarint(this->out(), ordinal);
+				}
+				else {
+					this->encoder.namesDefined[ordinal] = true;
+					this->namesAdded.push_back(ordinal);
+					writeToken(this->out(), Token::Name);
+					writeVarint(this->out(), ordinal);
+					writeVarint(this->out(), val.size());
+					this->out() += val;
+				}
+				return true;
+			}
+		}
+
+		auto const guidsSize = this->encoder.guids.size();
+		auto const stringsSize = this->encoder.strings.size();
+
+		if (this->encoder.writeGuid(val)) {
+			if (this->encoder.guids.size() != guidsSize) this->added.emplace_back(&this->encoder.guids, val);
+		}
+		else {
+			this->encoder.writeString(Token::String, Token::StringRef, this->encoder.strings, val);
+			if (this->encoder.strings.size() != stringsSize) this->added.emplace_back(&this->encoder.strings, val);
+		}
+		return true;
+	}
+
+	auto binary(nlohmann::json::binary_t&) -> bool {
+		return false;
+	}
+
+	auto key(std::string& val) -> bool {
+		if (this->depth == 1) {
+			if (val == "Name") this->topKey = TopKey::Name;
+			else if (val == "Timestamp") this->topKey = TopKey::Timestamp;
+			else this->topKey = TopKey::Other;
+		}
+
+		auto const keysSize = this->encoder.keys.size();
+		this->encoder.writeString(Token::Key, Token::KeyRef, this->encoder.keys, val);
+		if (this->encoder.keys.size() != keysSize) this->added.emplace_back(&this->encoder.keys, val);
+		return true;
+	}
+
+	auto start_object(std::size_t) -> bool {
+		++this->depth;
+		writeToken(this->out(), Token::BeginObject);
+		return true;
+	}
+
+	auto end_object() -> bool {
+		--this->depth;
+		writeToken(this->out(), Token::EndObject);
+		return true;
+	}
+
+	auto start_array(std::size_t) -> bool {
+		++this->depth;
+		writeToken(this->out(), Token::BeginArray);
+		return true;
+	}
+
+	auto end_array() -> bool {
+		--this->depth;
+		writeToken(this->out(), Token::EndArray);
+		return true;
+	}
+
+	auto parse_error(std::size_t, const std::string&, const nlohmann::json::exception&) -> bool {
+		return false;
+	}
+};
+
+auto EventJournalEncoder::writeString(Token token, Token refToken, std::unordered_map<std::string, uint32_t>& dictionary, std::string_view str) -> void {
+	auto const [it, added] = dictionary.try_emplace(std::string(str), static_cast<uint32_t>(dictionary.size()));
+	if (added) {
+		writeToken(this->record, token);
+		writeVarint(this->record, str.size());
+		this->record += str;
+	}
+	else {
+		writeToken(this->record, refToken);
+		writeVarint(this->record, it->second);
+	}
+}
+
+auto EventJournalEncoder::writeGuid(std::string_view str) -> bool {
+	if (str.size() != 36) return false;
+
+	char bytes[16];
+	auto n = 0;
+	for (size_t i = 0; i < str.size(); ++i) {
+		if (i == 8 || i == 13 || i == 18 || i == 23) {
+			if (str[i] != '-') return false;
+			continue;
+		}
+		auto const high = hexValue(str[i]);
+		auto const low = hexValue(str[++i]);
+		if (high < 0 || low < 0) return false;
+		bytes[n++] = static_cast<char>((high << 4) | low);
+	}
+
+	auto const [it, added] = this->guids.try_emplace(std::string(str), static_cast<uint32_t>(this->guids.size()));
+	if (added) {
+		writeToken(this->record, Token::Guid);
+		this->record.append(bytes, sizeof(bytes));
+	}
+	else {
+		writeToken(this->record, Token::GuidRef);
+		writeVarint(this->record, it->second);
+	}
+	return true;
+}
+
+auto EventJournalEncoder::encode(const EventJournalEntry& entry, std::string& out) -> void {
+	this->text.clear();
+	for (auto c : entry.data) {
+		if (c != '\n') this->text += c;
+	}
+
+	this->record.clear();
+	writeZigzag(this->record, static_cast<int64_t>(entry.time - this->lastTime));
+	writeZigzag(this->record, static_cast<int64_t>(entry.frame - this->lastFrame));
+	this->lastTime = entry.time;
+	this->lastFrame = entry.frame;
+
+	auto const headerSize = this->record.size();
+	auto sax = Sax(*this);
+
+	if (nlohmann::json::sax_parse(this->text, &sax)) this->lastTimestamp = sax.timestamp;
+	else {
+		sax.rollback();
+		this->record.resize(headerSize);
+		writeToken(this->record, Token::Raw);
+		writeVarint(this->record, this->text.size());
+		this->record += this->text;
+	}
+
+	writeVarint(out, this->record.size());
+	out += this->record;
+}
+
+EventJournalDecoder::EventJournalDecoder(std::string_view data) : data(data), valid(EventJournal::isBinary(data)) {
+	this->pos = this->valid ? EventJournal::Magic.size() : data.size();
+	this->end = data.size();
+}
+
+auto EventJournalDecoder::formatGuid(std::string_view bytes) -> std::string_view {
+	static constexpr char hex[] = "0123456789abcdef";
+
+	auto n = 0;
+	for (size_t i = 0; i < bytes.size(); ++i) {
+		if (i == 4 || i == 6 || i == 8 || i == 10) this->guidText[n++] = '-';
+		auto const byte = static_cast<unsigned char>(bytes[i]);
+		this->guidText[n++] = hex[byte >> 4];
+		this->guidText[n++] = hex[byte & 0xF];
+	}
+	return std::string_view(this->guidText.data(), this->guidText.size());
+}
+
+auto EventJournalDecoder::next(EventJournalEntry& entry, std::string& json) -> bool {
+	json.clear();
+	auto writer = JsonWriter{json};
+	if (!this->next(entry, writer)) return false;
+	entry.data = json;
+	return true;
+}
+
+auto EventJournalWriter::open(const std::filesystem::path& path) -> bool {
+	this->file.open(path, std::ios::binary | std::ios::trunc);
+	if (!this->file.is_open()) return false;
+
+	this->encoder = EventJournalEncoder();
+	this->start = Clock::now();
+
+	auto const header = this->encoder.header();
+	this->file.write(header.data(), static_cast<std::streamsize>(header.size()));
+	return true;
+}
+
+auto EventJournalWriter::close() -> void {
+	this->file.close();
+}
+
+auto EventJournalWriter::write(std::string_view data, uint64_t frame) -> void {
+	auto const time = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - this->start).count();
+
+	this->record.clear();
+	this->encoder.encode(EventJournalEntry{static_cast<uint64_t>(time), frame, data}, this->record);
+	this->file.write(this->record.data(), static_cast<std::streamsize>(this->record.size()));
+}
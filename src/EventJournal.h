@@ -0,0 +1,275 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Enums.h"
+
+// Session journals of the raw events sent by the game, so whole missions can be replayed outside of it.
+//
+// The text form has one event per line: "<microseconds since recording started>\t<frame number>\t<event JSON>".
+//
+// The binary form, which is what the plugin records, is an 8 byte header followed by one record per event:
+//   varint size of the rest of the record, zigzag varint time delta, zigzag varint frame delta, value tokens.
+// Values are a stream of one-byte tokens with LEB128 operands. Object keys, strings and lowercase GUIDs go into
+// per-journal dictionaries the first time they're seen and are referenced by index afterwards. Top-level event names
+// are written by Events ordinal and timestamps as microsecond deltas from the previous event. Everything a decoder
+// hands out views into the journal itself, so a memory-mapped file can be read without copying.
+struct EventJournalEntry
+{
+	uint64_t time = 0;
+	uint64_t frame = 0;
+	std::string_view data;
+};
+
+namespace EventJournal
+{
+	inline constexpr std::array<char, 8> Magic = {'S', 'T', 'M', 'J', 1, 0, 0, 0};
+
+	enum class Token : uint8_t
+	{
+		Null,
+		False,
+		True,
+		Integer,     // zigzag varint
+		Unsigned,    // varint
+		Float,       // 8 bytes, little-endian
+		String,      // varint length, bytes - added to the string dictionary
+		StringRef,   // varint index
+		Guid,        // 16 bytes - added to the GUID dictionary
+		GuidRef,     // varint index
+		Key,         // varint length, bytes - added to the key dictionary
+		KeyRef,      // varint index
+		BeginObject,
+		EndObject,
+		BeginArray,
+		EndArray,
+		Name,        // varint Events ordinal, varint length, bytes - defines the name for that ordinal
+		NameRef,     // varint Events ordinal
+		Timestamp,   // zigzag varint microseconds since the previous event's timestamp
+		Raw,         // varint length, bytes - event text that couldn't be parsed, kept verbatim
+	};
+
+	inline auto isBinary(std::string_view data) -> bool {
+		return data.size() >= Magic.size() && std::memcmp(data.data(), Magic.data(), Magic.size()) == 0;
+	}
+
+	// Parses a text journal held in memory into entries viewing into it. Malformed lines are skipped.
+	auto parseText(std::string_view text) -> std::vector<EventJournalEntry>;
+
+	// Appends an entry to a text journal.
+	auto appendText(std::string& out, const EventJournalEntry& entry) -> void;
+}
+
+// Converts events to binary journal records. Dictionaries persist across calls, so the records for one journal must
+// all come from the same encoder, following its header, in order.
+class EventJournalEncoder
+{
+public:
+	auto header() const -> std::string_view {
+		return std::string_view(EventJournal::Magic.data(), EventJournal::Magic.size());
+	}
+
+	// Appends the record for an event to out. Newlines are stripped from the event, as they are before decoding.
+	auto encode(const EventJournalEntry& entry, std::string& out) -> void;
+
+private:
+	struct Sax;
+
+	auto writeString(EventJournal::Token token, EventJournal::Token refToken, std::unordered_map<std::string, uint32_t>& dictionary, std::string_view str) -> void;
+	auto writeGuid(std::string_view str) -> bool;
+
+private:
+	std::unordered_map<std::string, uint32_t> keys;
+	std::unordered_map<std::string, uint32_t> strings;
+	std::unordered_map<std::string, uint32_t> guids;
+	std::array<bool, EventCount> namesDefined = {};
+	std::string record;
+	std::string text;
+	uint64_t lastTime = 0;
+	uint64_t lastFrame = 0;
+	int64_t lastTimestamp = 0;
+};
+
+// Streams events back out of a binary journal, either to a visitor or as JSON text.
+// A visitor provides null(), boolean(bool), integer(int64_t), unsignedInteger(uint64_t), number(double),
+// string(std::string_view), key(std::string_view), beginObject(), endObject(), beginArray(), endArray() and
+// raw(std::string_view). Throws std::runtime_error if the journal is corrupt.
+class EventJournalDecoder
+{
+public:
+	EventJournalDecoder(std::string_view data);
+
+	auto isValid() const -> bool {
+		return this->valid;
+	}
+
+	// Decodes the next event, passing its values to the visitor. Returns false at the end of the journal.
+	template<typename TVisitor>
+	auto next(EventJournalEntry& entry, TVisitor& visitor) -> bool;
+
+	// Decodes the next event as JSON text into json, which entry.data then views. Returns false at the end.
+	auto next(EventJournalEntry& entry, std::string& json) -> bool;
+
+private:
+	[[noreturn]] static auto corrupt() -> void {
+		throw std::runtime_error("corrupt event journal");
+	}
+
+	auto readByte() -> uint8_t {
+		if (this->pos >= this->end) corrupt();
+		return static_cast<uint8_t>(this->data[this->pos++]);
+	}
+
+	auto readVarint() -> uint64_t {
+		uint64_t value = 0;
+		for (auto shift = 0; shift < 64; shift += 7) {
+			auto const byte = this->readByte();
+			value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+			if (!(byte & 0x80)) return value;
+		}
+		corrupt();
+	}
+
+	auto readZigzag() -> int64_t {
+		auto const value = this->readVarint();
+		return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+	}
+
+	auto readBytes(size_t size) -> std::string_view {
+		if (size > this->end - this->pos) corrupt();
+		auto const bytes = this->data.substr(this->pos, size);
+		this->pos += size;
+		return bytes;
+	}
+
+	auto readString() -> std::string_view {
+		return this->readBytes(this->readVarint());
+	}
+
+	static auto lookup(const std::vector<std::string_view>& dictionary, uint64_t index) -> std::string_view {
+		if (index >= dictionary.size()) corrupt();
+		return dictionary[index];
+	}
+
+	auto formatGuid(std::string_view bytes) -> std::string_view;
+
+private:
+	std::string_view data;
+	size_t pos = 0;
+	size_t end = 0;
+	bool valid = false;
+	std::vector<std::string_view> keys;
+	std::vector<std::string_view> strings;
+	std::vector<std::string_view> guids;
+	std::vector<std::string_view> names;
+	std::array<char, 36> guidText = {};
+	uint64_t time = 0;
+	uint64_t frame = 0;
+	int64_t timestamp = 0;
+};
+
+template<typename TVisitor>
+auto EventJournalDecoder::next(EventJournalEntry& entry, TVisitor& visitor) -> bool {
+	using EventJournal::Token;
+
+	if (!this->valid || this->pos >= this->data.size()) return false;
+
+	this->end = this->data.size();
+	auto const size = this->readVarint();
+	if (size > this->data.size() - this->pos) corrupt();
+	this->end = this->pos + size;
+
+	this->time += this->readZigzag();
+	this->frame += this->readZigzag();
+	entry.time = this->time;
+	entry.frame = this->frame;
+
+	while (this->pos < this->end) {
+		switch (static_cast<Token>(this->readByte())) {
+			case Token::Null: visitor.null(); break;
+			case Token::False: visitor.boolean(false); break;
+			case Token::True: visitor.boolean(true); break;
+			case Token::Integer: visitor.integer(this->readZigzag()); break;
+			case Token::Unsigned: visitor.unsignedInteger(this->readVarint()); break;
+			case Token::Float: {
+				auto const bytes = this->readBytes(sizeof(double));
+				double value;
+				std::memcpy(&value, bytes.data(), sizeof(double));
+				visitor.number(value);
+				break;
+			}
+			case Token::String:
+				this->strings.push_back(this->readString());
+				visitor.string(this->strings.back());
+				break;
+			case Token::StringRef: visitor.string(lookup(this->strings, this->readVarint())); break;
+			case Token::Guid:
+				this->guids.push_back(this->readBytes(16));
+				visitor.string(this->formatGuid(this->guids.back()));
+				break;
+			case Token::GuidRef: visitor.string(this->formatGuid(lookup(this->guids, this->readVarint()))); break;
+			case Token::Key:
+				this->keys.push_back(this->readString());
+				visitor.key(this->keys.back());
+				break;
+			case Token::KeyRef: visitor.key(lookup(this->keys, this->readVarint())); break;
+			case Token::BeginObject: visitor.beginObject(); break;
+			case Token::EndObject: visitor.endObject(); break;
+			case Token::BeginArray: visitor.beginArray(); break;
+			case Token::EndArray: visitor.endArray(); break;
+			case Token::Name: {
+				auto const ordinal = this->readVarint();
+				if (ordinal >= EventCount) corrupt();
+				this->names.resize(EventCount);
+				this->names[ordinal] = this->readString();
+				visitor.string(this->names[ordinal]);
+				break;
+			}
+			case Token::NameRef: {
+				auto const ordinal = this->readVarint();
+				if (ordinal >= this->names.size() || this->names[ordinal].empty()) corrupt();
+				visitor.string(this->names[ordinal]);
+				break;
+			}
+			case Token::Timestamp:
+				this->timestamp += this->readZigzag();
+				visitor.number(static_cast<double>(this->timestamp) / 1e6);
+				break;
+			case Token::Raw: visitor.raw(this->readString()); break;
+			default: corrupt();
+		}
+	}
+
+	this->end = this->data.size();
+	return true;
+}
+
+// Records events to a binary journal file.
+class EventJournalWriter
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	auto open(const std::filesystem::path& path) -> bool;
+	auto close() -> void;
+
+	auto isOpen() const -> bool {
+		return this->file.is_open();
+	}
+
+	auto write(std::string_view data, uint64_t frame) -> void;
+
+private:
+	std::ofstream file;
+	EventJournalEncoder encoder;
+	Clock::time_point start;
+	std::string record;
+};
@@ -0,0 +1,323 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include "Enums.h"
+#include "Events.h"
+
+// Events sent by the game that are of no interest and shouldn't be reported as unhandled.
+inline constexpr std::string_view eventNameBlacklist[] = {
+	// Map-specific Perma Shortcut Events
+	"Bulldog_Ladder_A_Open",
+	"Bulldog_Ladder_B_Open",
+	"Dugong_Ladder_A_Down",
+	"Dugong_Ladder_B_Down",
+	"Edgy_Ladder_A_Down",
+	"Gecko_Ladder_A_Down",
+	"Gecko_Ladder_B_Down",
+	"Gecko_Ladder_C_Down",
+	"Rat_Ladder_A_Open",
+	// Freelancer Objectives
+	"Activate_BlindGuard",
+	"Activate_BlindTarget",
+	"Activate_Camera_Caught",
+	"Activate_Camera_DestroyRecorder",
+	"Activate_DartGun_Target",
+	"Activate_DisguiseBlown",
+	"Activate_Distract_Target",
+	"Activate_DontTakeDamage",
+	"Activate_EliminationPayout",
+	"Activate_HideTargetBodies",
+	"Activate_KillGuard_Sniper",
+	"Activate_KillGuard_SubMachineGun",
+	"Activate_KillMethod_Poison",
+	"Activate_KillMethod_Sniper",
+	"Activate_KillMethod_UnSilenced_Pistol",
+	"Activate_LimitedDisguise",
+	"Activate_No_Firearms",
+	"Activate_No_Witnesses",
+	"Activate_NoCombat",
+	"Activate_NoMissedShots",
+	"Activate_NoBodyFound",
+	"Activate_NotSpotted",
+	"Activate_PacifyGuard_Explosive",
+	"Activate_PoisonGuard_Any",
+	"Activate_PoisonGuard_Syringe",
+	"Activate_PoisonTarget_Emetic",
+	"Activate_PoisonTarget_Sedative",
+	"Activate_SA",
+	"Activate_SASO",
+	"Activate_SilentTakedown_3",
+	"Activate_Timed_SilientTakedown",
+	"DrActivate_EliminationPayout",
+	// Freelancer Challenge Events
+	"CollectorUpdate",
+	"GunmasterComplete",
+	"GunslingerUpdate",
+	"LetsGoHuntingUpdate",
+	"OneShotOneKillUpdate",
+	"SprayAndPrayUpdate",
+	"ThisIsMyRifleUpdate",
+	"UpCloseAndPersonalUpdate",
+	// Misc. Freelancer Events
+	"AddAssassin_Event",
+	"AddLookout_Event",
+	"CompleteEvergreenPrimaryObj",
+	"Evergreen_EvaluateChallenge",
+	"Evergreen_Mastery_Level",
+	"Evergreen_Merces_Data",
+	"Evergreen_MissionCompleted_Hot",
+	"Evergreen_MissionPayout",
+	"Evergreen_Payout_Data",
+	"Evergreen_Safehouse_Stash_ItemChosen",
+	"Evergreen_SecurityCameraDestroyed",
+	"Evergreen_Stash_ItemChosen",
+	"Evergreen_Suspect_Looks",
+	//"EvergreenExitTriggered",
+	//"EvergreenExitTriggeredOrWounded",
+	//"EvergreenMissionEnd",
+	"GearSlotsTotal",
+	"GearSlotsTutorialised",
+	"GearSlotsUsed",
+	"MildMissionCompleted_Africa_Event",
+	"MildMissionCompleted_Asia_Event",
+	"MildMissionCompleted_Event",
+	"MissionCompleted_Event",
+	"NoTargetsLeft",
+	"NumberOfTargets",
+	"PayoutObjective_Completed",
+	"ScoringScreenEndState_CampaignCompletedBonusXP_Professional",
+	"ScoringScreenEndState_CampaignCompletedBonusXP_Hard",
+	"ScoringScreenEndState_MildCompleted",
+	"SetPayout",
+	"Setup_TargetName",
+	"TravelDestination",
+	// Misc. Events
+	"ChallengeCompleted",
+	"ContractSessionMarker",
+	"CpdSet",
+	"Hero_Health",
+	"LeaderboardUpdated",
+	"Progression_XPGain",
+	"SegmentClosing",
+	"StartCpd",
+	// Maybe Useful Freelancer Events
+	"AddSuspectGlow",
+	//"Dart_Hit"
+	//"Evergreen_ShotMissed",
+	"Leader_In_Meeting",
+	"LeaderDeadEscaping_Event",
+	"LeaderEscaping",
+	"LeaderPacifiedEscaping_Event",
+	"RemoveSuspectGlow",
+	"SupplierVisited",
+	"TargetPickedConfirm",
+};
+
+enum class EventNameKind : uint8_t
+{
+	Unknown,
+	Event,
+	Blacklisted,
+};
+
+struct EventNameInfo
+{
+	EventNameKind kind = EventNameKind::Unknown;
+	Events event = {};
+};
+
+struct EventNameEntry
+{
+	std::string_view name;
+	EventNameInfo info;
+};
+
+template<Events E>
+concept HasEventName = requires { Event<E>::Name; };
+
+constexpr auto loadEventNameWord(const char* data, size_t size) -> uint64_t {
+	if (!std::is_constant_evaluated() && size == sizeof(uint64_t)) {
+		uint64_t word;
+		std::memcpy(&word, data, sizeof(word));
+		return word;
+	}
+
+	uint64_t word = 0;
+	for (size_t i = 0; i < size; ++i)
+		word |= static_cast<uint64_t>(static_cast<uint8_t>(data[i])) << (i * 8);
+	return word;
+}
+
+// Hashes a word at a time, finishing with an overlapping load of the last 8 bytes for names of 8 bytes or more.
+// Must give the same result at compile time and run time, hence the little-endian requirement.
+constexpr auto hashEventName(std::string_view name) -> uint64_t {
+	static_assert(std::endian::native == std::endian::little);
+
+	auto hash = 0x9e3779b97f4a7c15ull ^ (name.size() * 0xff51afd7ed558ccdull);
+	auto const data = name.data();
+	auto const size = name.size();
+
+	if (size < sizeof(uint64_t)) hash ^= loadEventNameWord(data, size);
+	else {
+		for (size_t i = 0; i + sizeof(uint64_t) < size; i += sizeof(uint64_t)) {
+			hash = (hash ^ loadEventNameWord(data + i, sizeof(uint64_t))) * 0x9e3779b97f4a7c15ull;
+			hash ^= hash >> 29;
+		}
+		hash ^= loadEventNameWord(data + size - sizeof(uint64_t), sizeof(uint64_t));
+	}
+
+	hash *= 0x9e3779b97f4a7c15ull;
+	hash ^= hash >> 33;
+	hash *= 0xff51afd7ed558ccdull;
+	hash ^= hash >> 33;
+	hash *= 0xc4ceb9fe1a85ec53ull;
+	hash ^= hash >> 33;
+	return hash;
+}
+
+// Perfect hash over a fixed set of event names, built at compile time by hash-and-displace.
+// Each key's bucket gets a displacement chosen so every key lands in its own slot, so a lookup is one hash, one
+// displacement load and one string compare against the only slot the name could be in.
+template<size_t N>
+class EventNameTable
+{
+public:
+	static constexpr size_t SlotCount = std::bit_ceil(N + N / 2);
+	static constexpr size_t BucketCount = std::bit_ceil(std::max<size_t>(N / 2, 1));
+
+	constexpr EventNameTable(std::span<const EventNameEntry> keys) {
+		std::array<uint64_t, N> hashes{};
+		std::array<size_t, BucketCount> bucketSizes{};
+		std::array<size_t, BucketCount> order{};
+		std::array<bool, SlotCount> used{};
+
+		for (size_t i = 0; i < N; ++i) {
+			hashes[i] = hashEventName(keys[i].name);
+			for (size_t j = 0; j < i; ++j) {
+				if (hashes[j] == hashes[i]) throw "duplicate event name hash";
+			}
+			++bucketSizes[bucketOf(hashes[i])];
+		}
+
+		// Place the most crowded buckets first, while there is the most room.
+		for (size_t i = 0; i < BucketCount; ++i) order[i] = i;
+		std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+			return bucketSizes[a] > bucketSizes[b];
+		});
+
+		for (auto bucket : order) {
+			if (!bucketSizes[bucket]) break;
+
+			for (uint32_t displacement = 0;; ++displacement) {
+				if (displacement > UINT16_MAX) throw "no displacement found for event name bucket";
+
+				std::array<size_t, N> taken{};
+				size_t numTaken = 0;
+
+				for (size_t i = 0; i < N; ++i) {
+					if (bucketOf(hashes[i]) != bucket) continue;
+					auto const slot = slotOf(hashes[i], displacement);
+					if (used[slot] || std::find(taken.begin(), taken.begin() + numTaken, slot) != taken.begin() + numTaken)
+						break;
+					taken[numTaken++] = slot;
+				}
+
+				if (numTaken != bucketSizes[bucket]) continue;
+
+				this->displacements[bucket] = static_cast<uint16_t>(displacement);
+				for (size_t i = 0; i < N; ++i) {
+					if (bucketOf(hashes[i]) != bucket) continue;
+					auto const slot = slotOf(hashes[i], displacement);
+					used[slot] = true;
+					this->slots[slot] = keys[i];
+				}
+				break;
+			}
+		}
+	}
+
+	constexpr auto find(std::string_view name) const -> EventNameInfo {
+		auto const hash = hashEventName(name);
+		auto const& entry = this->slots[slotOf(hash, this->displacements[bucketOf(hash)])];
+		return entry.name == name ? entry.info : EventNameInfo{};
+	}
+
+	constexpr auto entries() const -> std::span<const EventNameEntry> {
+		return this->slots;
+	}
+
+private:
+	static constexpr auto bucketOf(uint64_t hash) -> size_t {
+		return static_cast<size_t>(hash >> 40) & (BucketCount - 1);
+	}
+
+	static constexpr auto slotOf(uint64_t hash, uint32_t displacement) -> size_t {
+		auto const f1 = static_cast<uint32_t>(hash);
+		auto const f2 = static_cast<uint32_t>(hash >> 32) | 1;
+		return (f1 + displacement * f2) & (SlotCount - 1);
+	}
+
+private:
+	std::array<EventNameEntry, SlotCount> slots{};
+	std::array<uint16_t, BucketCount> displacements{};
+};
+
+template<size_t... I>
+constexpr auto collectEventNames(std::index_sequence<I...>) {
+	std::array<EventNameEntry, EventCount + std::size(eventNameBlacklist)> entries{};
+	size_t count = 0;
+
+	auto const add = [&]<size_t Index>() {
+		constexpr auto ev = static_cast<Events>(Index);
+		if constexpr (HasEventName<ev>)
+			entries[count++] = EventNameEntry{Event<ev>::Name, {EventNameKind::Event, ev}};
+	};
+	(add.template operator()<I>(), ...);
+
+	// Blacklisting takes precedence over an event of the same name.
+	for (auto name : eventNameBlacklist) {
+		auto const it = std::find_if(entries.begin(), entries.begin() + count, [name](const EventNameEntry& entry) {
+			return entry.name == name;
+		});
+		if (it != entries.begin() + count) it->info.kind = EventNameKind::Blacklisted;
+		else entries[count++] = EventNameEntry{name, {EventNameKind::Blacklisted}};
+	}
+
+	return std::pair{entries, count};
+}
+
+inline constexpr auto eventNameKeys = collectEventNames(std::make_index_sequence<EventCount>());
+inline constexpr auto eventNameTable = EventNameTable<eventNameKeys.second>(std::span(eventNameKeys.first.data(), eventNameKeys.second));
+
+// Classifies an event name sent by the game with a single probe and no allocation.
+constexpr auto lookupEventName(std::string_view name) -> EventNameInfo {
+	return eventNameTable.find(name);
+}
+
+template<size_t... I>
+constexpr auto collectEventNamesByValue(std::index_sequence<I...>) {
+	std::array<std::string_view, EventCount> names{};
+
+	auto const add = [&]<size_t Index>() {
+		constexpr auto ev = static_cast<Events>(Index);
+		if constexpr (HasEventName<ev>)
+			names[Index] = Event<ev>::Name;
+	};
+	(add.template operator()<I>(), ...);
+	return names;
+}
+
+inline constexpr auto eventNamesByValue = collectEventNamesByValue(std::make_index_sequence<EventCount>());
+
+// Name sent by the game for the event, or an empty view if it has no Event<> definition.
+constexpr auto getEventName(Events ev) -> std::string_view {
+	return eventNamesByValue[static_cast<size_t>(ev)];
+}
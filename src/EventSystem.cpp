@@ -1,109 +0,0 @@
-#include "EventSystem.h"
-
-std::unordered_set<std::string> eventNameBlacklist = {
-	// Map-specific Perma Shortcut Events
-	"Bulldog_Ladder_A_Open",
-	"Bulldog_Ladder_B_Open",
-	"Dugong_Ladder_A_Down",
-	"Dugong_Ladder_B_Down",
-	"Edgy_Ladder_A_Down",
-	"Gecko_Ladder_A_Down",
-	"Gecko_Ladder_B_Down",
-	"Gecko_Ladder_C_Down",
-	"Rat_Ladder_A_Open",
-	// Freelancer Objectives
-	"Activate_BlindGuard",
-	"Activate_BlindTarget",
-	"Activate_Camera_Caught",
-	"Activate_Camera_DestroyRecorder",
-	"Activate_DartGun_Target",
-	"Activate_DisguiseBlown",
-	"Activate_Distract_Target",
-	"Activate_DontTakeDamage",
-	"Activate_EliminationPayout",
-	"Activate_HideTargetBodies",
-	"Activate_KillGuard_Sniper",
-	"Activate_KillGuard_SubMachineGun",
-	"Activate_KillMethod_Poison",
-	"Activate_KillMethod_Sniper",
-	"Activate_KillMethod_UnSilenced_Pistol",
-	"Activate_LimitedDisguise",
-	"Activate_No_Firearms",
-	"Activate_No_Witnesses",
-	"Activate_NoCombat",
-	"Activate_NoMissedShots",
-	"Activate_NoBodyFound",
-	"Activate_NotSpotted",
-	"Activate_PacifyGuard_Explosive",
-	"Activate_PoisonGuard_Any",
-	"Activate_PoisonGuard_Syringe",
-	"Activate_PoisonTarget_Emetic",
-	"Activate_PoisonTarget_Sedative",
-	"Activate_SA",
-	"Activate_SASO",
-	"Activate_SilentTakedown_3",
-	"Activate_Timed_SilientTakedown",
-	"DrActivate_EliminationPayout",
-	// Freelancer Challenge Events
-	"CollectorUpdate",
-	"GunmasterComplete",
-	"GunslingerUpdate",
-	"LetsGoHuntingUpdate",
-	"OneShotOneKillUpdate",
-	"SprayAndPrayUpdate",
-	"ThisIsMyRifleUpdate",
-	"UpCloseAndPersonalUpdate",
-	// Misc. Freelancer Events
-	"AddAssassin_Event",
-	"AddLookout_Event",
-	"CompleteEvergreenPrimaryObj",
-	"Evergreen_EvaluateChallenge",
-	"Evergreen_Mastery_Level",
-	"Evergreen_Merces_Data",
-	"Evergreen_MissionCompleted_Hot",
-	"Evergreen_MissionPayout",
-	"Evergreen_Payout_Data",
-	"Evergreen_Safehouse_Stash_ItemChosen",
-	"Evergreen_SecurityCameraDestroyed",
-	"Evergreen_Stash_ItemChosen",
-	"Evergreen_Suspect_Looks",
-	//"EvergreenExitTriggered",
-	//"EvergreenExitTriggeredOrWounded",
-	//"EvergreenMissionEnd",
-	"GearSlotsTotal",
-	"GearSlotsTutorialised",
-	"GearSlotsUsed",
-	"MildMissionCompleted_Africa_Event",
-	"MildMissionCompleted_Asia_Event",
-	"MildMissionCompleted_Event",
-	"MissionCompleted_Event",
-	"NoTargetsLeft",
-	"NumberOfTargets",
-	"PayoutObjective_Completed",
-	"ScoringScreenEndState_CampaignCompletedBonusXP_Professional",
-	"ScoringScreenEndState_CampaignCompletedBonusXP_Hard",
-	"ScoringScreenEndState_MildCompleted",
-	"SetPayout",
-	"Setup_TargetName",
-	"TravelDestination",
-	// Misc. Events
-	"ChallengeCompleted",
-	"ContractSessionMarker",
-	"CpdSet",
-	"Hero_Health",
-	"LeaderboardUpdated",
-	"Progression_XPGain",
-	"SegmentClosing",
-	"StartCpd",
-	// Maybe Useful Freelancer Events
-	"AddSuspectGlow",
-	//"Dart_Hit"
-	//"Evergreen_ShotMissed",
-	"Leader_In_Meeting",
-	"LeaderDeadEscaping_Event",
-	"LeaderEscaping",
-	"LeaderPacifiedEscaping_Event",
-	"RemoveSuspectGlow",
-	"SupplierVisited",
-	"TargetPickedConfirm",
-};
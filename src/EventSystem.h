@@ -1,132 +1,200 @@
 #pragma once
-#include <functional>
-#include <memory>
+#include <array>
+#include <cstddef>
+#include <new>
 #include <string>
-#include <unordered_set>
-#include <unordered_map>
-#include "json.hpp"
-
-enum class Events;
-template<Events>
-struct Event;
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include "EventDecoder.h"
+#include "EventNames.h"
+#include "Events.h"
+#include "Profiler.h"
 
 template<Events T>
-class ServerEvent
+class ServerEvent : public ServerEventHeader
 {
 public:
-	nlohmann::json json;
+	// Raw event JSON, only valid for the duration of the handler calls.
+	std::string_view Data;
 	typename Event<T>::EventValue Value;
-	std::string ContractSessionId;
-	std::string ContractId;
-	std::string Name;
-	double Timestamp = 0;
 
 public:
+	ServerEvent() = default;
 	ServerEvent(typename Event<T>::EventValue&& value) : Value(std::forward<typename Event<T>::EventValue>(value))
 	{ }
 };
 
-extern std::unordered_set<std::string> eventNameBlacklist;
-
-class EventListenersBase
+// Fixed set of handler slots for one event type.
+// Handlers are stored inline and invoked through a plain function pointer, so dispatch involves no std::function and
+// no allocation. Handlers must be small, trivially copyable callables - in practice lambdas capturing a pointer or two.
+template<Events TEvent>
+class EventListeners
 {
-protected:
-	auto virtual call(const nlohmann::json& ev) const -> bool = 0;
-
 public:
-	auto operator()(const nlohmann::json& ev) const -> bool {
-		return this->call(ev);
+	static constexpr size_t MaxHandlers = 4;
+
+	template<typename TFunc>
+	auto add(TFunc&& func) -> bool {
+		using Func = std::decay_t<TFunc>;
+		static_assert(sizeof(Func) <= sizeof(Slot::storage) && alignof(Func) <= alignof(void*), "event handler too large for its slot");
+		static_assert(std::is_trivially_copyable_v<Func>, "event handlers must be trivially copyable");
+
+		if (this->count == MaxHandlers) return false;
+
+		auto& slot = this->slots[this->count++];
+		new (slot.storage) Func(std::forward<TFunc>(func));
+		slot.call = [](const void* storage, const ServerEvent<TEvent>& ev) {
+			(*std::launder(static_cast<const Func*>(storage)))(ev);
+		};
+		return true;
+	}
+
+	auto operator()(const ServerEvent<TEvent>& ev) const -> void {
+		auto const start = Profiler::Clock::now();
+		for (size_t i = 0; i < this->count; ++i)
+			this->slots[i].call(this->slots[i].storage, ev);
+
+		auto const end = Profiler::Clock::now();
+		auto const elapsed = Profiler::getNanoseconds(start, end);
+		Profiler::getSection(ProfileSection::EventHandlers).record(elapsed);
+		Profiler::getHandlers(TEvent).record(elapsed);
+
+		if (Profiler::isRecordingTimeline()) {
+			Profiler::recordSpan(ProfileSpan{
+				.start = start.time_since_epoch().count(),
+				.end = end.time_since_epoch().count(),
+				.section = ProfileSection::EventHandlers,
+				.event = static_cast<uint16_t>(TEvent),
+			});
+		}
 	}
 
-	auto handle(const nlohmann::json& ev) const -> bool {
-		return this->call(ev);
+	auto size() const -> size_t {
+		return this->count;
 	}
+
+private:
+	struct Slot
+	{
+		alignas(void*) std::byte storage[2 * sizeof(void*)];
+		auto (*call)(const void* storage, const ServerEvent<TEvent>& ev) -> void = nullptr;
+	};
+
+	std::array<Slot, MaxHandlers> slots{};
+	size_t count = 0;
 };
 
+// Events whose value is a RepoIdListChange, which keep the last list they carried.
 template<Events TEvent>
-class EventListeners : public EventListenersBase
-{
-public:
-	using HandlerFunc = void(const ServerEvent<TEvent>&);
+constexpr auto isCumulativeEvent() -> bool {
+	if constexpr (HasEventName<TEvent>) return std::is_same_v<typename Event<TEvent>::EventValue, RepoIdListChange>;
+	else return false;
+}
 
-	EventListeners()
-	{ }
-
-	template<typename TFunc>
-	auto add(TFunc&& func) -> void {
-		this->handlers.emplace_back(std::forward<TFunc>(func));
+class EventSystem {
+public:
+	template<Events TEvent, typename TFunc>
+	auto listen(TFunc&& handler) -> bool {
+		return this->getListeners<TEvent>().add(std::forward<TFunc>(handler));
 	}
 
-protected:
-	auto call(const nlohmann::json& ev) const -> bool {
-		auto it = ev.find("Value");
-		if (it == ev.end()) return false;
+	// Decodes the event straight from its JSON text into the typed value, without building a DOM.
+	// Returns false if nothing listens to the event.
+	auto handle(Events ev, std::string_view data) const -> bool;
 
-		ServerEvent<TEvent> serverEvent{typename Event<TEvent>::EventValue(*it)};
-		serverEvent.json  = ev;
-		serverEvent.Name = ev.value("Name", "");
-		serverEvent.ContractId = ev.value("ContractId", "");
-		serverEvent.ContractSessionId = ev.value("ContractSessionId", "");
-		serverEvent.Timestamp = ev.value("Timestamp", 0);
+	// Looks the event up by name first.
+	auto handle(std::string_view name, std::string_view data) const -> bool {
+		auto const info = lookupEventName(name);
+		return info.kind == EventNameKind::Event && this->handle(info.event, data);
+	}
 
-		for (auto& handler : this->handlers)
-			handler(serverEvent);
+	auto getEventName(Events ev) const -> std::string_view {
+		return ::getEventName(ev);
+	}
 
-		return this->handlers.size() > 0;
+	// Forgets the lists carried by cumulative events (see CumulativeIdList), for a new contract.
+	auto resetLists() -> void {
+		std::apply([](auto&... lists) {
+			(resetList(lists), ...);
+		}, this->lists);
 	}
 
 private:
-	std::vector<std::function<HandlerFunc>> handlers;
-};
+	using Decoder = auto (EventSystem::*)(std::string_view data) const -> bool;
 
-class EventSystem {
-public:
 	template<Events TEvent>
-	auto listen(std::function<void(const ServerEvent<TEvent>&)> handler) {
-		auto eventNameIt = this->eventNames.find(TEvent);
-		if (eventNameIt == this->eventNames.end())
-			eventNameIt = this->eventNames.emplace(TEvent, Event<TEvent>::Name).first;
-		
-		auto it = this->listeners.find(eventNameIt->second);
-		if (it == this->listeners.end())
-			it = this->listeners.emplace(eventNameIt->second, std::make_unique<EventListeners<TEvent>>()).first;
-		static_cast<EventListeners<TEvent>*>(it->second.get())->add(handler);
+	auto getListeners() -> EventListeners<TEvent>& {
+		return std::get<static_cast<size_t>(TEvent)>(this->listeners);
 	}
 
-	auto handle(const std::string& str, const nlohmann::json& json) -> bool {
-		auto listeners = this->findListeners(str);
-		if (listeners) return listeners->handle(json);
-		return false;
+	template<Events TEvent>
+	auto getListeners() const -> const EventListeners<TEvent>& {
+		return std::get<static_cast<size_t>(TEvent)>(this->listeners);
 	}
 
-	auto handle(Events ev, const nlohmann::json& json) {
-		auto listeners = this->findListeners(ev);
-		if (listeners) return listeners->handle(json);
-		return false;
+	template<Events TEvent>
+	auto decode(std::string_view data) const -> bool {
+		using EventValue = typename Event<TEvent>::EventValue;
+
+		auto const& listeners = this->getListeners<TEvent>();
+		if (!listeners.size()) return false;
+
+		ServerEvent<TEvent> serverEvent;
+
+		if constexpr (isCumulativeEvent<TEvent>()) {
+			// A list identical to the last one is handled, there's just nothing to tell the listeners.
+			auto& list = std::get<static_cast<size_t>(TEvent)>(this->lists);
+			if (list.decode(data, serverEvent) == CumulativeIdList::Result::Unchanged) return true;
+			serverEvent.Value = list.getChange();
+		}
+		else EventDecoder::decode(data, serverEvent, getEventFieldObject(serverEvent.Value), getEventFieldTable<EventValue>());
+
+		serverEvent.Data = data;
+		listeners(serverEvent);
+		return true;
 	}
 
-	auto getEventName(Events ev) -> const std::string* {
-		auto it = this->eventNames.find(ev);
-		if (it != this->eventNames.end())
-			return &it->second;
-		return nullptr;
+	// Dispatch tables are indexed by Events ordinal, with null for events that have no Event<> definition.
+	template<Events TEvent>
+	static constexpr auto getDecoder() -> Decoder {
+		if constexpr (HasEventName<TEvent>) return &EventSystem::decode<TEvent>;
+		else return nullptr;
 	}
 
-private:
-	auto findListeners(Events ev) -> EventListenersBase* {
-		auto name = this->getEventName(ev);
-		if (name) return this->findListeners(*name);
-		return nullptr;
+	template<size_t... I>
+	static constexpr auto makeDecoders(std::index_sequence<I...>) -> std::array<Decoder, EventCount> {
+		return {getDecoder<static_cast<Events>(I)>()...};
 	}
 
-	auto findListeners(const std::string& name) -> EventListenersBase* {
-		auto it = this->listeners.find(name);
-		if (it != this->listeners.end())
-			return it->second.get();
-		return nullptr;
+	template<Events TEvent>
+	using ListenersFor = std::conditional_t<HasEventName<TEvent>, EventListeners<TEvent>, std::monostate>;
+
+	template<size_t... I>
+	static auto makeListeners(std::index_sequence<I...>) -> std::tuple<ListenersFor<static_cast<Events>(I)>...>;
+
+	template<Events TEvent>
+	using ListFor = std::conditional_t<isCumulativeEvent<TEvent>(), CumulativeIdList, std::monostate>;
+
+	template<size_t... I>
+	static auto makeLists(std::index_sequence<I...>) -> std::tuple<ListFor<static_cast<Events>(I)>...>;
+
+	static auto resetList(CumulativeIdList& list) -> void {
+		list.reset();
 	}
 
+	static auto resetList(std::monostate) -> void {}
+
 private:
-	std::unordered_map<Events, std::string> eventNames;
-	std::unordered_map<std::string, std::unique_ptr<EventListenersBase>> listeners;
+	decltype(makeListeners(std::make_index_sequence<EventCount>())) listeners;
+	// Decoding is otherwise stateless, so this is mutable rather than making handle() non-const.
+	mutable decltype(makeLists(std::make_index_sequence<EventCount>())) lists;
 };
+
+inline auto EventSystem::handle(Events ev, std::string_view data) const -> bool {
+	static constexpr auto decoders = makeDecoders(std::make_index_sequence<EventCount>());
+	auto const decoder = decoders[static_cast<size_t>(ev)];
+	return decoder && (this->*decoder)(data);
+}
@@ -0,0 +1,239 @@
+#pragma once
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string_view>
+#include <thread>
+#include "Timeline.h"
+
+// Preallocated single-producer/single-consumer byte ring.
+// Each record is a header followed by the payload, padded to a multiple of the header size. Records never wrap: if a
+// record doesn't fit before the end of the buffer, a skip record fills the remainder and it's written at the start.
+class EventRing
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	EventRing(size_t capacity) : capacity(std::bit_ceil(capacity)), buffer(std::make_unique<std::byte[]>(this->capacity))
+	{ }
+
+	auto maxRecordSize() const -> size_t {
+		return this->capacity / 2 - sizeof(Header);
+	}
+
+	// Producer only. Returns false if there is currently not enough free space.
+	auto push(std::string_view data) -> bool {
+		if (data.size() > this->maxRecordSize()) return false;
+
+		auto const head = this->head.load(std::memory_order_relaxed);
+		auto const offset = head & (this->capacity - 1);
+		auto const size = alignedSize(data.size());
+		auto const padding = offset + size > this->capacity ? this->capacity - offset : 0;
+
+		if (head + padding + size - this->cachedTail > this->capacity) {
+			this->cachedTail = this->tail.load(std::memory_order_acquire);
+			if (head + padding + size - this->cachedTail > this->capacity)
+				return false;
+		}
+
+		if (padding) {
+			this->writeHeader(offset, Header{SkipRecord, 0});
+			this->writeHeader(0, Header{static_cast<uint32_t>(data.size()), Clock::now().time_since_epoch().count()});
+			std::memcpy(&this->buffer[sizeof(Header)], data.data(), data.size());
+		}
+		else {
+			this->writeHeader(offset, Header{static_cast<uint32_t>(data.size()), Clock::now().time_since_epoch().count()});
+			std::memcpy(&this->buffer[offset + sizeof(Header)], data.data(), data.size());
+		}
+
+		this->head.store(head + padding + size, std::memory_order_release);
+		return true;
+	}
+
+	// Consumer only. Calls func(std::string_view data, Clock::time_point pushed) for the oldest record, if any.
+	// The view is only valid for the duration of the call.
+	template<typename TFunc>
+	auto pop(TFunc&& func) -> bool {
+		auto tail = this->tail.load(std::memory_order_relaxed);
+
+		for (;;) {
+			if (tail == this->cachedHead) {
+				this->cachedHead = this->head.load(std::memory_order_acquire);
+				if (tail == this->cachedHead) return false;
+			}
+
+			auto const offset = tail & (this->capacity - 1);
+			auto const header = this->readHeader(offset);
+
+			if (header.size == SkipRecord) {
+				tail += this->capacity - offset;
+				this->tail.store(tail, std::memory_order_release);
+				continue;
+			}
+
+			auto data = std::string_view(reinterpret_cast<const char*>(&this->buffer[offset + sizeof(Header)]), header.size);
+			func(data, Clock::time_point(Clock::duration(header.time)));
+			this->tail.store(tail + alignedSize(header.size), std::memory_order_release);
+			return true;
+		}
+	}
+
+	auto empty() const -> bool {
+		return this->head.load(std::memory_order_acquire) == this->tail.load(std::memory_order_acquire);
+	}
+
+private:
+	struct Header
+	{
+		uint32_t size;
+		Clock::rep time;
+	};
+
+	static_assert(std::has_single_bit(sizeof(Header)));
+
+	static constexpr uint32_t SkipRecord = ~0u;
+
+	// Keeping every record offset a multiple of the header size guarantees a skip record always fits.
+	static constexpr auto alignedSize(size_t size) -> size_t {
+		return (sizeof(Header) + size + sizeof(Header) - 1) & ~(sizeof(Header) - 1);
+	}
+
+	auto writeHeader(size_t offset, const Header& header) -> void {
+		std::memcpy(&this->buffer[offset], &header, sizeof(Header));
+	}
+
+	auto readHeader(size_t offset) const -> Header {
+		Header header;
+		std::memcpy(&header, &this->buffer[offset], sizeof(Header));
+		return header;
+	}
+
+private:
+	const size_t capacity;
+	std::unique_ptr<std::byte[]> buffer;
+	alignas(64) std::atomic<size_t> head = 0;
+	size_t cachedTail = 0;
+	alignas(64) std::atomic<size_t> tail = 0;
+	size_t cachedHead = 0;
+};
+
+// Dedicated consumer thread for an EventRing.
+// The producer (the game thread) only copies event bytes into the ring; parsing, dispatch and stat updates happen
+// in the handler on the worker thread. Platform-independent so it can be driven outside the game.
+// The handler must not throw, as nothing on the worker thread would catch it.
+class EventWorker
+{
+public:
+	using Clock = EventRing::Clock;
+	using Handler = std::function<void(std::string_view data, Clock::time_point pushed)>;
+
+	struct Counters
+	{
+		uint64_t posted = 0;
+		uint64_t processed = 0;
+		uint64_t stalls = 0;
+		uint64_t rejected = 0;
+	};
+
+	EventWorker(size_t capacity = 1 << 20) : ring(capacity)
+	{ }
+
+	~EventWorker() {
+		this->stop();
+	}
+
+	auto start(Handler handler) -> bool {
+		if (this->running) return false;
+		this->handler = std::move(handler);
+		this->running = true;
+		this->thread = std::thread([this] { this->run(); });
+		return true;
+	}
+
+	// Processes everything still queued, then joins the worker thread.
+	auto stop() -> void {
+		if (!this->running) return;
+		this->running = false;
+		this->sequence.fetch_add(1, std::memory_order_release);
+		this->sequence.notify_one();
+		this->thread.join();
+	}
+
+	auto isRunning() const -> bool { return this->running; }
+
+	// Producer only. Waits until the worker has handled everything posted so far, so an event the producer then
+	// handles itself (one post rejected) isn't handled ahead of those, or alongside them.
+	auto drain() -> void {
+		while (this->counters.processed.load(std::memory_order_acquire) < this->counters.posted.load(std::memory_order_relaxed))
+			std::this_thread::yield();
+	}
+
+	// Producer only. Waits for the worker to free up space if the ring is full, so events are never dropped or
+	// reordered. Returns false if the event can't be queued at all (worker stopped or event larger than the ring).
+	auto post(std::string_view data) -> bool {
+		if (!this->running || data.size() > this->ring.maxRecordSize()) {
+			this->counters.rejected.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+
+		if (!this->ring.push(data)) {
+			this->counters.stalls.fetch_add(1, std::memory_order_relaxed);
+			do std::this_thread::yield();
+			while (!this->ring.push(data));
+		}
+
+		this->counters.posted.fetch_add(1, std::memory_order_relaxed);
+		this->sequence.fetch_add(1, std::memory_order_release);
+		this->sequence.notify_one();
+		return true;
+	}
+
+	auto getCounters() const -> Counters {
+		return Counters{
+			this->counters.posted.load(std::memory_order_relaxed),
+			this->counters.processed.load(std::memory_order_relaxed),
+			this->counters.stalls.load(std::memory_order_relaxed),
+			this->counters.rejected.load(std::memory_order_relaxed),
+		};
+	}
+
+private:
+	auto run() -> void {
+		Timeline::setThreadName("Event worker");
+
+		for (;;) {
+			auto const seq = this->sequence.load(std::memory_order_acquire);
+
+			while (this->ring.pop(this->handler))
+				this->counters.processed.fetch_add(1, std::memory_order_release);
+
+			if (!this->running) {
+				if (this->ring.empty()) break;
+				continue;
+			}
+
+			this->sequence.wait(seq, std::memory_order_acquire);
+		}
+	}
+
+private:
+	struct AtomicCounters
+	{
+		std::atomic<uint64_t> posted = 0;
+		std::atomic<uint64_t> processed = 0;
+		std::atomic<uint64_t> stalls = 0;
+		std::atomic<uint64_t> rejected = 0;
+	};
+
+	EventRing ring;
+	Handler handler;
+	AtomicCounters counters;
+	std::atomic<uint32_t> sequence = 0;
+	std::atomic_bool running = false;
+	std::thread thread;
+};
@@ -5,9 +5,13 @@
 #include <vector>
 #include <Glacier/Enums.h>
 #include <Glacier/ZMath.h>
-#include "json.hpp"
+#include "CumulativeIdList.h"
 #include "Enums.h"
-#include "EventSystem.h"
+#include "EventFields.h"
+#include "RepoId.h"
+
+template<Events>
+struct Event;
 
 struct GameChanger {
 	//std::string Id;
@@ -27,106 +31,118 @@ struct LoadoutItemEventValue {
 	std::string RepositoryId;
 	std::string InstanceId;
 	std::vector<std::string> OnlineTraits;
-	std::optional<std::nullptr_t> Category;
+	std::optional<std::nullptr_t> Category = nullptr;
+};
+
+template<>
+struct EventValueFields<LoadoutItemEventValue> : EventFieldBuilder<LoadoutItemEventValue> {
+	static constexpr auto Fields = std::array{
+		field<&Type::RepositoryId>("RepositoryId"),
+		field<&Type::InstanceId>("InstanceId"),
+		field<&Type::OnlineTraits>("OnlineTraits"),
+	};
 };
 
 struct DamageHistoryEventValue {
-	bool Explosive;
-	bool Headshot;
-	bool Accident;
-	bool WeaponSilenced;
-	bool Projectile;
-	bool Sniper;
-	bool ThroughWall;
+	bool Explosive = false;
+	bool Headshot = false;
+	bool Accident = false;
+	bool WeaponSilenced = false;
+	bool Projectile = false;
+	bool Sniper = false;
+	bool ThroughWall = false;
 	std::string InstanceId;
 	std::string RepositoryId;
-	int BodyPartId;
-	int TotalDamage;
-
-	DamageHistoryEventValue(const nlohmann::json& json) :
-		Explosive(json.value("Explosive", false)),
-		Headshot(json.value("Headshot", false)),
-		Accident(json.value("Accident", false)),
-		WeaponSilenced(json.value("WeaponSilenced", false)),
-		Projectile(json.value("Projectile", false)),
-		Sniper(json.value("Sniper", false)),
-		ThroughWall(json.value("ThroughWall", false)),
-		InstanceId(json.value("InstanceId", "")),
-		RepositoryId(json.value("RepositoryId", "")),
-		BodyPartId(json.value("BodyPartId", 0)),
-		TotalDamage(json.value("TotalDamage", 0))
-	{ }
+	int BodyPartId = 0;
+	int TotalDamage = 0;
+
+};
+
+template<>
+struct EventValueFields<DamageHistoryEventValue> : EventFieldBuilder<DamageHistoryEventValue> {
+	static constexpr auto Fields = std::array{
+		field<&Type::Explosive>("Explosive"),
+		field<&Type::Headshot>("Headshot"),
+		field<&Type::Accident>("Accident"),
+		field<&Type::WeaponSilenced>("WeaponSilenced"),
+		field<&Type::Projectile>("Projectile"),
+		field<&Type::Sniper>("Sniper"),
+		field<&Type::ThroughWall>("ThroughWall"),
+		field<&Type::InstanceId>("InstanceId"),
+		field<&Type::RepositoryId>("RepositoryId"),
+		field<&Type::BodyPartId>("BodyPartId"),
+		field<&Type::TotalDamage>("TotalDamage"),
+	};
 };
 
 struct PacifyEventValue {
-	std::string RepositoryId;
-	uint32_t ActorId;
+	RepoId RepositoryId;
+	uint32_t ActorId = 0;
 	std::string ActorName;
-	EActorType ActorType;
-	EKillType KillType;
-	EDeathContext KillContext;
-	std::string KillClass;
-	bool Accident;
-	bool WeaponSilenced;
-	bool Explosive;
-	int ExplosionType;
-	bool Projectile;
-	bool Sniper;
-	bool IsHeadshot;
-	bool IsTarget;
-	bool ThroughWall;
-	int BodyPartId;
-	double TotalDamage;
-	bool IsMoving;
-	int RoomId;
+	EActorType ActorType = EActorType::eAT_Civilian;
+	EKillType KillType = EKillType::EKillType_Undefined;
+	EDeathContext KillContext = EDeathContext::eDC_UNDEFINED;
+	::KillClass KillClass = ::KillClass::Other;
+	bool Accident = false;
+	bool WeaponSilenced = false;
+	bool Explosive = false;
+	int ExplosionType = 0;
+	bool Projectile = false;
+	bool Sniper = false;
+	bool IsHeadshot = false;
+	bool IsTarget = false;
+	bool ThroughWall = false;
+	int BodyPartId = -1;
+	double TotalDamage = 0;
+	bool IsMoving = false;
+	int RoomId = -1;
 	std::string ActorPosition;
 	std::string HeroPosition;
 	std::vector<std::string> DamageEvents;
-	int PlayerId;
+	int PlayerId = -1;
 	std::string OutfitRepositoryId;
-	bool OutfitIsHitmanSuit;
-	std::string KillMethodBroad;
-	std::string KillMethodStrict;
-	int EvergreenRarity;
+	bool OutfitIsHitmanSuit = false;
+	::KillMethodBroad KillMethodBroad = ::KillMethodBroad::Other;
+	::KillMethodStrict KillMethodStrict = ::KillMethodStrict::None;
+	int EvergreenRarity = -1;
 	std::vector<DamageHistoryEventValue> History;
 
-	PacifyEventValue(const nlohmann::json& json) :
-		RepositoryId(json.value("RepositoryId", "")),
-		ActorId(json.value("ActorId", 0)),
-		ActorName(json.value("ActorName", "")),
-		ActorType(getActorTypeFromValue(json.value("ActorType", 0))),
-		KillType(getKillTypeFromValue(json.value("KillType", 0))),
-		KillContext(getDeathContextFromValue(json.value("KillContext", 0))),
-		KillClass(json.value("KillClass", "")),
-		Accident(json.value("Accident", false)),
-		WeaponSilenced(json.value("WeaponSilenced", false)),
-		Explosive(json.value("Explosive", false)),
-		ExplosionType(json.value("ExplosionType", 0)),
-		Projectile(json.value("Projectile", false)),
-		Sniper(json.value("Sniper", false)),
-		IsHeadshot(json.value("IsHeadshot", false)),
-		IsTarget(json.value("IsTarget", false)),
-		ThroughWall(json.value("ThroughWall", false)),
-		BodyPartId(json.value("BodyPartId", -1)),
-		TotalDamage(json.value("TotalDamage", 0)),
-		IsMoving(json.value("IsMoving", false)),
-		RoomId(json.value("RoomId", -1)),
-		ActorPosition(json.value("ActorPosition", "")),
-		HeroPosition(json.value("HeroPosition", "")),
-		DamageEvents(json["DamageEvents"].get<std::vector<std::string>>()),
-		PlayerId(json.value("PlayerId", -1)),
-		OutfitRepositoryId(json.value("OutfitRepositoryId", "")),
-		OutfitIsHitmanSuit(json.value("OutfitIsHitmanSuit", false)),
-		KillMethodBroad(json.value("KillMethodBroad", "")),
-		KillMethodStrict(json.value("KillMethodStrict", "")),
-		EvergreenRarity(json.value("EvergreenRarity", -1))
-	{
-		auto& history = json["History"];
-		if (history.is_array()) {
-			for (auto& historyIt : history)
-				this->History.emplace_back(historyIt);
-		}
-	}
+};
+
+template<>
+struct EventValueFields<PacifyEventValue> : EventFieldBuilder<PacifyEventValue> {
+	static constexpr auto Fields = std::array{
+		field<&Type::RepositoryId>("RepositoryId"),
+		field<&Type::ActorId>("ActorId"),
+		field<&Type::ActorName>("ActorName"),
+		field<&Type::ActorType, getActorTypeFromValue>("ActorType"),
+		field<&Type::KillType, getKillTypeFromValue>("KillType"),
+		field<&Type::KillContext, getDeathContextFromValue>("KillContext"),
+		field<&Type::KillClass, getKillClassFromString>("KillClass"),
+		field<&Type::Accident>("Accident"),
+		field<&Type::WeaponSilenced>("WeaponSilenced"),
+		field<&Type::Explosive>("Explosive"),
+		field<&Type::ExplosionType>("ExplosionType"),
+		field<&Type::Projectile>("Projectile"),
+		field<&Type::Sniper>("Sniper"),
+		field<&Type::IsHeadshot>("IsHeadshot"),
+		field<&Type::IsTarget>("IsTarget"),
+		field<&Type::ThroughWall>("ThroughWall"),
+		field<&Type::BodyPartId>("BodyPartId"),
+		field<&Type::TotalDamage>("TotalDamage"),
+		field<&Type::IsMoving>("IsMoving"),
+		field<&Type::RoomId>("RoomId"),
+		field<&Type::ActorPosition>("ActorPosition"),
+		field<&Type::HeroPosition>("HeroPosition"),
+		field<&Type::DamageEvents>("DamageEvents"),
+		field<&Type::PlayerId>("PlayerId"),
+		field<&Type::OutfitRepositoryId>("OutfitRepositoryId"),
+		field<&Type::OutfitIsHitmanSuit>("OutfitIsHitmanSuit"),
+		field<&Type::KillMethodBroad, getKillMethodBroadFromString>("KillMethodBroad"),
+		field<&Type::KillMethodStrict, getKillMethodStrictFromString>("KillMethodStrict"),
+		field<&Type::EvergreenRarity>("EvergreenRarity"),
+		field<&Type::History>("History"),
+	};
 };
 
 struct KillEventValue : PacifyEventValue {
@@ -135,83 +151,141 @@ struct KillEventValue : PacifyEventValue {
 	std::string KillItemCategory;
 };
 
+template<>
+struct EventValueFields<KillEventValue> : EventValueFields<PacifyEventValue> { };
+
 struct VoidEventValue {
-	VoidEventValue(const nlohmann::json& json) {}
+};
+
+template<>
+struct EventValueFields<VoidEventValue> : EventFieldBuilder<VoidEventValue> {
+	static constexpr auto Fields = std::array<EventField, 0>{};
 };
 
 struct StringEventValue {
 	std::string value;
 
-	StringEventValue(const nlohmann::json& json) : value(json.get<std::string>())
-	{ }
+};
+
+template<>
+struct EventValueFields<StringEventValue> : EventFieldBuilder<StringEventValue> {
+	static constexpr auto Fields = std::array{
+		field<&Type::value>(""),
+	};
 };
 
 struct StringArrayEventValue {
 	std::vector<std::string> value;
 
-	StringArrayEventValue(const nlohmann::json& json) {
-		if (!json.is_array()) return;
-		for (auto& v : json) {
-			this->value.emplace_back(v.get<std::string>());
-		}
-	}
+};
+
+template<>
+struct EventValueFields<StringArrayEventValue> : EventFieldBuilder<StringArrayEventValue> {
+	static constexpr auto Fields = std::array{
+		field<&Type::value>(""),
+	};
+};
+
+struct RepoIdEventValue {
+	RepoId value;
+
+};
+
+template<>
+struct EventValueFields<RepoIdEventValue> : EventFieldBuilder<RepoIdEventValue> {
+	static constexpr auto Fields = std::array{
+		field<&Type::value>(""),
+	};
+};
+
+struct RepoIdArrayEventValue {
+	std::vector<RepoId> value;
+
+};
+
+template<>
+struct EventValueFields<RepoIdArrayEventValue> : EventFieldBuilder<RepoIdArrayEventValue> {
+	static constexpr auto Fields = std::array{
+		field<&Type::value>(""),
+	};
 };
 
 struct TakedownCleannessEventValue {
-	std::string RepositoryId;
-	bool IsTarget;
+	RepoId RepositoryId;
+	bool IsTarget = false;
 
-	TakedownCleannessEventValue(const nlohmann::json& json) :
-		RepositoryId(json.value("RepositoryId", "")),
-		IsTarget(json.value("IsTarget", false))
-	{ }
+};
+
+template<>
+struct EventValueFields<TakedownCleannessEventValue> : EventFieldBuilder<TakedownCleannessEventValue> {
+	static constexpr auto Fields = std::array{
+		field<&Type::RepositoryId>("RepositoryId"),
+		field<&Type::IsTarget>("IsTarget"),
+	};
 };
 
 struct ActorIdentityEventValue {
-	unsigned ActorId;
+	unsigned ActorId = 0;
 	std::string RepositoryId;
 	std::string ActorName;
 
-	ActorIdentityEventValue(const nlohmann::json& json) :
-		ActorId(json.value("ActorId", 0)),
-		RepositoryId(json.value("RepositoryId", "")),
-		ActorName(json.value("ActorName", ""))
-	{ }
+};
+
+template<>
+struct EventValueFields<ActorIdentityEventValue> : EventFieldBuilder<ActorIdentityEventValue> {
+	static constexpr auto Fields = std::array{
+		field<&Type::ActorId>("ActorId"),
+		field<&Type::RepositoryId>("RepositoryId"),
+		field<&Type::ActorName>("ActorName"),
+	};
 };
 
 struct BodyEventValue {
-	std::string RepositoryId;
-	bool IsCrowdActor;
+	RepoId RepositoryId;
+	bool IsCrowdActor = false;
 
-	BodyEventValue(const nlohmann::json& json) :
-		RepositoryId(json.value("RepositoryId", "")),
-		IsCrowdActor(json.value("IsCrowdActor", false))
-	{ }
+};
+
+template<>
+struct EventValueFields<BodyEventValue> : EventFieldBuilder<BodyEventValue> {
+	static constexpr auto Fields = std::array{
+		field<&Type::RepositoryId>("RepositoryId"),
+		field<&Type::IsCrowdActor>("IsCrowdActor"),
+	};
 };
 
 struct BodyKillInfoEventValue : BodyEventValue {
-	EDeathContext DeathContext;
-	EDeathType DeathType;
+	EDeathContext DeathContext = EDeathContext::eDC_UNDEFINED;
+	EDeathType DeathType = EDeathType::eDT_UNDEFINED;
 
-	BodyKillInfoEventValue(const nlohmann::json& json) :
-		BodyEventValue(json),
-		DeathContext(getDeathContextFromValue(json.value("DeathContext", 0))),
-		DeathType(getDeathTypeFromValue(json.value("DeathType", 0)))
-	{ }
+};
+
+template<>
+struct EventValueFields<BodyKillInfoEventValue> : EventFieldBuilder<BodyKillInfoEventValue> {
+	static constexpr auto Fields = std::array{
+		field<&Type::RepositoryId>("RepositoryId"),
+		field<&Type::IsCrowdActor>("IsCrowdActor"),
+		field<&Type::DeathContext, getDeathContextFromValue>("DeathContext"),
+		field<&Type::DeathType, getDeathTypeFromValue>("DeathType"),
+	};
 };
 
 struct ItemEventValue {
-	std::string RepositoryId;
+	RepoId RepositoryId;
 	std::string ItemType;
 	std::string ItemName;
 	//std::vector<std::string> OnlineTraits;
 	//std::string ActionRewardType;
 
-	ItemEventValue(const nlohmann::json& json) {
-		ItemName = json.value("ItemName", "");
-		ItemType = json.value("ItemType", "");
-		RepositoryId = json.value("RepositoryId", "");
-	}
+};
+
+template<>
+struct EventValueFields<ItemEventValue> : EventFieldBuilder<ItemEventValue> {
+	static constexpr auto Fields = std::array{
+		field<&Type::RepositoryId>("RepositoryId"),
+		field<&Type::ItemType>("ItemType"),
+		field<&Type::ItemName>("ItemName"),
+	};
 };
 
 template<>
@@ -222,36 +296,33 @@ struct Event<Events::ContractStart> {
 		std::vector<LoadoutItemEventValue> Loadout;
 		std::string Disguise;
 		std::string LocationId;
-		MissionType ContractType;
+		MissionType ContractType = MissionType::Unknown;
 		std::vector<GameChanger> GameChangers;
-		int DifficultyLevel;
-		bool IsVR;
-		bool IsHitmanSuit;
+		int DifficultyLevel = -1;
+		bool IsVR = false;
+		bool IsHitmanSuit = false;
 		std::string SelectedCharacterId;
-		int EvergreenSeed;
-		int EvergreenDifficulty;
-
-		EventValue(const nlohmann::json& value) {
-			auto& loadout = value["Loadout"];
-			for (auto const& ld : loadout)
-			{
-				LoadoutItemEventValue loadoutItem;
-				loadoutItem.RepositoryId = ld.value("RepositoryId", "");
-				loadoutItem.InstanceId = ld.value("RepositoryId", "");
-				loadoutItem.OnlineTraits = ld["OnlineTraits"].get<std::vector<std::string>>();
-				loadoutItem.Category = nullptr;
-				Loadout.emplace_back(loadoutItem);
-			}
-			Disguise = value.value("Disguise", "");
-			LocationId = value.value("LocationId", "");
-			ContractType = getMissionTypeFromString(value.value("ContractType", "")).value_or(MissionType::Unknown);
-			DifficultyLevel = value.value<int>("DifficultyLevel", -1);
-			IsVR = value.value<bool>("IsVR", false);
-			IsHitmanSuit = value.value<bool>("IsHitmanSuit", false);
-			SelectedCharacterId = value.value("SelectedCharacterId", "");
-			EvergreenSeed = value.value("EvergreenSeed", 0);
-			EvergreenDifficulty = value.value("EvergreenDifficulty", 0);
-		}
+		int EvergreenSeed = 0;
+		int EvergreenDifficulty = 0;
+
+	};
+};
+
+template<>
+struct EventValueFields<Event<Events::ContractStart>::EventValue> : EventFieldBuilder<Event<Events::ContractStart>::EventValue> {
+	static constexpr auto Fields = std::array{
+		field<&Type::Loadout>("Loadout"),
+		field<&Type::Disguise>("Disguise"),
+		field<&Type::LocationId>("LocationId"),
+		field<&Type::ContractType, [](std::string_view str) {
+			return getMissionTypeFromString(std::string(str)).value_or(MissionType::Unknown);
+		}>("ContractType"),
+		field<&Type::DifficultyLevel>("DifficultyLevel"),
+		field<&Type::IsVR>("IsVR"),
+		field<&Type::IsHitmanSuit>("IsHitmanSuit"),
+		field<&Type::SelectedCharacterId>("SelectedCharacterId"),
+		field<&Type::EvergreenSeed>("EvergreenSeed"),
+		field<&Type::EvergreenDifficulty>("EvergreenDifficulty"),
 	};
 };
 
@@ -286,15 +357,21 @@ struct Event<Events::setpieces> {
 		std::string Item_triggered_metricvalue;
 		SVector3 Position;
 
-		EventValue(const nlohmann::json& json) :
-			RepositoryId(json.value("RepositoryId", "")),
-			name_metricvalue(json.value("name_metricvalue", "")),
-			setpieceHelper_metricvalue(json.value("setpieceHelper_metricvalue", "")),
-			setpieceType_metricvalue(json.value("setpieceType_metricvalue", "")),
-			toolUsed_metricvalue(json.value("toolUsed_metricvalue", "")),
-			Item_triggered_metricvalue(json.value("Item_triggered_metricvalue", "")),
-			Position(json.value("x", 0.0), json.value("y", 0.0), json.value("z", 0.0))
-		{ }
+	};
+};
+
+template<>
+struct EventValueFields<Event<Events::setpieces>::EventValue> : EventFieldBuilder<Event<Events::setpieces>::EventValue> {
+	static constexpr auto Fields = std::array{
+		field<&Type::RepositoryId>("RepositoryId"),
+		field<&Type::name_metricvalue>("name_metricvalue"),
+		field<&Type::setpieceHelper_metricvalue>("setpieceHelper_metricvalue"),
+		field<&Type::setpieceType_metricvalue>("setpieceType_metricvalue"),
+		field<&Type::toolUsed_metricvalue>("toolUsed_metricvalue"),
+		field<&Type::Item_triggered_metricvalue>("Item_triggered_metricvalue"),
+		field<&Type::Position, [](SVector3& pos, double v) { pos.x = static_cast<float>(v); }>("x"),
+		field<&Type::Position, [](SVector3& pos, double v) { pos.y = static_cast<float>(v); }>("y"),
+		field<&Type::Position, [](SVector3& pos, double v) { pos.z = static_cast<float>(v); }>("z"),
 	};
 };
 
@@ -302,18 +379,22 @@ template<>
 struct Event<Events::AddSyndicateTarget> {
 	static auto constexpr Name = "AddSyndicateTarget";
 	struct EventValue {
-		std::string repoID;
+		RepoId repoID;
 
-		EventValue(const nlohmann::json& json) {
-			repoID = json.value("repoID", "");
-		}
+	};
+};
+
+template<>
+struct EventValueFields<Event<Events::AddSyndicateTarget>::EventValue> : EventFieldBuilder<Event<Events::AddSyndicateTarget>::EventValue> {
+	static constexpr auto Fields = std::array{
+		field<&Type::repoID>("repoID"),
 	};
 };
 
 template<>
 struct Event<Events::StartingSuit> {
 	static auto constexpr Name = "StartingSuit";
-	using EventValue = StringEventValue;
+	using EventValue = RepoIdEventValue;
 };
 
 template<>
@@ -343,7 +424,7 @@ struct Event<Events::ItemThrown> {
 template<>
 struct Event<Events::Disguise> {
 	static auto constexpr Name = "Disguise";
-	using EventValue = StringEventValue;
+	using EventValue = RepoIdEventValue;
 };
 
 template<>
@@ -357,24 +438,30 @@ struct Event<Events::Actorsick> {
 	static auto constexpr Name = "Actorsick";
 	struct EventValue {
 		SVector3 ActorPosition;
-		unsigned ActorId;
+		unsigned ActorId = 0;
 		std::string ActorName;
 		std::string actor_R_ID;
-		bool IsTarget;
+		bool IsTarget = false;
 		std::string item_R_ID;
 		std::string setpiece_R_ID;
-		EActorType ActorType;
+		EActorType ActorType = EActorType::eAT_Last;
+
+	};
+};
 
-		EventValue(const nlohmann::json& json) :
-			ActorPosition(json.value("x", 0.0), json.value("y", 0.0), json.value("z", 0.0)),
-			ActorId(json.value("ActorId", 0)),
-			ActorName(json.value("ActorName", "")),
-			actor_R_ID(json.value("actor_R_ID", "")),
-			IsTarget(json.value("IsTarget", false)),
-			item_R_ID(json.value("item_R_ID", "")),
-			setpiece_R_ID(json.value("setpiece_R_ID", "")),
-			ActorType(getActorTypeFromValue(json.value("ActorType", -1)))
-		{ }
+template<>
+struct EventValueFields<Event<Events::Actorsick>::EventValue> : EventFieldBuilder<Event<Events::Actorsick>::EventValue> {
+	static constexpr auto Fields = std::array{
+		field<&Type::ActorPosition, [](SVector3& pos, double v) { pos.x = static_cast<float>(v); }>("x"),
+		field<&Type::ActorPosition, [](SVector3& pos, double v) { pos.y = static_cast<float>(v); }>("y"),
+		field<&Type::ActorPosition, [](SVector3& pos, double v) { pos.z = static_cast<float>(v); }>("z"),
+		field<&Type::ActorId>("ActorId"),
+		field<&Type::ActorName>("ActorName"),
+		field<&Type::actor_R_ID>("actor_R_ID"),
+		field<&Type::IsTarget>("IsTarget"),
+		field<&Type::item_R_ID>("item_R_ID"),
+		field<&Type::setpiece_R_ID>("setpiece_R_ID"),
+		field<&Type::ActorType, getActorTypeFromValue>("ActorType"),
 	};
 };
 
@@ -383,20 +470,24 @@ struct Event<Events::Dart_Hit> {
 	static auto constexpr Name = "Dart_Hit";
 	struct EventValue {
 		std::string RepositoryId;
-		EActorType ActorType;
-		bool IsTarget;
-		bool Blind;
-		bool Sedative;
-		bool Sick;
+		EActorType ActorType = EActorType::eAT_Last;
+		bool IsTarget = false;
+		bool Blind = false;
+		bool Sedative = false;
+		bool Sick = false;
 
-		EventValue(const nlohmann::json& json) :
-			RepositoryId(json.value("RepositoryId", "")),
-			ActorType(getActorTypeFromValue(json.value("ActorType", -1))),
-			IsTarget(json.value("IsTarget", false)),
-			Blind(json.find("Blind") != json.end()),
-			Sedative(json.find("Sedative") != json.end()),
-			Sick(json.find("Sick") != json.end())
-		{ }
+	};
+};
+
+template<>
+struct EventValueFields<Event<Events::Dart_Hit>::EventValue> : EventFieldBuilder<Event<Events::Dart_Hit>::EventValue> {
+	static constexpr auto Fields = std::array{
+		field<&Type::RepositoryId>("RepositoryId"),
+		field<&Type::ActorType, getActorTypeFromValue>("ActorType"),
+		field<&Type::IsTarget>("IsTarget"),
+		presence<&Type::Blind>("Blind"),
+		presence<&Type::Sedative>("Sedative"),
+		presence<&Type::Sick>("Sick"),
 	};
 };
 
@@ -404,13 +495,17 @@ template<>
 struct Event<Events::Trespassing> {
 	static auto constexpr Name = "Trespassing";
 	struct EventValue {
-		bool IsTrespassing;
-		int RoomId;
+		bool IsTrespassing = false;
+		int RoomId = -1;
 
-		EventValue(const nlohmann::json& json) :
-			IsTrespassing(json.value("IsTrespassing", false)),
-			RoomId(json.value("RoomId", -1))
-		{ }
+	};
+};
+
+template<>
+struct EventValueFields<Event<Events::Trespassing>::EventValue> : EventFieldBuilder<Event<Events::Trespassing>::EventValue> {
+	static constexpr auto Fields = std::array{
+		field<&Type::IsTrespassing>("IsTrespassing"),
+		field<&Type::RoomId>("RoomId"),
 	};
 };
 
@@ -418,15 +513,19 @@ template<>
 struct Event<Events::SecuritySystemRecorder> {
 	static auto constexpr Name = "SecuritySystemRecorder";
 	struct EventValue {
-		SecuritySystemRecorderEvent event;
-		unsigned camera;
-		unsigned recorder;
+		SecuritySystemRecorderEvent event = SecuritySystemRecorderEvent::Undefined;
+		unsigned camera = 0;
+		unsigned recorder = 0;
 
-		EventValue(const nlohmann::json& json) :
-			event(getSecuritySystemRecorderEventFromString(json.value("event", ""))),
-			camera(json.value("camera", 0)),
-			recorder(json.value("recorder", 0))
-		{ }
+	};
+};
+
+template<>
+struct EventValueFields<Event<Events::SecuritySystemRecorder>::EventValue> : EventFieldBuilder<Event<Events::SecuritySystemRecorder>::EventValue> {
+	static constexpr auto Fields = std::array{
+		field<&Type::event, getSecuritySystemRecorderEventFromString>("event"),
+		field<&Type::camera>("camera"),
+		field<&Type::recorder>("recorder"),
 	};
 };
 
@@ -454,8 +553,13 @@ struct Event<Events::AccidentBodyFound> {
 	struct EventValue {
 		BodyKillInfoEventValue DeadBody;
 
-		EventValue(const nlohmann::json& json) : DeadBody(json["DeadBody"])
-		{}
+	};
+};
+
+template<>
+struct EventValueFields<Event<Events::AccidentBodyFound>::EventValue> : EventFieldBuilder<Event<Events::AccidentBodyFound>::EventValue> {
+	static constexpr auto Fields = std::array{
+		field<&Type::DeadBody>("DeadBody"),
 	};
 };
 
@@ -465,8 +569,13 @@ struct Event<Events::BodyFound> {
 	struct EventValue {
 		BodyKillInfoEventValue DeadBody;
 
-		EventValue(const nlohmann::json& json) : DeadBody(json["DeadBody"])
-		{}
+	};
+};
+
+template<>
+struct EventValueFields<Event<Events::BodyFound>::EventValue> : EventFieldBuilder<Event<Events::BodyFound>::EventValue> {
+	static constexpr auto Fields = std::array{
+		field<&Type::DeadBody>("DeadBody"),
 	};
 };
 
@@ -481,13 +590,18 @@ struct Event<Events::MurderedBodySeen> {
 	static auto constexpr Name = "MurderedBodySeen";
 	struct EventValue {
 		BodyEventValue DeadBody;
-		std::string Witness;
-		bool IsWitnessTarget;
+		RepoId Witness;
+		bool IsWitnessTarget = false;
+
+	};
+};
 
-		EventValue(const nlohmann::json& json) : DeadBody(json["DeadBody"]),
-			Witness(json.value("Witness", "")),
-			IsWitnessTarget(json.value("IsWitnessTarget", false))
-		{}
+template<>
+struct EventValueFields<Event<Events::MurderedBodySeen>::EventValue> : EventFieldBuilder<Event<Events::MurderedBodySeen>::EventValue> {
+	static constexpr auto Fields = std::array{
+		field<&Type::DeadBody>("DeadBody"),
+		field<&Type::Witness>("Witness"),
+		field<&Type::IsWitnessTarget>("IsWitnessTarget"),
 	};
 };
 
@@ -555,12 +669,17 @@ template<>
 struct Event<Events::ShotsFired> {
 	static auto constexpr Name = "ShotsFired";
 	struct EventValue {
-		int Split;
-		int Total;
+		int Split = 0;
+		int Total = 0;
+
+	};
+};
 
-		EventValue(const nlohmann::json& json) : Split(json["Split"].value("", 0)),
-			Total(json.value("Total", 0))
-		{}
+template<>
+struct EventValueFields<Event<Events::ShotsFired>::EventValue> : EventFieldBuilder<Event<Events::ShotsFired>::EventValue> {
+	static constexpr auto Fields = std::array{
+		field<&Type::Split>("Split"),
+		field<&Type::Total>("Total"),
 	};
 };
 
@@ -591,42 +710,44 @@ struct Event<Events::_47_FoundTrespassing> {
 template<>
 struct Event<Events::Spotted> {
 	static auto constexpr Name = "Spotted";
-	using EventValue = StringArrayEventValue;
+	using EventValue = RepoIdListChange;
 };
 
 template<>
 struct Event<Events::Witnesses> {
 	static auto constexpr Name = "Witnesses";
-	using EventValue = StringArrayEventValue;
+	using EventValue = RepoIdListChange;
 };
 
 template<>
 struct Event<Events::DisguiseBlown> {
 	static auto constexpr Name = "DisguiseBlown";
-	using EventValue = StringEventValue;
+	using EventValue = RepoIdEventValue;
 };
 
 template<>
 struct Event<Events::BrokenDisguiseCleared> {
 	static auto constexpr Name = "BrokenDisguiseCleared";
-	using EventValue = StringEventValue;
+	using EventValue = RepoIdEventValue;
 };
 
 template<>
 struct Event<Events::AmbientChanged> {
 	static auto constexpr Name = "AmbientChanged";
 	struct EventValue {
-		EGameTension PreviousAmbientValue;
-		EGameTension AmbientValue;
+		EGameTension PreviousAmbientValue = EGameTension::EGT_Undefined;
+		EGameTension AmbientValue = EGameTension::EGT_Undefined;
 		//std::string PreviousAmbient;
 		//std::string Ambient;
 
-		EventValue(const nlohmann::json& json) :
-			PreviousAmbientValue(getGameTensionFromValue(json.value("PreviousAmbientValue", 0))),
-			AmbientValue(getGameTensionFromValue(json.value("PreviousAmbientValue", 0)))
-			//PreviousAmbient(json.value("PreviousAmbient", "")),
-			//Ambient(json.value("Ambient", "")),
-		{}
+	};
+};
+
+template<>
+struct EventValueFields<Event<Events::AmbientChanged>::EventValue> : EventFieldBuilder<Event<Events::AmbientChanged>::EventValue> {
+	static constexpr auto Fields = std::array{
+		field<&Type::PreviousAmbientValue, getGameTensionFromValue>("PreviousAmbientValue"),
+		field<&Type::AmbientValue, getGameTensionFromValue>("AmbientValue"),
 	};
 };
 
@@ -634,11 +755,15 @@ template<>
 struct Event<Events::HoldingIllegalWeapon> {
 	static auto constexpr Name = "HoldingIllegalWeapon";
 	struct EventValue {
-		bool IsHoldingIllegalWeapon;
+		bool IsHoldingIllegalWeapon = false;
 
-		EventValue(const nlohmann::json& json) :
-			IsHoldingIllegalWeapon(json.value("IsHoldingIllegalWeapon", false))
-		{}
+	};
+};
+
+template<>
+struct EventValueFields<Event<Events::HoldingIllegalWeapon>::EventValue> : EventFieldBuilder<Event<Events::HoldingIllegalWeapon>::EventValue> {
+	static constexpr auto Fields = std::array{
+		field<&Type::IsHoldingIllegalWeapon>("IsHoldingIllegalWeapon"),
 	};
 };
 
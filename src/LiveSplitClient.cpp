@@ -8,7 +8,7 @@
 #include <Logging.h>
 #include "Config.h"
 #include "LiveSplitClient.h"
-#include "util.h"
+#include "Profiler.h"
 
 #pragma comment(lib, "Ws2_32.lib")
 
@@ -167,6 +167,7 @@ LiveSplitClient::~LiveSplitClient() {
 }
 
 auto LiveSplitClient::writeMessage(const ClientMessage& msg) -> bool {
+	auto const profile = ProfileScope(ProfileSection::LiveSplitSend);
 	auto data = msg.toString() + "\n";
 	DWORD written = 0;
 	int bytes_sent = ::send(this->sock, data.c_str(), data.size(), 0);
@@ -0,0 +1,52 @@
+#pragma once
+#ifdef STEALTHOMETER_HEADLESS
+#include <cstdio>
+#include <format>
+#include <string>
+#include <utility>
+
+// Minimal stand-in for the SDK logger in headless builds, writing to stderr.
+namespace Logger
+{
+	enum class Level
+	{
+		Debug,
+		Info,
+		Warning,
+		Error,
+		None,
+	};
+
+	// Messages below this level are dropped before formatting.
+	inline auto level = Level::Error;
+
+	template<typename... Args>
+	inline auto Log(Level msgLevel, std::format_string<Args...> fmt, Args&&... args) -> void {
+		if (msgLevel < level) return;
+		auto const message = std::format(fmt, std::forward<Args>(args)...);
+		std::fprintf(stderr, "%s\n", message.c_str());
+	}
+
+	template<typename... Args>
+	inline auto Debug(std::format_string<Args...> fmt, Args&&... args) -> void {
+		Log(Level::Debug, fmt, std::forward<Args>(args)...);
+	}
+
+	template<typename... Args>
+	inline auto Info(std::format_string<Args...> fmt, Args&&... args) -> void {
+		Log(Level::Info, fmt, std::forward<Args>(args)...);
+	}
+
+	template<typename... Args>
+	inline auto Warn(std::format_string<Args...> fmt, Args&&... args) -> void {
+		Log(Level::Warning, fmt, std::forward<Args>(args)...);
+	}
+
+	template<typename... Args>
+	inline auto Error(std::format_string<Args...> fmt, Args&&... args) -> void {
+		Log(Level::Error, fmt, std::forward<Args>(args)...);
+	}
+}
+#else
+#include <Logging.h>
+#endif
@@ -0,0 +1,157 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Heap accounting for the mod's long-lived containers. Each container tagged with a subsystem allocates through
+// CountingAllocator, which keeps live bytes, peak bytes and allocation counts for that subsystem in relaxed atomics.
+// That's cheap enough to leave on in release builds, and safe to read from the UI thread while the event worker runs.
+enum class MemorySubsystem : uint8_t
+{
+	Stats,
+	WitnessEvents,
+	EventHistory,
+	EventLists,
+	Targets,
+	Count,
+};
+
+struct MemoryUsage
+{
+	int64_t liveBytes = 0;
+	int64_t peakBytes = 0;
+	uint64_t allocations = 0;
+	uint64_t deallocations = 0;
+};
+
+class MemoryCounters
+{
+public:
+	auto allocated(size_t bytes) -> void {
+		auto const live = this->liveBytes.fetch_add(static_cast<int64_t>(bytes), std::memory_order_relaxed) + static_cast<int64_t>(bytes);
+		this->allocations.fetch_add(1, std::memory_order_relaxed);
+
+		auto peak = this->peakBytes.load(std::memory_order_relaxed);
+		while (live > peak && !this->peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed));
+	}
+
+	auto deallocated(size_t bytes) -> void {
+		this->liveBytes.fetch_sub(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+		this->deallocations.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	// Memory given back in bulk, by releasing an arena, rather than by individual frees.
+	auto released(size_t bytes) -> void {
+		this->liveBytes.fetch_sub(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+	}
+
+	auto getUsage() const -> MemoryUsage {
+		return MemoryUsage{
+			.liveBytes = this->liveBytes.load(std::memory_order_relaxed),
+			.peakBytes = this->peakBytes.load(std::memory_order_relaxed),
+			.allocations = this->allocations.load(std::memory_order_relaxed),
+			.deallocations = this->deallocations.load(std::memory_order_relaxed),
+		};
+	}
+
+private:
+	std::atomic<int64_t> liveBytes = 0;
+	std::atomic<int64_t> peakBytes = 0;
+	std::atomic<uint64_t> allocations = 0;
+	std::atomic<uint64_t> deallocations = 0;
+};
+
+namespace Memory
+{
+	inline std::array<MemoryCounters, static_cast<size_t>(MemorySubsystem::Count)> counters;
+
+	inline auto getCounters(MemorySubsystem subsystem) -> MemoryCounters& {
+		return counters[static_cast<size_t>(subsystem)];
+	}
+
+	inline auto getUsage(MemorySubsystem subsystem) -> MemoryUsage {
+		return getCounters(subsystem).getUsage();
+	}
+
+	inline auto getSubsystemName(MemorySubsystem subsystem) -> const char* {
+		switch (subsystem) {
+			case MemorySubsystem::Stats: return "stats";
+			case MemorySubsystem::WitnessEvents: return "witness events";
+			case MemorySubsystem::EventHistory: return "event history";
+			case MemorySubsystem::EventLists: return "event lists";
+			case MemorySubsystem::Targets: return "targets";
+			case MemorySubsystem::Count: break;
+		}
+		return "?";
+	}
+
+	// Calls func(subsystem, usage) for each subsystem, for reporting.
+	template<typename TFunc>
+	auto forEachSubsystem(TFunc&& func) -> void {
+		for (size_t i = 0; i < static_cast<size_t>(MemorySubsystem::Count); ++i) {
+			auto const subsystem = static_cast<MemorySubsystem>(i);
+			func(subsystem, getUsage(subsystem));
+		}
+	}
+}
+
+// Stateless, so containers using it still default construct, swap and move like their std::allocator counterparts.
+template<typename T, MemorySubsystem Subsystem>
+struct CountingAllocator
+{
+	using value_type = T;
+
+	template<typename U>
+	struct rebind
+	{
+		using other = CountingAllocator<U, Subsystem>;
+	};
+
+	CountingAllocator() = default;
+
+	template<typename U>
+	CountingAllocator(const CountingAllocator<U, Subsystem>&) noexcept {}
+
+	auto allocate(size_t n) -> T* {
+		auto const ptr = std::allocator<T>().allocate(n);
+		Memory::getCounters(Subsystem).allocated(n * sizeof(T));
+		return ptr;
+	}
+
+	auto deallocate(T* ptr, size_t n) noexcept -> void {
+		Memory::getCounters(Subsystem).deallocated(n * sizeof(T));
+		std::allocator<T>().deallocate(ptr, n);
+	}
+
+	template<typename U>
+	friend auto operator==(const CountingAllocator&, const CountingAllocator<U, Subsystem>&) -> bool {
+		return true;
+	}
+};
+
+template<typename T, MemorySubsystem Subsystem = MemorySubsystem::Stats>
+using CountedVector = std::vector<T, CountingAllocator<T, Subsystem>>;
+
+template<typename T, MemorySubsystem Subsystem = MemorySubsystem::Stats>
+using CountedSet = std::set<T, std::less<T>, CountingAllocator<T, Subsystem>>;
+
+template<typename K, typename V, MemorySubsystem Subsystem = MemorySubsystem::Stats>
+using CountedMap = std::map<K, V, std::less<K>, CountingAllocator<std::pair<const K, V>, Subsystem>>;
+
+template<typename T, MemorySubsystem Subsystem = MemorySubsystem::Stats>
+using CountedUnorderedSet = std::unordered_set<T, std::hash<T>, std::equal_to<T>, CountingAllocator<T, Subsystem>>;
+
+template<typename K, typename V, MemorySubsystem Subsystem = MemorySubsystem::Stats>
+using CountedUnorderedMap = std::unordered_map<K, V, std::hash<K>, std::equal_to<K>, CountingAllocator<std::pair<const K, V>, Subsystem>>;
+
+template<MemorySubsystem Subsystem>
+using CountedString = std::basic_string<char, std::char_traits<char>, CountingAllocator<char, Subsystem>>;
@@ -0,0 +1,130 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include "ContractArena.h"
+#include "Memory.h"
+#include "RepoId.h"
+
+// Set of NPCs by their dense index within the contract (see NPCIndex), as a bitset. Membership tests and updates are
+// a bit operation, and questions spanning several sets ("witnesses that aren't dead or targets") are answered a word
+// of 64 NPCs at a time by anyExcept/countExcept rather than by probing one set per member of another.
+class NPCSet
+{
+public:
+	auto insert(uint32_t npc) -> bool {
+		auto const word = npc / 64;
+		auto const bit = uint64_t(1) << (npc % 64);
+		if (word >= this->words.size()) this->words.resize(std::max<size_t>(word + 1, this->words.size() * 2));
+		if (this->words[word] & bit) return false;
+		this->words[word] |= bit;
+		++this->count;
+		return true;
+	}
+
+	auto erase(uint32_t npc) -> bool {
+		if (!this->contains(npc)) return false;
+		this->words[npc / 64] &= ~(uint64_t(1) << (npc % 64));
+		--this->count;
+		return true;
+	}
+
+	auto contains(uint32_t npc) const -> bool {
+		auto const word = npc / 64;
+		return word < this->words.size() && (this->words[word] >> (npc % 64) & 1);
+	}
+
+	auto size() const -> size_t {
+		return this->count;
+	}
+
+	auto empty() const -> bool {
+		return !this->count;
+	}
+
+	// Calls func(npc) for each member, in index order.
+	template<typename TFunc>
+	auto forEach(TFunc&& func) const -> void {
+		for (size_t i = 0; i < this->words.size(); ++i) {
+			for (auto word = this->words[i]; word; word &= word - 1)
+				func(static_cast<uint32_t>(i * 64 + std::countr_zero(word)));
+		}
+	}
+
+	// Whether any member of set is in none of the excluded sets.
+	template<typename... TSets>
+	static auto anyExcept(const NPCSet& set, const TSets&... excluded) -> bool {
+		auto const words = set.words.data();
+		auto const size = set.words.size();
+		for (size_t i = 0; i < size; ++i) {
+			if (words[i] & ~(uint64_t(0) | ... | excluded.getWord(i))) return true;
+		}
+		return false;
+	}
+
+	// Number of members of set which are in none of the excluded sets.
+	template<typename... TSets>
+	static auto countExcept(const NPCSet& set, const TSets&... excluded) -> size_t {
+		auto const words = set.words.data();
+		auto const size = set.words.size();
+		size_t total = 0;
+		for (size_t i = 0; i < size; ++i)
+			total += static_cast<size_t>(std::popcount(words[i] & ~(uint64_t(0) | ... | excluded.getWord(i))));
+		return total;
+	}
+
+private:
+	auto getWord(size_t index) const -> uint64_t {
+		return index < this->words.size() ? this->words[index] : 0;
+	}
+
+private:
+	ContractVector<uint64_t> words;
+	size_t count = 0;
+};
+
+// Gives each NPC seen in a contract a small integer, in the order they're first seen, so the per-contract sets of
+// NPCs can be NPCSets. Hashing the ID happens once per NPC per event, however many sets it is then checked against.
+class NPCIndex
+{
+public:
+	static constexpr uint32_t None = ~uint32_t(0);
+
+	// Index of the NPC, assigning the next one if it hasn't been seen this contract.
+	auto add(const RepoId& id) -> uint32_t {
+		auto [it, inserted] = this->indices.try_emplace(id, static_cast<uint32_t>(this->ids.size()));
+		if (inserted) this->ids.push_back(id);
+		return it->second;
+	}
+
+	// Index of the NPC, or None if it hasn't been seen this contract (so isn't in any NPCSet).
+	auto find(const RepoId& id) const -> uint32_t {
+		auto const it = this->indices.find(id);
+		return it != this->indices.end() ? it->second : None;
+	}
+
+	auto getId(uint32_t npc) const -> const RepoId& {
+		return this->ids[npc];
+	}
+
+	auto size() const -> size_t {
+		return this->ids.size();
+	}
+
+	// For code holding a RepoId rather than an index, such as the UI.
+	auto contains(const NPCSet& set, const RepoId& id) const -> bool {
+		auto const npc = this->find(id);
+		return npc != None && set.contains(npc);
+	}
+
+	// Calls func(id) with the repository ID of each member of set.
+	template<typename TFunc>
+	auto forEachId(const NPCSet& set, TFunc&& func) const -> void {
+		set.forEach([&](uint32_t npc) { func(this->ids[npc]); });
+	}
+
+private:
+	ContractUnorderedMap<RepoId, uint32_t> indices;
+	ContractVector<RepoId> ids;
+};
@@ -0,0 +1,101 @@
+#include <cmath>
+#include <cstdio>
+#include <ostream>
+#include <string_view>
+#include "EventNames.h"
+#include "Profiler.h"
+
+auto LatencyHistogram::summarize() const -> LatencySummary {
+	auto summary = LatencySummary{
+		.count = this->count.load(std::memory_order_relaxed),
+		.max = this->max.load(std::memory_order_relaxed),
+	};
+	if (!summary.count) return summary;
+	summary.mean = static_cast<double>(this->total.load(std::memory_order_relaxed)) / static_cast<double>(summary.count);
+
+	// Counters keep moving while this runs, so percentiles are taken from the buckets' own total, and never put above
+	// the max seen.
+	std::array<uint32_t, BucketCount> counts;
+	uint64_t total = 0;
+	for (size_t i = 0; i < BucketCount; ++i) total += counts[i] = this->buckets[i].load(std::memory_order_relaxed);
+
+	auto const percentile = [&](double p) -> uint64_t {
+		auto const rank = std::max<uint64_t>(static_cast<uint64_t>(std::ceil(p * static_cast<double>(total))), 1);
+		uint64_t seen = 0;
+		for (size_t i = 0; i < BucketCount; ++i) {
+			seen += counts[i];
+			if (seen >= rank) return std::min(getBucketLimit(i), summary.max);
+		}
+		return summary.max;
+	};
+
+	summary.p50 = percentile(0.5);
+	summary.p99 = percentile(0.99);
+	summary.p999 = percentile(0.999);
+	return summary;
+}
+
+auto Profiler::getSectionName(ProfileSection section) -> const char* {
+	switch (section) {
+		case ProfileSection::EventSent: return "event sent";
+		case ProfileSection::EventStringify: return "  stringify";
+		case ProfileSection::EventParse: return "  parse";
+		case ProfileSection::EventDispatch: return "  dispatch";
+		case ProfileSection::EventHandlers: return "    handlers";
+		case ProfileSection::DisplayStats: return "display stats";
+		case ProfileSection::FrameUpdate: return "frame update";
+		case ProfileSection::LoadRemoval: return "load removal";
+		case ProfileSection::DrawUI: return "draw UI";
+		case ProfileSection::LiveSplitSend: return "LiveSplit send";
+		case ProfileSection::Count: break;
+	}
+	return "?";
+}
+
+auto Profiler::reset() -> void {
+	for (auto& histogram : sections) histogram.reset();
+	for (auto& histogram : events) histogram.reset();
+	for (auto& histogram : handlers) histogram.reset();
+}
+
+static auto writeRow(std::ostream& out, std::string_view name, const LatencySummary& summary) -> void {
+	char row[160];
+	std::snprintf(
+		row,
+		sizeof(row),
+		"  %-32.*s %10llu %10.2f %10.2f %10.2f %10.2f %10.2f\n",
+		static_cast<int>(name.size()),
+		name.data(),
+		static_cast<unsigned long long>(summary.count),
+		summary.mean / 1000.0,
+		static_cast<double>(summary.p50) / 1000.0,
+		static_cast<double>(summary.p99) / 1000.0,
+		static_cast<double>(summary.p999) / 1000.0,
+		static_cast<double>(summary.max) / 1000.0
+	);
+	out << row;
+}
+
+static auto writeHeading(std::ostream& out, const char* heading) -> void {
+	char row[160];
+	std::snprintf(row, sizeof(row), "  %-32s %10s %10s %10s %10s %10s %10s\n", heading, "count", "mean", "p50", "p99", "p99.9", "max");
+	out << row;
+}
+
+auto Profiler::writeReport(std::ostream& out) -> void {
+	writeHeading(out, "section (us)");
+	for (size_t i = 0; i < sections.size(); ++i) {
+		auto const section = static_cast<ProfileSection>(i);
+		writeRow(out, getSectionName(section), getSection(section).summarize());
+	}
+
+	writeHeading(out, "event (us)");
+	for (size_t i = 0; i < EventCount; ++i) {
+		auto const event = static_cast<Events>(i);
+		auto const summary = getEvent(event).summarize();
+		if (!summary.count) continue;
+
+		writeRow(out, getEventName(event), summary);
+		writeRow(out, "  handlers", getHandlers(event).summarize());
+	}
+}
@@ -0,0 +1,191 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include "Enums.h"
+
+// Timing of the mod's hot paths. Each section feeds a log-linear latency histogram of relaxed atomic counters, which
+// costs two clock reads and a few uncontended increments per sample. That's cheap enough to leave on, and safe to read
+// from the UI thread while the game thread, event worker and LiveSplit thread record into it.
+enum class ProfileSection : uint8_t
+{
+	// The whole OnEventSent hook, and the parts of it.
+	EventSent,
+	EventStringify,
+	// Peeking at the event's header and looking up its name.
+	EventParse,
+	// Decoding the event's value and calling its handlers.
+	EventDispatch,
+	EventHandlers,
+	// Recomputing the display stats from those marked dirty.
+	DisplayStats,
+	FrameUpdate,
+	LoadRemoval,
+	DrawUI,
+	LiveSplitSend,
+	Count,
+};
+
+struct LatencySummary
+{
+	uint64_t count = 0;
+	double mean = 0;
+	uint64_t p50 = 0;
+	uint64_t p99 = 0;
+	uint64_t p999 = 0;
+	uint64_t max = 0;
+};
+
+// Nanosecond samples counted in buckets exact below 16 ns, then 8 to each doubling after, so any percentile is within
+// 12.5% of the true value. Samples past about 18 minutes count as the last bucket.
+class LatencyHistogram
+{
+public:
+	static constexpr int SubBucketBits = 3;
+	static constexpr size_t SubBuckets = size_t(1) << SubBucketBits;
+	static constexpr int MaxBits = 40;
+	static constexpr size_t BucketCount = SubBuckets * (MaxBits - SubBucketBits + 1);
+
+	auto record(uint64_t nanoseconds) -> void {
+		this->buckets[getBucket(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+		this->count.fetch_add(1, std::memory_order_relaxed);
+		this->total.fetch_add(nanoseconds, std::memory_order_relaxed);
+
+		auto max = this->max.load(std::memory_order_relaxed);
+		while (nanoseconds > max && !this->max.compare_exchange_weak(max, nanoseconds, std::memory_order_relaxed));
+	}
+
+	// Samples recorded while resetting may be partly kept.
+	auto reset() -> void {
+		for (auto& bucket : this->buckets) bucket.store(0, std::memory_order_relaxed);
+		this->count.store(0, std::memory_order_relaxed);
+		this->total.store(0, std::memory_order_relaxed);
+		this->max.store(0, std::memory_order_relaxed);
+	}
+
+	auto getCount() const -> uint64_t {
+		return this->count.load(std::memory_order_relaxed);
+	}
+
+	auto summarize() const -> LatencySummary;
+
+	static constexpr auto getBucket(uint64_t value) -> size_t {
+		value = std::min(value, (uint64_t(1) << MaxBits) - 1);
+		auto const bits = std::bit_width(value);
+		if (bits <= SubBucketBits + 1) return static_cast<size_t>(value);
+
+		auto const shift = bits - SubBucketBits - 1;
+		return static_cast<size_t>(shift + 1) * SubBuckets + static_cast<size_t>((value >> shift) & (SubBuckets - 1));
+	}
+
+	// The largest value counted in the bucket.
+	static constexpr auto getBucketLimit(size_t bucket) -> uint64_t {
+		if (bucket < SubBuckets * 2) return bucket;
+
+		auto const shift = bucket / SubBuckets - 1;
+		auto const lower = (SubBuckets + bucket % SubBuckets) << shift;
+		return lower + (uint64_t(1) << shift) - 1;
+	}
+
+private:
+	std::array<std::atomic<uint32_t>, BucketCount> buckets = {};
+	std::atomic<uint64_t> count = 0;
+	std::atomic<uint64_t> total = 0;
+	std::atomic<uint64_t> max = 0;
+};
+
+static_assert(LatencyHistogram::getBucket(15) == 15 && LatencyHistogram::getBucket(16) == 16 && LatencyHistogram::getBucket(17) == 16);
+static_assert(LatencyHistogram::getBucketLimit(LatencyHistogram::getBucket(1000)) >= 1000);
+static_assert(LatencyHistogram::getBucket(~uint64_t(0)) == LatencyHistogram::BucketCount - 1);
+
+// A timed section as it happened, for the timeline (see Timeline.h). Spans outside the profiled sections have a name
+// and ProfileSection::Count instead, and those ending as they start are markers.
+struct ProfileSpan
+{
+	// Steady clock ticks.
+	int64_t start = 0;
+	int64_t end = 0;
+	const char* name = nullptr;
+	ProfileSection section = ProfileSection::Count;
+	// The Events ordinal of the event being dispatched or handled, or EventCount.
+	uint16_t event = static_cast<uint16_t>(EventCount);
+};
+
+namespace Profiler
+{
+	using Clock = std::chrono::steady_clock;
+
+	// Set while a timeline is being written, for timed sections to be recorded to it as they happen.
+	inline std::atomic<bool> recordingTimeline = false;
+
+	inline auto isRecordingTimeline() -> bool {
+		return recordingTimeline.load(std::memory_order_relaxed);
+	}
+
+	// Defined by the timeline, which drops the span if its ring is full.
+	auto recordSpan(const ProfileSpan& span) -> void;
+
+	inline std::array<LatencyHistogram, static_cast<size_t>(ProfileSection::Count)> sections;
+	// Handling each kind of event, from parsing to the end of its handlers, and its handlers alone.
+	inline std::array<LatencyHistogram, EventCount> events;
+	inline std::array<LatencyHistogram, EventCount> handlers;
+
+	inline auto getSection(ProfileSection section) -> LatencyHistogram& {
+		return sections[static_cast<size_t>(section)];
+	}
+
+	inline auto getEvent(Events event) -> LatencyHistogram& {
+		return events[static_cast<size_t>(event)];
+	}
+
+	inline auto getHandlers(Events event) -> LatencyHistogram& {
+		return handlers[static_cast<size_t>(event)];
+	}
+
+	inline auto getNanoseconds(Clock::time_point start, Clock::time_point end = Clock::now()) -> uint64_t {
+		return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+	}
+
+	auto getSectionName(ProfileSection section) -> const char*;
+	auto reset() -> void;
+	// Writes a table of every section, then every event seen, with their percentiles in microseconds.
+	auto writeReport(std::ostream& out) -> void;
+}
+
+// Records the time from its construction to its destruction.
+class ProfileScope
+{
+public:
+	explicit ProfileScope(LatencyHistogram& histogram) : histogram(histogram), start(Profiler::Clock::now())
+	{ }
+
+	// Also recorded to the timeline while one is being written.
+	explicit ProfileScope(ProfileSection section) : histogram(Profiler::getSection(section)), start(Profiler::Clock::now()), section(section)
+	{ }
+
+	ProfileScope(const ProfileScope&) = delete;
+	auto operator=(const ProfileScope&) -> ProfileScope& = delete;
+
+	~ProfileScope() {
+		auto const end = Profiler::Clock::now();
+		this->histogram.record(Profiler::getNanoseconds(this->start, end));
+
+		if (this->section != ProfileSection::Count && Profiler::isRecordingTimeline()) {
+			Profiler::recordSpan(ProfileSpan{
+				.start = this->start.time_since_epoch().count(),
+				.end = end.time_since_epoch().count(),
+				.section = this->section,
+			});
+		}
+	}
+
+private:
+	LatencyHistogram& histogram;
+	Profiler::Clock::time_point start;
+	ProfileSection section = ProfileSection::Count;
+};
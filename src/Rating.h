@@ -220,7 +220,7 @@ inline const auto playStyleRatings = std::array{
 	}),
 };
 
-auto getPlayStyleRating(const Stats& stats) {
+inline auto getPlayStyleRating(const Stats& stats) {
 	const PlayStyleRating* topRating = nullptr;
 	int topScore = -1;
 
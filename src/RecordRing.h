@@ -0,0 +1,42 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+// Single-producer/single-consumer ring of fixed-size records, for a thread to hand records to a background thread
+// without waiting on it. Records are dropped while it's full.
+template<typename T, size_t N>
+class RecordRing
+{
+public:
+	static constexpr size_t Capacity = N;
+
+	// Producer only.
+	auto push(const T& record) -> bool {
+		auto const head = this->head.load(std::memory_order_relaxed);
+		if (head - this->cachedTail == Capacity) {
+			this->cachedTail = this->tail.load(std::memory_order_acquire);
+			if (head - this->cachedTail == Capacity) return false;
+		}
+
+		this->records[head % Capacity] = record;
+		this->head.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Consumer only. Calls func(const T&) for each record, oldest first, and returns how many there were.
+	template<typename TFunc>
+	auto drain(TFunc&& func) -> size_t {
+		auto const tail = this->tail.load(std::memory_order_relaxed);
+		auto const head = this->head.load(std::memory_order_acquire);
+		for (auto i = tail; i != head; ++i) func(this->records[i % Capacity]);
+		this->tail.store(head, std::memory_order_release);
+		return head - tail;
+	}
+
+private:
+	std::array<T, Capacity> records;
+	alignas(64) std::atomic<size_t> head = 0;
+	size_t cachedTail = 0;
+	alignas(64) std::atomic<size_t> tail = 0;
+};
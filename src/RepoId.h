@@ -0,0 +1,155 @@
+#pragma once
+#include <array>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#define STEALTHOMETER_REPOID_SSE2
+#include <emmintrin.h>
+#endif
+
+// Repository ID: a GUID held as its 16 bytes rather than the 36 character string the game sends.
+// Parsed once when an event is decoded, so case-insensitivity is handled by construction and comparing or hashing
+// is a couple of integer operations. Ordering matches that of the lowercase string form.
+// A default constructed ID (or one that failed to parse) is "no ID", which is distinct from the nil GUID the game
+// sometimes sends for bodies. It's stored as the all-ones GUID, which is reserved for it.
+class RepoId
+{
+public:
+	static constexpr size_t StringSize = 36;
+
+	constexpr RepoId() = default;
+
+	explicit RepoId(std::string_view str) {
+		parse(str, *this);
+	}
+
+	// From the two halves of the GUID as returned by high() and low(), e.g. when read back from a binary index.
+	constexpr RepoId(uint64_t high, uint64_t low) : hi(high), lo(low) {}
+
+	// Parses the "xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx" form in any case. On failure id is left empty.
+	static auto parse(std::string_view str, RepoId& id) -> bool {
+		id = RepoId();
+
+		if (str.size() != StringSize || str[8] != '-' || str[13] != '-' || str[18] != '-' || str[23] != '-')
+			return false;
+
+		char hex[32];
+		std::memcpy(hex, str.data(), 8);
+		std::memcpy(hex + 8, str.data() + 9, 4);
+		std::memcpy(hex + 12, str.data() + 14, 4);
+		std::memcpy(hex + 16, str.data() + 19, 4);
+		std::memcpy(hex + 20, str.data() + 24, 12);
+
+		uint8_t bytes[16];
+		if (!decodeHex(hex, bytes) || !decodeHex(hex + 16, bytes + 8))
+			return false;
+
+		id.hi = loadBigEndian(bytes);
+		id.lo = loadBigEndian(bytes + 8);
+		return true;
+	}
+
+	constexpr auto high() const -> uint64_t {
+		return this->hi;
+	}
+
+	constexpr auto low() const -> uint64_t {
+		return this->lo;
+	}
+
+	auto empty() const -> bool {
+		return *this == RepoId();
+	}
+
+	auto hash() const -> size_t {
+		// GUIDs are mostly random bits already, so a single multiply is enough to mix both halves.
+		auto const hash = (this->hi ^ std::rotl(this->lo, 32)) * 0x9E3779B97F4A7C15ull;
+		return static_cast<size_t>(hash ^ (hash >> 32));
+	}
+
+	// Lowercase string form, or empty if there is no ID.
+	auto toString() const -> std::string {
+		if (this->empty()) return {};
+
+		static constexpr char digits[] = "0123456789abcdef";
+		std::string str(StringSize, '-');
+		auto pos = size_t(0);
+
+		for (auto i = 0; i < 32; ++i) {
+			if (pos == 8 || pos == 13 || pos == 18 || pos == 23) ++pos;
+			auto const half = i < 16 ? this->hi : this->lo;
+			str[pos++] = digits[(half >> (60 - (i % 16) * 4)) & 0xF];
+		}
+		return str;
+	}
+
+	friend constexpr auto operator==(const RepoId&, const RepoId&) -> bool = default;
+	friend constexpr auto operator<=>(const RepoId&, const RepoId&) = default;
+
+private:
+	static auto loadBigEndian(const uint8_t* bytes) -> uint64_t {
+		uint64_t value;
+		std::memcpy(&value, bytes, sizeof(value));
+		if constexpr (std::endian::native == std::endian::little) value = std::byteswap(value);
+		return value;
+	}
+
+	// Decodes 16 hex characters into 8 bytes. Returns false if any character isn't a hex digit.
+	static auto decodeHex(const char* hex, uint8_t* out) -> bool {
+#ifdef STEALTHOMETER_REPOID_SSE2
+		auto const chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hex));
+		auto const lower = _mm_or_si128(chars, _mm_set1_epi8(0x20));
+
+		// Signed compares, but anything outside ASCII is negative and fails both ranges anyway.
+		auto const isDigit = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(chars, _mm_set1_epi8('9' + 1)));
+		auto const isLetter = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1)));
+		if (_mm_movemask_epi8(_mm_or_si128(isDigit, isLetter)) != 0xFFFF) return false;
+
+		auto const nibbles = _mm_or_si128(
+			_mm_and_si128(isDigit, _mm_sub_epi8(chars, _mm_set1_epi8('0'))),
+			_mm_and_si128(isLetter, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10)))
+		);
+
+		// Each 16-bit lane has the high nibble of a byte in its low half and the low nibble in its high half.
+		auto const high = _mm_slli_epi16(_mm_and_si128(nibbles, _mm_set1_epi16(0x00FF)), 4);
+		auto const low = _mm_srli_epi16(nibbles, 8);
+		auto const packed = _mm_packus_epi16(_mm_or_si128(high, low), _mm_setzero_si128());
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(out), packed);
+		return true;
+#else
+		for (auto i = 0; i < 8; ++i) {
+			auto const high = decodeNibble(hex[i * 2]);
+			auto const low = decodeNibble(hex[i * 2 + 1]);
+			if (high < 0 || low < 0) return false;
+			out[i] = static_cast<uint8_t>(high << 4 | low);
+		}
+		return true;
+#endif
+	}
+
+	static constexpr auto decodeNibble(char c) -> int {
+		if (c >= '0' && c <= '9') return c - '0';
+		if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+		if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+		return -1;
+	}
+
+private:
+	uint64_t hi = ~0ull;
+	uint64_t lo = ~0ull;
+};
+
+template<>
+struct std::hash<RepoId>
+{
+	auto operator()(const RepoId& id) const noexcept -> size_t {
+		return id.hash();
+	}
+};
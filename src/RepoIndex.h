@@ -0,0 +1,180 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string_view>
+#include "Enums.h"
+#include "RepoId.h"
+
+// Binary form of repo.json and npc.json, built by stealthometer-repogen and embedded in place of them. Only the fields
+// the tracker reads are kept, and items are classified into an ItemInfoType when the index is built. Records are
+// sorted by ID and queried in place by binary search, so loading is a header check and one pass over the IDs, and
+// nothing is copied onto the heap.
+//
+// Layout (little-endian): Header, item records, NPC records, then a pool of deduplicated strings the records refer to.
+namespace RepoIndexFormat
+{
+	inline constexpr char Magic[4] = {'S', 'M', 'R', 'I'};
+	inline constexpr uint32_t Version = 2;
+
+	struct Header
+	{
+		char magic[4];
+		uint32_t version;
+		uint32_t itemCount;
+		uint32_t npcCount;
+		uint32_t itemsOffset;
+		uint32_t npcsOffset;
+		uint32_t stringsOffset;
+		uint32_t stringsSize;
+	};
+
+	struct StringRef
+	{
+		uint32_t offset;
+		uint32_t size;
+	};
+
+	enum ItemFlags : uint32_t
+	{
+		IsHitmanSuit = 1 << 0,
+	};
+
+	struct ItemRecord
+	{
+		uint64_t idHigh;
+		uint64_t idLow;
+		StringRef title;
+		StringRef commonName;
+		uint32_t flags;
+		uint32_t infoType;
+	};
+
+	struct NPCRecord
+	{
+		uint64_t idHigh;
+		uint64_t idLow;
+		StringRef name;
+	};
+
+	static_assert(sizeof(Header) == 32);
+	static_assert(sizeof(ItemRecord) == 40);
+	static_assert(sizeof(NPCRecord) == 24);
+}
+
+class RepoIndex
+{
+public:
+	struct Item
+	{
+		ItemInfoType infoType = ItemInfoType::Other;
+		std::string_view title;
+		std::string_view commonName;
+		bool isHitmanSuit = false;
+	};
+
+	// Points the index at a built blob, which must outlive it. Returns false (leaving the index empty) if it isn't one.
+	auto load(std::string_view data) -> bool {
+		using namespace RepoIndexFormat;
+
+		*this = RepoIndex();
+		if (data.size() < sizeof(Header)) return false;
+
+		Header header;
+		std::memcpy(&header, data.data(), sizeof(header));
+		if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0 || header.version != Version) return false;
+
+		auto const fits = [&](uint64_t offset, uint64_t size) {
+			return offset <= data.size() && size <= data.size() - offset;
+		};
+		if (!fits(header.itemsOffset, uint64_t(header.itemCount) * sizeof(ItemRecord))
+			|| !fits(header.npcsOffset, uint64_t(header.npcCount) * sizeof(NPCRecord))
+			|| !fits(header.stringsOffset, header.stringsSize))
+			return false;
+
+		auto const items = data.data() + header.itemsOffset;
+		auto const npcs = data.data() + header.npcsOffset;
+		if (!isSorted<ItemRecord>(items, header.itemCount) || !isSorted<NPCRecord>(npcs, header.npcCount)) return false;
+
+		this->items = items;
+		this->npcs = npcs;
+		this->strings = data.substr(header.stringsOffset, header.stringsSize);
+		this->itemCount = header.itemCount;
+		this->npcCount = header.npcCount;
+		return true;
+	}
+
+	auto getItemCount() const -> size_t {
+		return this->itemCount;
+	}
+
+	auto getNPCCount() const -> size_t {
+		return this->npcCount;
+	}
+
+	auto findItem(const RepoId& id) const -> std::optional<Item> {
+		RepoIndexFormat::ItemRecord record;
+		if (!find(this->items, this->itemCount, id, record)) return std::nullopt;
+
+		return Item{
+			.infoType = static_cast<ItemInfoType>(record.infoType),
+			.title = this->getString(record.title),
+			.commonName = this->getString(record.commonName),
+			.isHitmanSuit = (record.flags & RepoIndexFormat::IsHitmanSuit) != 0,
+		};
+	}
+
+	auto findNPCName(const RepoId& id) const -> std::optional<std::string_view> {
+		RepoIndexFormat::NPCRecord record;
+		if (!find(this->npcs, this->npcCount, id, record)) return std::nullopt;
+		return this->getString(record.name);
+	}
+
+private:
+	// Records aren't necessarily aligned within the blob, so each one probed is copied out.
+	template<typename TRecord>
+	static auto find(const char* records, size_t count, const RepoId& id, TRecord& record) -> bool {
+		if (id.empty()) return false;
+
+		size_t low = 0;
+		size_t high = count;
+
+		while (low < high) {
+			auto const mid = low + (high - low) / 2;
+			std::memcpy(&record, records + mid * sizeof(TRecord), sizeof(TRecord));
+
+			auto const recordId = RepoId(record.idHigh, record.idLow);
+			if (recordId == id) return true;
+			if (recordId < id) low = mid + 1;
+			else high = mid;
+		}
+		return false;
+	}
+
+	// Lookups rely on strictly ascending IDs, so a blob from a broken build step is rejected rather than half working.
+	template<typename TRecord>
+	static auto isSorted(const char* records, size_t count) -> bool {
+		auto previous = RepoId(0, 0);
+		TRecord record;
+
+		for (size_t i = 0; i < count; ++i) {
+			std::memcpy(&record, records + i * sizeof(TRecord), sizeof(TRecord));
+			auto const id = RepoId(record.idHigh, record.idLow);
+			if (i && id <= previous) return false;
+			previous = id;
+		}
+		return true;
+	}
+
+	auto getString(RepoIndexFormat::StringRef ref) const -> std::string_view {
+		if (ref.offset > this->strings.size() || ref.size > this->strings.size() - ref.offset) return {};
+		return this->strings.substr(ref.offset, ref.size);
+	}
+
+private:
+	const char* items = nullptr;
+	const char* npcs = nullptr;
+	std::string_view strings;
+	size_t itemCount = 0;
+	size_t npcCount = 0;
+};
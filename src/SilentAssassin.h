@@ -0,0 +1,46 @@
+#pragma once
+#include "NPCIndex.h"
+
+// Incrementally maintained inputs to the Silent Assassin status, so it can be evaluated without looking at the witness
+// and spotter sets. Keeps the NPCs that are dead or targets, and counts the witnesses and spotters outside them as each
+// changes. Kills and target status only ever go from false to true within a contract, which keeps every update O(1).
+class SilentAssassinTracker
+{
+public:
+	// Living witnesses which aren't targets.
+	auto getNonTargetWitnesses() const -> int {
+		return this->nonTargetWitnesses;
+	}
+
+	// Living NPCs that have spotted 47 which aren't targets.
+	auto getNonTargetSpotters() const -> int {
+		return this->nonTargetSpotters;
+	}
+
+	// The NPC was just added to the witnesses.
+	auto addWitness(uint32_t npc) -> void {
+		if (!this->excluded.contains(npc)) ++this->nonTargetWitnesses;
+	}
+
+	// The NPC was just removed from the witnesses.
+	auto removeWitness(uint32_t npc) -> void {
+		if (!this->excluded.contains(npc)) --this->nonTargetWitnesses;
+	}
+
+	// The NPC was just added to the spotters.
+	auto addSpotter(uint32_t npc) -> void {
+		if (!this->excluded.contains(npc)) ++this->nonTargetSpotters;
+	}
+
+	// The NPC was killed or has become known as a target, and is or isn't currently a witness and spotter.
+	auto exclude(uint32_t npc, bool witness, bool spotter) -> void {
+		if (!this->excluded.insert(npc)) return;
+		if (witness) --this->nonTargetWitnesses;
+		if (spotter) --this->nonTargetSpotters;
+	}
+
+private:
+	NPCSet excluded;
+	int nonTargetWitnesses = 0;
+	int nonTargetSpotters = 0;
+};
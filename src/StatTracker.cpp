@@ -0,0 +1,1116 @@
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include "Enums.h"
+#include "Events.h"
+#include "EventSystem.h"
+#include "json.hpp"
+#include "Log.h"
+#include "Profiler.h"
+#include "Rating.h"
+#include "Stats.h"
+#include "StatTracker.h"
+#include "Trace.h"
+
+StatTracker::StatTracker() : randomGenerator(std::random_device{}()) {
+	// The stats were default constructed before the arena could be made current, so they're constructed again inside
+	// it, as NewContract does. What they first allocated is abandoned in the thread's fallback arena.
+	auto const scope = ContractArena::Scope(this->contractArena);
+	std::construct_at(&this->stats);
+	this->stats.witnessEvents.setRetention(this->witnessRetention);
+	this->SetupEvents();
+}
+
+auto StatTracker::LoadRepository(std::string_view index) -> bool {
+	auto const start = std::chrono::steady_clock::now();
+	this->repoLoadInfo = RepositoryLoadInfo();
+
+	if (!this->repo.load(index)) {
+		Logger::Error("Stealthometer: repo index invalid.");
+		return false;
+	}
+
+	this->repoLoadInfo.loaded = true;
+	this->repoLoadInfo.items = this->repo.getItemCount();
+	this->repoLoadInfo.npcs = this->repo.getNPCCount();
+	this->repoLoadInfo.bytes = index.size();
+	this->repoLoadInfo.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	Logger::Info("Stealthometer: repo index loaded ({} items, {} NPCs) in {:.3f} ms.", this->repoLoadInfo.items, this->repoLoadInfo.npcs, this->repoLoadInfo.milliseconds);
+	return true;
+}
+
+auto StatTracker::LogMemoryReport() const -> void {
+	Memory::forEachSubsystem([](MemorySubsystem subsystem, const MemoryUsage& usage) {
+		Logger::Info(
+			"Memory: {}: {} bytes live, {} peak, {} allocations, {} frees",
+			Memory::getSubsystemName(subsystem),
+			usage.liveBytes,
+			usage.peakBytes,
+			usage.allocations,
+			usage.deallocations
+		);
+	});
+	Logger::Info(
+		"Memory: contract arena: {} bytes reserved in {} blocks, {} bytes in {} allocations this contract",
+		this->contractArena.getBytesReserved(),
+		this->contractArena.getBlockCount(),
+		this->contractArena.getBytesUsed(),
+		this->contractArena.getAllocations()
+	);
+	Logger::Info("Memory: repo index: {} bytes (embedded, not on the heap)", this->repoLoadInfo.bytes);
+}
+
+auto StatTracker::HandleEvent(std::string_view eventData) -> bool {
+	auto const scope = ContractArena::Scope(this->contractArena);
+	auto const start = Profiler::Clock::now();
+	auto const header = EventDecoder::peek(eventData);
+	auto const& eventName = header.Name;
+	auto const eventInfo = lookupEventName(eventName);
+	auto const parsed = Profiler::Clock::now();
+	Profiler::getSection(ProfileSection::EventParse).record(Profiler::getNanoseconds(start, parsed));
+
+	if (header.Timestamp) this->lastEventTimestamp = header.Timestamp;
+
+	if (eventInfo.kind == EventNameKind::Blacklisted) return false;
+
+	// Only the first of each kind of unhandled event is logged; the rest are counted in the history.
+	if (eventInfo.kind != EventNameKind::Event) {
+		if (this->eventHistory.addUnknown(eventName, header.Timestamp, eventData))
+			Logger::Info("Unhandled Event Sent: {}", eventData);
+		return false;
+	}
+
+	auto const handled = this->events.handle(eventInfo.event, eventData);
+	auto const dispatched = Profiler::Clock::now();
+	Profiler::getSection(ProfileSection::EventDispatch).record(Profiler::getNanoseconds(parsed, dispatched));
+	Profiler::getEvent(eventInfo.event).record(Profiler::getNanoseconds(start, dispatched));
+
+	if (Profiler::isRecordingTimeline()) {
+		Profiler::recordSpan(ProfileSpan{
+			.start = start.time_since_epoch().count(),
+			.end = dispatched.time_since_epoch().count(),
+			.section = ProfileSection::EventDispatch,
+			.event = static_cast<uint16_t>(eventInfo.event),
+		});
+	}
+
+	if (this->eventHistory.add(eventInfo.event, header.Timestamp, eventData, handled))
+		Logger::Info("Unhandled Event Sent: {}", eventData);
+	if (!handled) return false;
+
+	++this->displayCounters.requested;
+	return true;
+}
+
+auto StatTracker::IsRepoIdTargetNPC(const RepoId& id) const -> bool {
+	return this->targets.contains(id);
+}
+
+auto StatTracker::AddTarget(const RepoId& id) -> void {
+	if (!this->targets.add(id)) return;
+	this->MarkDirty(StatGroup::Targets);
+
+	auto const scope = ContractArena::Scope(this->contractArena);
+	auto const npc = this->stats.npcs.add(id);
+	this->stats.targetNPCs.insert(npc);
+	this->stats.silentAssassin.exclude(npc, this->stats.witnesses.contains(npc), this->stats.spottedBy.contains(npc));
+}
+
+auto StatTracker::GetRepoEntry(const RepoId& id) const -> std::optional<RepoIndex::Item> {
+	return this->repo.findItem(id);
+}
+
+auto StatTracker::GetNPCName(const RepoId& id) const -> std::optional<std::string_view> {
+	return this->repo.findNPCName(id);
+}
+
+auto StatTracker::InternNPC(const RepoId& id) -> uint32_t {
+	return id.empty() ? NPCIndex::None : this->stats.npcs.add(id);
+}
+
+auto StatTracker::SetWitnessRetention(double seconds) -> void {
+	this->witnessRetention = seconds;
+	this->stats.witnessEvents.setRetention(seconds);
+}
+
+auto StatTracker::NewContract() -> void {
+	if (this->displayCounters.requested) {
+		Logger::Info(
+			"Display stats: {} updates requested, {} committed (SA {}, rating {}, play style {})",
+			this->displayCounters.requested,
+			this->displayCounters.committed,
+			this->displayCounters.silentAssassin,
+			this->displayCounters.stealthRating,
+			this->displayCounters.playStyle
+		);
+	}
+
+	// The old stats are abandoned rather than destroyed: all they own is in the arena, which is rewound
+	// in one go. Only this tracker's arena may be current while they are rebuilt.
+	auto const scope = ContractArena::Scope(this->contractArena);
+	auto const resetStart = std::chrono::steady_clock::now();
+	this->lastContractMemory = ContractMemoryInfo{
+		.allocations = this->contractArena.getAllocations(),
+		.bytes = this->contractArena.getBytesUsed(),
+		.reservedBytes = this->contractArena.getBytesReserved(),
+	};
+	this->contractArena.release();
+	std::construct_at(&this->stats);
+	this->stats.witnessEvents.setRetention(this->witnessRetention);
+	this->lastContractMemory.resetMicroseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - resetStart).count();
+
+	if (this->lastContractMemory.allocations) {
+		Logger::Info(
+			"Contract memory: {} allocations, {} bytes ({} reserved), reset in {:.2f} us",
+			this->lastContractMemory.allocations,
+			this->lastContractMemory.bytes,
+			this->lastContractMemory.reservedBytes,
+			this->lastContractMemory.resetMicroseconds
+		);
+	}
+
+	this->displayStats = DisplayStats();
+	this->missionEndTime = 0;
+	this->cutsceneEndTime = 0;
+	this->targets.clear();
+	this->events.resetLists();
+	this->displayCounters = DisplayUpdateCounters();
+	this->dirtyStats = StatGroup::All;
+	this->displayReset = true;
+}
+
+auto StatTracker::CreateItemInfo(const RepoId& id) -> ItemInfo {
+	ItemInfo item;
+	item.type = ItemInfoType::None;
+	auto entry = this->GetRepoEntry(id);
+	if (entry) {
+		switch (entry->infoType) {
+			case ItemInfoType::Key:
+				++stats.misc.keyItemsPickedUp;
+				break;
+			case ItemInfoType::Detonator:
+				break;
+			case ItemInfoType::Intel:
+				++stats.misc.itemsPickedUp;
+				++stats.misc.intelItemsPickedUp;
+				break;
+			default:
+				++stats.misc.itemsPickedUp;
+				break;
+		}
+
+		if (entry->infoType != ItemInfoType::Detonator) {
+			item.type = entry->infoType;
+			item.name = entry->title;
+			item.commonName = entry->commonName;
+		}
+	}
+	return item;
+}
+
+auto StatTracker::AddObtainedItem(const RepoId& id, ItemInfo item) -> void {
+	if (item.type == ItemInfoType::None) return;
+	if (id.empty()) return;
+	auto it = this->stats.itemsObtained.find(id);
+	if (it != this->stats.itemsObtained.end())
+		++it->second.count;
+	else
+		this->stats.itemsObtained.emplace(id, item);
+}
+
+auto StatTracker::AddDisposedItem(const RepoId& id, ItemInfo item) -> void {
+	if (item.type == ItemInfoType::None) return;
+	if (id.empty()) return;
+	auto it = this->stats.itemsDisposed.find(id);
+	if (it != this->stats.itemsDisposed.end())
+		++it->second.count;
+	else
+		this->stats.itemsDisposed.emplace(id, item);
+}
+
+auto StatTracker::RemoveObtainedItem(const RepoId& id) -> int {
+	if (id.empty()) return -1;
+	auto it = stats.itemsObtained.find(id);
+	if (it != stats.itemsObtained.end()) {
+		if (it->second.count > 1) return --it->second.count;
+		stats.itemsObtained.erase(it);
+		return 0;
+	}
+	return -1;
+}
+
+auto StatTracker::GetSilentAssassinStatus() const -> SilentAssassinStatus {
+	// Non-Target Kills
+	auto nonTargetKills = this->stats.kills.nonTargets.size() + this->stats.kills.crowd;
+	if (nonTargetKills > 0) return SilentAssassinStatus::Fail;
+
+	// Spotted - living non-target witnesses and spotters
+	auto const& silentAssassin = this->stats.silentAssassin;
+	if (silentAssassin.getNonTargetWitnesses() > 0 || silentAssassin.getNonTargetSpotters() > 0)
+		return SilentAssassinStatus::Fail;
+
+	// TODO: Learn if there are any situations that invalidate 'No Noticed Kills' independently from 'Never Spotted'.
+	// Otherwise, it's pointless considering this for SA tracking. 'No Noticed Kills' is seemingly not based on noticed kills.
+	
+	// Noticed Kills
+	//if (stats.kills.noticed > 0)
+	//	return SilentAssassinStatus::Fail;
+
+	// Bodies Found - if body found by non-target, it's definitely not recoverable.
+	if (this->stats.bodies.foundMurderedByNonTarget > 0)
+		return SilentAssassinStatus::Fail;
+
+	// We can shortcut the target redeemable SA logic by comparing the number of target witnesses vs. the number of target witnesses killed.
+	auto spottedByTarget = this->stats.targetBodyWitnesses.size() > this->stats.bodies.targetBodyWitnessesKilled
+		|| this->stats.targetsSpottedBy.size() > this->stats.detection.targetsSpottedByAndKilled;
+
+	// Evidence - also redeemable. Check if we have redeemability from both target and cams.
+	if (this->stats.detection.onCamera) {
+		if (spottedByTarget)
+			return SilentAssassinStatus::RedeemableCameraAndTarget;
+
+		return SilentAssassinStatus::RedeemableCamera;
+	}
+
+	return spottedByTarget ? SilentAssassinStatus::RedeemableTarget : SilentAssassinStatus::OK;
+}
+
+auto StatTracker::CalculateStealthRating() -> double {
+	auto rating = 100.0;
+	rating -= this->stats.kills.civilian * 8;
+	rating -= this->stats.kills.guard * 5;
+	rating -= this->displayStats.witnesses * 10;
+	rating -= this->stats.detection.onCamera * 15;
+	rating -= this->displayStats.bodiesFound * 5;
+	rating -= this->stats.detection.spotted * 5;
+	rating -= std::max(this->stats.pacifies.nonTargets - 3, 0) * 2;
+	rating += std::min(this->displayStats.bodiesHidden * 3, 15);
+	// TODO: more + adjustments
+	return std::min(std::max(rating, 0.0), 100.0);
+}
+
+auto StatTracker::MarkDirty(StatGroup groups) -> void {
+	this->dirtyStats |= groups;
+}
+
+auto StatTracker::CommitDisplayStats() -> bool {
+	// Resetting the display stats for a new contract is a change in itself, whatever they are then recomputed to.
+	auto const reset = std::exchange(this->displayReset, false);
+	if (this->dirtyStats == StatGroup::None) return reset;
+	auto const profile = ProfileScope(ProfileSection::DisplayStats);
+
+	auto const dirty = std::exchange(this->dirtyStats, StatGroup::None);
+	auto updated = reset;
+	++this->displayCounters.committed;
+
+	// Tension
+	if (hasAnyStatGroup(dirty, StatGroup::Tension | StatGroup::Witnesses)) {
+		auto level = this->stats.tension.level;
+		auto witness = static_cast<int>(this->stats.witnesses.size());
+		auto tension = std::min(level + witness, 470);
+
+		if (tension != this->displayStats.tension) {
+			this->displayStats.tension = tension;
+			updated = true;
+		}
+	}
+
+	// Pacifications
+	if (hasAnyStatGroup(dirty, StatGroup::Pacifies) && this->displayStats.pacifications != this->stats.pacifies.nonTargets) {
+		this->displayStats.pacifications = this->stats.pacifies.nonTargets;
+		updated = true;
+	}
+
+	if (hasAnyStatGroup(dirty, StatGroup::Detection)) {
+		// Spotted
+		if (this->displayStats.spotted != (this->stats.targetsSpottedBy.size() + this->stats.detection.nonTargetsSpottedBy)) {
+			this->displayStats.spotted = this->stats.targetsSpottedBy.size() + this->stats.detection.nonTargetsSpottedBy;
+			updated = true;
+		}
+
+		// Recorded
+		if (this->displayStats.recorded != this->stats.detection.onCamera) {
+			this->displayStats.recorded = this->stats.detection.onCamera;
+			updated = true;
+		}
+	}
+
+	if (hasAnyStatGroup(dirty, StatGroup::Bodies)) {
+		// Bodies Found
+		if (this->displayStats.bodiesFound != this->stats.bodies.found) {
+			this->displayStats.bodiesFound = this->stats.bodies.found;
+			updated = true;
+		}
+
+		// Bodies Hidden
+		if (this->displayStats.bodiesHidden != this->stats.bodies.hidden) {
+			this->displayStats.bodiesHidden = this->stats.bodies.hidden;
+			updated = true;
+		}
+
+		// Targets Found
+		const auto targetsFound = this->stats.bodies.targetsFound > 0;
+		if (this->displayStats.targetsFound != targetsFound) {
+			this->displayStats.targetsFound = targetsFound;
+			updated = true;
+		}
+	}
+
+	if (hasAnyStatGroup(dirty, StatGroup::Kills)) {
+		// Guard Kills
+		if (this->displayStats.guardKills != this->stats.kills.guard) {
+			this->displayStats.guardKills = this->stats.kills.guard;
+			updated = true;
+		}
+
+		// Civilian Kills
+		if (this->displayStats.civilianKills != this->stats.kills.civilian) {
+			this->displayStats.civilianKills = this->stats.kills.civilian;
+			updated = true;
+		}
+
+		// Noticed Kills
+		if (this->displayStats.noticedKills != this->stats.kills.noticed) {
+			this->displayStats.noticedKills = this->stats.kills.noticed;
+			updated = true;
+		}
+	}
+
+	// Witnesses
+	if (hasAnyStatGroup(dirty, StatGroup::Witnesses) && this->displayStats.witnesses != this->stats.witnesses.size()) {
+		this->displayStats.witnesses = static_cast<int>(this->stats.witnesses.size());
+		updated = true;
+	}
+
+	if (hasAnyStatGroup(dirty, StatGroup::Disguises)) {
+		// Disguises Taken
+		if (this->displayStats.disguisesTaken != this->stats.misc.disguisesTaken) {
+			this->displayStats.disguisesTaken = this->stats.misc.disguisesTaken;
+			updated = true;
+		}
+
+		// Disguises Blown
+		if (this->displayStats.disguisesBlown != this->stats.disguisesBlown.size()) {
+			this->displayStats.disguisesBlown = this->stats.disguisesBlown.size();
+			updated = true;
+		}
+	}
+
+	// Silent Assassin Status
+	if (hasAnyStatGroup(dirty, StatGroup::Kills | StatGroup::Witnesses | StatGroup::Detection | StatGroup::Bodies | StatGroup::Targets)) {
+		++this->displayCounters.silentAssassin;
+		auto sa = this->GetSilentAssassinStatus();
+
+		if (this->displayStats.silentAssassin != sa) {
+			this->displayStats.silentAssassin = sa;
+			updated = true;
+		}
+	}
+
+	// Stealth Rating - reads the display values above, so must come after them
+	if (hasAnyStatGroup(dirty, StatGroup::Kills | StatGroup::Witnesses | StatGroup::Detection | StatGroup::Bodies | StatGroup::Pacifies)) {
+		++this->displayCounters.stealthRating;
+		auto rating = this->CalculateStealthRating();
+		if (static_cast<int>(rating * 100) != static_cast<int>(this->displayStats.stealthRating * 100)) {
+			this->displayStats.stealthRating = rating;
+			updated = true;
+		}
+	}
+
+	// Play Style - weighs most of the stats, so any change can affect it
+	++this->displayCounters.playStyle;
+	auto playStyleRating = getPlayStyleRating(stats);
+	if (playStyleRating) {
+		if (playStyleRating != this->displayStats.playstyle.rating) {
+			std::uniform_int_distribution<size_t> rng(0, playStyleRating->getTitles().size() - 1);
+			this->displayStats.playstyle.rating = playStyleRating;
+			this->displayStats.playstyle.index = rng(this->randomGenerator);
+			updated = true;
+		}
+	}
+
+	return updated;
+}
+
+auto StatTracker::IsContractEnded() const -> bool {
+	return this->missionEndTime > 0;
+}
+
+auto StatTracker::SetupEvents() -> void {
+	// Helper to be called when a body found event is sent with a valid repo ID.
+	auto onRealBodyFound = [this](const WitnessEvent& ev) {
+		// Copies, as adding to the index below may move its IDs.
+		auto const bodyId = stats.npcs.getId(ev.body);
+		auto const witnessId = ev.witness != NPCIndex::None ? stats.npcs.getId(ev.witness) : RepoId();
+		auto const foundMurderedInfoIt = stats.bodies.foundMurderedInfos.find(bodyId);
+		auto const bodyAlreadyFound = foundMurderedInfoIt != stats.bodies.foundMurderedInfos.end();
+
+		// If already found, just keep track of target vs. non-target sightings.
+		if (bodyAlreadyFound) {
+			if (ev.isWitnessTarget) {
+				stats.targetBodyWitnesses.insert(stats.npcs.add(witnessId));
+			}
+			else if (!foundMurderedInfoIt->second.isSightedByNonTarget) {
+				foundMurderedInfoIt->second.isSightedByNonTarget = true;
+				++stats.bodies.foundMurderedByNonTarget;
+
+				// Get name of first NPC to find a body, replace target name with non target name
+				if (stats.firstBodyFoundByID.empty() && stats.firstBodyFoundWasByTarget) {
+					auto name = this->GetNPCName(witnessId);
+					if (name) {
+						stats.firstBodyFoundByID = witnessId;
+						stats.firstBodyFoundByName = *name;
+						stats.firstBodyFoundWasByTarget = ev.isWitnessTarget;
+					}
+				}
+			}
+
+			foundMurderedInfoIt->second.sightings.try_emplace(witnessId, ev.isWitnessTarget);
+			return;
+		}
+
+		// Increment these only when this body was not already found as an 'accident' body.
+		if (stats.bodies.uniqueBodiesFound.insert(ev.body)) {
+			if (this->IsRepoIdTargetNPC(bodyId))
+				++this->stats.bodies.targetsFound;
+			++stats.bodies.found;
+		}
+
+		// Even if body already found, this is the first time it's found 'murdered' (e.g. since dragging an already found accident body).
+		++stats.bodies.foundMurdered;
+
+		// Track target body witnesses so they may be compared against the number of target body witnesses killed for redeemable SA tracking.
+		if (ev.isWitnessTarget)
+			stats.targetBodyWitnesses.insert(stats.npcs.add(witnessId));
+		else
+			++stats.bodies.foundMurderedByNonTarget;
+
+		// Get name of first NPC to find a body
+		if (stats.firstBodyFoundByID.empty()) {
+			auto name = this->GetNPCName(witnessId);
+			if (name) {
+				stats.firstBodyFoundByID = witnessId;
+				stats.firstBodyFoundByName = *name;
+				stats.firstBodyFoundWasByTarget = ev.isWitnessTarget;
+			}
+		}
+
+		BodyStats::MurderedBodyFoundInfo bodyFoundInfo;
+		bodyFoundInfo.sightings.emplace(witnessId, ev.isWitnessTarget);
+		bodyFoundInfo.isSightedByNonTarget = !ev.isWitnessTarget;
+		stats.bodies.foundMurderedInfos.try_emplace(bodyId, std::move(bodyFoundInfo));
+	};
+	events.listen<Events::ContractStart>([this](const ServerEvent<Events::ContractStart>& ev) {
+		Logger::Info("ContractStart: {}", ev.Data);
+		this->NewContract();
+	});
+	events.listen<Events::ContractLoad>([this](auto& ev) {
+		this->NewContract();
+	});
+	events.listen<Events::ContractEnd>([this](const ServerEvent<Events::ContractEnd>& ev) {
+		if (this->IsContractEnded()) return;
+		this->missionEndTime = ev.Timestamp;
+	});
+	events.listen<Events::ExitGate>([this](const ServerEvent<Events::ExitGate>& ev) {
+		this->missionEndTime = ev.Timestamp;
+	});
+	events.listen<Events::IntroCutEnd>([this](const ServerEvent<Events::IntroCutEnd>& ev) {
+		this->cutsceneEndTime = ev.Timestamp;
+	});
+	events.listen<Events::AddSyndicateTarget>([this](const ServerEvent<Events::AddSyndicateTarget>& ev) {
+		this->AddTarget(ev.Value.repoID);
+	});
+	events.listen<Events::StartingSuit>([this](const ServerEvent<Events::StartingSuit>& ev) {
+		this->MarkDirty(StatGroup::Misc);
+		auto entry = this->GetRepoEntry(ev.Value.value);
+		if (entry) {
+			auto const isSuit = entry->isHitmanSuit;
+			stats.misc.startedInSuit = isSuit;
+			stats.current.inSuit = isSuit;
+		}
+	});
+	events.listen<Events::ItemPickedUp>([this](const ServerEvent<Events::ItemPickedUp>& ev) {
+		if (this->IsContractEnded()) return;
+		this->MarkDirty(StatGroup::Items);
+		// TODO: bit of a hacky workaround to fix Freelancer loadout items counting as picked up
+		// ignore any items picked up in the first 3 seconds (+ compensate for cutscene length)
+		auto time = ev.Timestamp;
+		time -= this->cutsceneEndTime;
+
+		if (time > 3.0) {
+			auto it = stats.itemsObtained.find(ev.Value.RepositoryId);
+			if (it != stats.itemsObtained.end()) {
+				++it->second.count;
+			}
+			else {
+				auto item = this->CreateItemInfo(ev.Value.RepositoryId);
+				if (item.type != ItemInfoType::None)
+					stats.itemsObtained.emplace(ev.Value.RepositoryId, item);
+			}
+		}
+	});
+	events.listen<Events::ItemDropped>([this](const ServerEvent<Events::ItemDropped>& ev) {
+		if (this->IsContractEnded()) return;
+		this->MarkDirty(StatGroup::Items);
+		++stats.misc.itemsDropped;
+
+		auto& id = ev.Value.RepositoryId;
+		if (!id.empty()) {
+			this->RemoveObtainedItem(id);
+			auto item = this->CreateItemInfo(id);
+			this->AddDisposedItem(id, item);
+		}
+	});
+	events.listen<Events::ItemThrown>([this](const ServerEvent<Events::ItemThrown>& ev) {
+		if (this->IsContractEnded()) return;
+		this->MarkDirty(StatGroup::Items);
+		// inventory removal handled in ItemRemovedFromInventory
+		++stats.misc.itemsThrown;
+
+		auto item = this->CreateItemInfo(ev.Value.RepositoryId);
+		this->AddDisposedItem(ev.Value.RepositoryId, item);
+	});
+	events.listen<Events::ItemRemovedFromInventory>([this](const ServerEvent<Events::ItemRemovedFromInventory>& ev) {
+		if (this->IsContractEnded()) return;
+		this->MarkDirty(StatGroup::Items);
+		++stats.misc.itemsRemovedFromInventory;
+		this->RemoveObtainedItem(ev.Value.RepositoryId);
+	});
+	events.listen<Events::FirstNonHeadshot>([this](const ServerEvent<Events::FirstNonHeadshot>& ev) {
+		// TODO: ?
+	});
+	events.listen<Events::FirstMissedShot>([this](const ServerEvent<Events::FirstMissedShot>& ev) {
+		// TODO: ?
+	});
+	events.listen<Events::Actorsick>([this](const ServerEvent<Events::Actorsick>& ev) {
+		if (this->IsContractEnded()) return;
+		this->MarkDirty(StatGroup::Misc);
+		if (ev.Value.IsTarget) ++stats.misc.targetsMadeSick;
+		// Only parse the ID while tracing.
+		if (Trace::isEnabled())
+			Trace::push(TraceRecord::actorSick(ev.Timestamp, RepoId(ev.Value.actor_R_ID), ev.Value.IsTarget, static_cast<int32_t>(ev.Value.ActorType)));
+	});
+	events.listen<Events::Trespassing>([this](const ServerEvent<Events::Trespassing>& ev) {
+		if (this->IsContractEnded()) return;
+		this->MarkDirty(StatGroup::Misc);
+
+		stats.current.trespassing = ev.Value.IsTrespassing;
+		if (stats.current.trespassing) {
+			stats.trespassStartTime = ev.Timestamp;
+			++stats.misc.timesTrespassed;
+		} else {
+			stats.misc.trespassTime += ev.Timestamp - stats.trespassStartTime;
+		}
+	});
+	events.listen<Events::SecuritySystemRecorder>([this](const ServerEvent<Events::SecuritySystemRecorder>& ev) {
+		if (this->IsContractEnded()) return;
+		this->MarkDirty(StatGroup::Detection | StatGroup::Misc);
+
+		bool destroyed = false;
+		switch (ev.Value.event) {
+			case SecuritySystemRecorderEvent::Spotted:
+				stats.detection.onCamera = true;
+				break;
+			case SecuritySystemRecorderEvent::Destroyed:
+				destroyed = true;
+				stats.misc.recorderDestroyed = true;
+				[[fallthrough]];
+			case SecuritySystemRecorderEvent::Erased:
+				if (stats.detection.onCamera) stats.misc.recordedThenErased = true;
+				stats.detection.onCamera = false;
+				if (!destroyed && !this->stats.misc.recorderDestroyed)
+					stats.misc.recorderErased = true;
+				break;
+			case SecuritySystemRecorderEvent::CameraDestroyed:
+				++stats.misc.camerasDestroyed;
+				break;
+		}
+	});
+	events.listen<Events::Agility_Start>([this](const ServerEvent<Events::Agility_Start>& ev) {
+		this->MarkDirty(StatGroup::Misc);
+		++stats.misc.agilityActions;
+	});
+	events.listen<Events::Drain_Pipe_Climbed>([this](const ServerEvent<Events::Drain_Pipe_Climbed>& ev) {
+		this->MarkDirty(StatGroup::Misc);
+		++stats.misc.agilityActions;
+	});
+	events.listen<Events::HoldingIllegalWeapon>([this](const ServerEvent<Events::HoldingIllegalWeapon>& ev) {
+		if (this->IsContractEnded()) return;
+		this->MarkDirty(StatGroup::Misc);
+
+		if (stats.current.holdingIllegalWeapon != ev.Value.IsHoldingIllegalWeapon) {
+			stats.weaponHoldingStartTime = ev.Timestamp;
+			++stats.misc.timesTrespassed;
+		} else {
+			stats.misc.weaponHoldingTime += ev.Timestamp - stats.weaponHoldingStartTime;
+		}
+
+		stats.current.holdingIllegalWeapon = ev.Value.IsHoldingIllegalWeapon;
+	});
+	// TODO: The game can send 0'd repository IDs for dead bodies in certain situations.
+	// This makes it difficult to uniquely identify bodies to keep count of bodies found.
+	// IsCrowdActor is also usually true when this happens. Seemingly the game always
+	// eventually sends other body found events with correct IDs. Need a good solution
+	// to link these events to reliably obtain the necessary information.
+	events.listen<Events::AccidentBodyFound>([this](const ServerEvent<Events::AccidentBodyFound>& ev) {
+		auto const& body = ev.Value.DeadBody;
+		Trace::record(TraceRecord::bodyFound(TraceEvent::AccidentBodyFound, ev.Timestamp, body.RepositoryId, body.IsCrowdActor, static_cast<int32_t>(body.DeathContext), static_cast<int32_t>(body.DeathType)));
+		if (this->IsContractEnded()) return;
+		this->MarkDirty(StatGroup::Bodies);
+
+		const auto& bodyId = ev.Value.DeadBody.RepositoryId;
+
+		// Count only if this body is found for the first time, and ensure we don't double count if the body gets dragged and found again.
+		if (stats.bodies.uniqueBodiesFound.insert(stats.npcs.add(bodyId))) {
+			if (this->IsRepoIdTargetNPC(bodyId))
+				++stats.bodies.targetsFound;
+
+			++stats.bodies.found;
+			++stats.bodies.foundAccidents;
+		}
+	});
+	events.listen<Events::DeadBodySeen>([this](const ServerEvent<Events::DeadBodySeen>& ev) {
+		// Only parse the ID while tracing.
+		if (Trace::isEnabled())
+			Trace::push(TraceRecord::deadBodySeen(ev.Timestamp, RepoId(ev.Value.value)));
+		if (this->IsContractEnded()) return;
+		this->MarkDirty(StatGroup::Bodies);
+		++stats.bodies.deadSeen;
+	});
+	events.listen<Events::MurderedBodySeen>([this, onRealBodyFound](const ServerEvent<Events::MurderedBodySeen>& ev) {
+		Trace::record(TraceRecord::murderedBodySeen(ev.Timestamp, ev.Value.DeadBody.RepositoryId, ev.Value.Witness, ev.Value.DeadBody.IsCrowdActor, ev.Value.IsWitnessTarget));
+		if (this->IsContractEnded()) return;
+		this->MarkDirty(StatGroup::Bodies);
+
+		auto const& value = ev.Value;
+		auto const& deadBody = value.DeadBody;
+		auto const deadBodyId = deadBody.IsCrowdActor ? RepoId() : deadBody.RepositoryId;
+
+		auto const& witnessEvent = stats.witnessEvents.add(WitnessEvent{
+			.timestamp = ev.Timestamp,
+			.event = Events::MurderedBodySeen,
+			.isWitnessTarget = value.IsWitnessTarget,
+			.witness = this->InternNPC(value.Witness),
+			.body = this->InternNPC(deadBodyId),
+		});
+
+		if (!deadBodyId.empty()) onRealBodyFound(witnessEvent);
+	});
+	events.listen<Events::BodyFound>([this, onRealBodyFound](const ServerEvent<Events::BodyFound>& ev) {
+		auto const& body = ev.Value.DeadBody;
+		Trace::record(TraceRecord::bodyFound(TraceEvent::BodyFound, ev.Timestamp, body.RepositoryId, body.IsCrowdActor, static_cast<int32_t>(body.DeathContext), static_cast<int32_t>(body.DeathType)));
+		this->MarkDirty(StatGroup::Bodies);
+
+		auto const& id = ev.Value.DeadBody.RepositoryId;
+
+		if (ev.Value.DeadBody.IsCrowdActor) {
+			if (this->IsContractEnded()) return;
+			++stats.bodies.foundCrowd;
+		}
+		else {
+			// The sightings sent along with this event, newest first. Timestamps are compared exactly, which is fine as the
+			// game gives the events of one sighting the same one.
+			auto const sightings = stats.witnessEvents.getLatest(ev.Timestamp);
+			for (auto it = sightings.rbegin(); it != sightings.rend(); ++it) {
+				if (it->event != Events::MurderedBodySeen) continue;
+				if (it->body != NPCIndex::None) continue;
+				it->body = stats.npcs.add(id);
+				onRealBodyFound(*it);
+			}
+		}
+	});
+	events.listen<Events::Disguise>([this](const ServerEvent<Events::Disguise>& ev) {
+		this->MarkDirty(StatGroup::Disguises);
+		++stats.misc.disguisesTaken;
+		stats.misc.suitRetrieved = false;
+
+		auto entry = this->GetRepoEntry(ev.Value.value);
+		if (entry) {
+			if (entry->isHitmanSuit) stats.misc.suitRetrieved = true;
+		}
+	});
+	events.listen<Events::SituationContained>([this](const ServerEvent<Events::SituationContained>& ev) {
+		this->MarkDirty(StatGroup::Detection);
+		++stats.detection.situationsContained;
+	});
+	events.listen<Events::TargetBodySpotted>([this](const ServerEvent<Events::TargetBodySpotted>& ev) {
+		if (this->IsContractEnded()) return;
+		this->MarkDirty(StatGroup::Bodies);
+		++stats.bodies.targetsFound;
+	});
+	events.listen<Events::BodyHidden>([this](const ServerEvent<Events::BodyHidden>& ev) {
+		if (this->IsContractEnded()) return;
+		this->MarkDirty(StatGroup::Bodies);
+		++stats.bodies.hidden;
+	});
+	events.listen<Events::BodyBagged>([this](const ServerEvent<Events::BodyBagged>& ev) {
+		if (this->IsContractEnded()) return;
+		this->MarkDirty(StatGroup::Bodies);
+		++stats.bodies.bagged;
+	});
+	events.listen<Events::AllBodiesHidden>([this](const ServerEvent<Events::AllBodiesHidden>& ev) {
+		if (this->IsContractEnded()) return;
+		this->MarkDirty(StatGroup::Bodies);
+		stats.bodies.allHidden = true;
+	});
+	events.listen<Events::ShotsFired>([this](const ServerEvent<Events::ShotsFired>& ev) {
+		this->MarkDirty(StatGroup::Misc);
+		// not much we can do without a live update?
+		stats.misc.shotsFired = ev.Value.Total;
+	});
+	events.listen<Events::Spotted>([this](const ServerEvent<Events::Spotted>& ev) {
+		if (this->IsContractEnded()) return;
+		this->MarkDirty(StatGroup::Detection);
+
+		for (const auto& name : ev.Value.added) {
+			auto const npc = stats.npcs.add(name);
+			auto const isTarget = stats.targetNPCs.contains(npc);
+
+			if (!stats.spottedBy.contains(npc)) {
+				Logger::Info("Stealthometer: spotted by {} - Target: {}", name.toString(), isTarget);
+
+				if (stats.firstSpottedByName.empty()) {
+					auto realName = this->GetNPCName(name);
+					if (realName) {
+						stats.firstSpottedByID = name;
+						stats.firstSpottedByName = *realName;
+					}
+				}
+
+				++stats.detection.spotted;
+				stats.spottedBy.insert(npc);
+				stats.silentAssassin.addSpotter(npc);
+
+				if (isTarget) {
+					// It's possible for the spotted event to fire right AFTER the target died. Handle this dumb edge case.
+					if (stats.kills.targets.contains(npc)) continue;
+
+					stats.targetsSpottedBy.insert(npc);
+				}
+
+				stats.detection.nonTargetsSpottedBy = static_cast<int>(stats.spottedBy.size()) - stats.targetsSpottedBy.size();
+			}
+		}
+	});
+	events.listen<Events::Witnesses>([this](const ServerEvent<Events::Witnesses>& ev) {
+		if (this->IsContractEnded()) return;
+		this->MarkDirty(StatGroup::Witnesses);
+
+		for (const auto& name : ev.Value.added) {
+			auto const npc = stats.npcs.add(name);
+
+			// It's possible for the witnesses event to fire right AFTER the NPC died. Handle this dumb edge case.
+			if (stats.kills.targets.contains(npc) || stats.kills.nonTargets.contains(npc)) continue;
+
+			if (stats.witnesses.insert(npc))
+				stats.silentAssassin.addWitness(npc);
+		}
+	});
+	events.listen<Events::DisguiseBlown>([this](const ServerEvent<Events::DisguiseBlown>& ev) {
+		if (this->IsContractEnded()) return;
+		this->MarkDirty(StatGroup::Disguises);
+
+		stats.current.disguiseBlown = true;
+		stats.disguisesBlown.insert(ev.Value.value);
+	});
+	events.listen<Events::BrokenDisguiseCleared>([this](const ServerEvent<Events::BrokenDisguiseCleared>& ev) {
+		if (this->IsContractEnded()) return;
+		this->MarkDirty(StatGroup::Disguises);
+
+		stats.current.disguiseBlown = false;
+		stats.disguisesBlown.erase(ev.Value.value);
+	});
+	events.listen<Events::_47_FoundTrespassing>([this](const ServerEvent<Events::_47_FoundTrespassing>& ev) {
+		if (this->IsContractEnded()) return;
+		this->MarkDirty(StatGroup::Detection);
+
+		++stats.detection.caughtTrespassing;
+	});
+	events.listen<Events::TargetEliminated>([this](const ServerEvent<Events::TargetEliminated>& ev) {
+		//++stats.kills.targets; // is this event sent in all target kill cases?
+	});
+	events.listen<Events::Door_Unlocked>([this](const ServerEvent<Events::Door_Unlocked>& ev) {
+		if (this->IsContractEnded()) return;
+		this->MarkDirty(StatGroup::Misc);
+
+		++stats.misc.doorsUnlocked;
+	});
+	events.listen<Events::CrowdNPC_Died>([this](const ServerEvent<Events::CrowdNPC_Died>& ev) {
+		if (this->IsContractEnded()) return;
+		this->MarkDirty(StatGroup::Kills);
+
+		++stats.kills.total;
+		++stats.kills.crowd;
+		++stats.kills.civilian;
+	});
+	events.listen<Events::NoticedKill>([this](const ServerEvent<Events::NoticedKill>& ev) {
+		if (this->IsContractEnded()) return;
+		this->MarkDirty(StatGroup::Kills);
+
+		Trace::record(TraceRecord::noticedKill(ev.Timestamp, ev.Value.RepositoryId, ev.Value.IsTarget));
+
+		// TODO:
+		//ev.Value.RepositoryId
+		//ev.Value.IsTarget
+		auto const& value = ev.Value;
+		auto const noticedKillInfoIt = stats.kills.noticedKillInfos.find(value.RepositoryId);
+		auto const killAlreadyNoticed = noticedKillInfoIt != stats.kills.noticedKillInfos.end();
+		auto const killAlreadyNoticedByNonTarget = killAlreadyNoticed && noticedKillInfoIt->second.isSightedByNonTarget;
+		auto witness = NPCIndex::None;
+
+		auto const sightings = stats.witnessEvents.getLatest(ev.Timestamp);
+		for (auto it = sightings.rbegin(); it != sightings.rend(); ++it) {
+			if (it->witness != NPCIndex::None) {
+				witness = it->witness;
+				break;
+			}
+		}
+
+		stats.witnessEvents.add(WitnessEvent{
+			.timestamp = ev.Timestamp,
+			.event = Events::NoticedKill,
+			.witness = witness,
+			.body = this->InternNPC(value.RepositoryId),
+		});
+
+		if (killAlreadyNoticed) {
+			if (value.IsTarget) {
+				//stats.targetKillNoticers.emplace(value.)
+			}
+		}
+
+		++stats.kills.noticed;
+	});
+	events.listen<Events::Noticed_Pacified>([this](const ServerEvent<Events::Noticed_Pacified>& ev) {
+		if (this->IsContractEnded()) return;
+		this->MarkDirty(StatGroup::Pacifies);
+
+		// TODO:
+		//ev.Value.RepositoryId
+		//ev.Value.IsTarget
+		++stats.pacifies.noticed;
+	});
+	events.listen<Events::Unnoticed_Kill>([this](const ServerEvent<Events::Unnoticed_Kill>& ev) {
+		this->MarkDirty(StatGroup::Kills);
+		// TODO: ?
+		//ev.Value.RepositoryId
+		++stats.kills.unnoticed;
+		if (ev.Value.IsTarget)
+			++stats.kills.unnoticedTarget;
+		else
+			++stats.kills.unnoticedNonTarget;
+	});
+	events.listen<Events::Unnoticed_Pacified>([this](const ServerEvent<Events::Unnoticed_Pacified>& ev) {
+		this->MarkDirty(StatGroup::Pacifies);
+		// TODO: ?
+		//ev.Value.RepositoryId
+		++stats.pacifies.unnoticed;
+		if (!ev.Value.IsTarget)
+			++stats.pacifies.unnoticedNonTarget;
+	});
+	events.listen<Events::AmbientChanged>([this](const ServerEvent<Events::AmbientChanged>& ev) {
+		if (this->IsContractEnded()) return;
+		this->MarkDirty(StatGroup::Tension);
+
+		stats.current.tension = ev.Value.AmbientValue;
+
+		switch (ev.Value.AmbientValue) {
+		case EGameTension::EGT_Agitated:
+			Logger::Debug("Game tension: agitated - it actually happened!");
+			++stats.tension.agitated;
+			break;
+		case EGameTension::EGT_AlertedHigh:
+			++stats.tension.alertedHigh;
+			break;
+		case EGameTension::EGT_AlertedLow:
+			++stats.tension.alertedLow;
+			break;
+		case EGameTension::EGT_Arrest:
+			++stats.tension.arrest;
+			break;
+		case EGameTension::EGT_Combat:
+			++stats.tension.combat;
+			break;
+		case EGameTension::EGT_Hunting:
+			++stats.tension.hunting;
+			break;
+		case EGameTension::EGT_Searching:
+			++stats.tension.searching;
+			break;
+		}
+
+		if (isTensionHigher(ev.Value.PreviousAmbientValue, ev.Value.AmbientValue))
+			stats.tension.level += getTensionValue(ev.Value.AmbientValue) - getTensionValue(ev.Value.PreviousAmbientValue);
+	});
+	events.listen<Events::Pacify>([this](const ServerEvent<Events::Pacify>& ev) {
+		if (this->IsContractEnded()) return;
+		this->MarkDirty(StatGroup::Pacifies | StatGroup::Bodies);
+
+		stats.bodies.allHidden = false;
+		++stats.pacifies.total;
+
+		if (ev.Value.IsTarget) stats.bodies.allTargetsHidden = false;
+		else ++stats.pacifies.nonTargets;
+
+		if (ev.Value.Accident) stats.pacifyMethods.add(KillMethod::Accident);
+		if (ev.Value.KillClass == KillClass::Melee) stats.pacifyMethods.add(KillMethod::Melee);
+		if (ev.Value.KillMethodBroad == KillMethodBroad::Throw) stats.pacifyMethods.add(KillMethod::Thrown);
+
+		if (!ev.Value.IsTarget) {
+			if (ev.Value.ActorType == EActorType::eAT_Civilian) ++stats.pacifies.civilian;
+			else if (ev.Value.ActorType == EActorType::eAT_Guard) ++stats.pacifies.guard;
+		}
+	});
+	events.listen<Events::Kill>([this](const ServerEvent<Events::Kill>& ev) {
+		if (this->IsContractEnded()) return;
+		this->MarkDirty(StatGroup::Kills | StatGroup::Bodies | StatGroup::Detection | StatGroup::Witnesses);
+
+		const auto& repoId = ev.Value.RepositoryId;
+		const auto isTarget = ev.Value.IsTarget;
+		const auto npc = stats.npcs.add(repoId);
+
+		stats.bodies.allHidden = false;
+		++stats.kills.total;
+
+		if (repoId == stats.firstSpottedByID) {
+			stats.firstSpottedByID = RepoId();
+			stats.firstSpottedByName = "";
+		}
+		if (repoId == stats.firstBodyFoundByID) {
+			stats.firstBodyFoundByID = RepoId();
+			stats.firstBodyFoundByName = "";
+		}
+
+		if (isTarget) {
+			if (stats.kills.targets.insert(npc)) {
+				stats.silentAssassin.exclude(npc, stats.witnesses.contains(npc), stats.spottedBy.contains(npc));
+
+				if (stats.targetsSpottedBy.contains(npc)) {
+					++stats.detection.targetsSpottedByAndKilled;
+					++stats.detection.uniqueNPCsCaughtByAndKilled;
+				}
+				else if (stats.spottedBy.contains(npc)) {
+					stats.targetsSpottedBy.insert(npc);
+					++stats.detection.targetsSpottedByAndKilled;
+					++stats.detection.uniqueNPCsCaughtByAndKilled;
+				}
+
+				if (stats.targetBodyWitnesses.contains(npc))
+					++stats.bodies.targetBodyWitnessesKilled;
+			}
+		}
+		else if (ev.Value.KillContext == EDeathContext::eDC_NOT_HERO)
+			stats.kills.proxyDeaths.emplace(repoId);
+		else {
+			if (stats.kills.nonTargets.insert(npc)) {
+				stats.silentAssassin.exclude(npc, stats.witnesses.contains(npc), stats.spottedBy.contains(npc));
+
+				if (ev.Value.ActorType == EActorType::eAT_Civilian) ++stats.kills.civilian;
+				if (ev.Value.ActorType == EActorType::eAT_Guard) ++stats.kills.guard;
+
+				if (stats.spottedBy.contains(npc))
+					++stats.detection.uniqueNPCsCaughtByAndKilled;
+			}
+
+			if (stats.firstNTKName.empty() && stats.firstNTKID != repoId) {
+				stats.firstNTKID = repoId;
+				auto name = this->GetNPCName(repoId);
+				if (name) {
+					stats.firstNTKName = *name;
+				}
+			}
+		}
+
+		auto& methods = stats.killMethods;
+		if (ev.Value.IsHeadshot) methods.add(KillMethod::Headshot, isTarget);
+		if (ev.Value.KillClass == KillClass::Melee) methods.add(KillMethod::Melee, isTarget);
+		methods.add(getKillMethod(ev.Value.KillMethodBroad), isTarget);
+
+		if (ev.Value.Accident) {
+			methods.add(KillMethod::Accident, isTarget);
+			methods.add(getKillMethod(ev.Value.KillMethodStrict), isTarget);
+
+			if (ev.Value.KillMethodStrict == KillMethodStrict::Other)
+				Logger::Info("Stealthometer: Unhandled KillMethodStrict in {}", ev.Data);
+		}
+
+		if (ev.Value.WeaponSilenced) methods.add(KillMethod::SilencedWeapon, isTarget);
+
+		if (stats.witnesses.erase(npc)) {
+			stats.silentAssassin.removeWitness(npc);
+			++stats.detection.witnessesKilled;
+		}
+	});
+	events.listen<Events::setpieces>([this](const ServerEvent<Events::setpieces>& ev) {
+		// Photo taken
+		// {"Timestamp":14.068766,"Name":"setpieces","ContractSessionId":"2517189686363575049-c894c9d2-b984-4c5b-ad0a-2be27e3b04f5","ContractId":"d2419fe4-ea72-4e61-b91b-bb39706f551d","Value":{"RepositoryId":"6c3fa06e-7478-4484-81e6-f08dba1722eb","name_metricvalue":"NotAvailable","setpieceHelper_metricvalue":"Camera","setpieceType_metricvalue":"picturetaken","toolUsed_metricvalue":"NA","Item_triggered_metricvalue":"NA","Position":"ZDynamicObject::ToString() unknown type: SVector3"},"UserId":"b1585b4d-36f0-48a0-8ffa-1b72f01759da","SessionId":"61e82efa0bcb4a3088825dd75e115f61-2846824114","Origin":"gameclient","Id":"971f62e0-e3d9-4ad3-8c16-bfc7fd2fa8a8"}
+
+		// Reporter camera destroyed
+		// {"Timestamp":405.325409,"Name":"ItemDestroyed","ContractSessionId":"64e8780e-00bb-45d1-a270-ff1df03082de","ContractId":"00000000-0000-0000-0000-000000000200","Value":{"ItemName":"ActItem_Camera"},"UserId":"00000000-0000-0000-0000-000000000000","SessionId":"","Origin":"gameclient","Id":"9ce9fbf2-e001-42cc-a715-9bae8423285d"}
+
+		// Look at evacuation plan in Paris, basement security room
+		// { "Timestamp":1030.322388, "Name" : "setpieces", "ContractSessionId" : "64e8780e-00bb-45d1-a270-ff1df03082de", "ContractId" : "00000000-0000-0000-0000-000000000200", "Value" : {"RepositoryId":"7093201b-ff82-465f-a187-7245d9057954", "name_metricvalue" : "Paris_Evac_plan", "setpieceHelper_metricvalue" : "Activator_NoTool", "setpieceType_metricvalue" : "DefaultActivators", "toolUsed_metricvalue" : "NA", "Item_triggered_metricvalue" : "NotAvailable", "Position" : "ZDynamicObject::ToString() unknown type: SVector3"}, "UserId" : "00000000-0000-0000-0000-000000000000", "SessionId" : "", "Origin" : "gameclient", "Id" : "bfabe0cf-cb92-4918-a716-b708f3fdc615" }
+		// { "Timestamp":1030.836670, "Name" : "setpieces", "ContractSessionId" : "64e8780e-00bb-45d1-a270-ff1df03082de", "ContractId" : "00000000-0000-0000-0000-000000000200", "Value" : {"RepositoryId":"7093201b-ff82-465f-a187-7245d9057954", "name_metricvalue" : "Paris_Evac_plan", "setpieceHelper_metricvalue" : "Activator_NoTool", "setpieceType_metricvalue" : "DefaultActivators", "toolUsed_metricvalue" : "NA", "Item_triggered_metricvalue" : "NotAvailable", "Position" : "ZDynamicObject::ToString() unknown type: SVector3"}, "UserId" : "00000000-0000-0000-0000-000000000000", "SessionId" : "", "Origin" : "gameclient", "Id" : "39f70b5d-8689-47bd-a765-a73067bd737d" }
+			
+		// Piano lid pushed down
+		// {"Timestamp":75.528625,"Name":"setpieces","ContractSessionId":"64e8780e-00bb-45d1-a270-ff1df03082de","ContractId":"00000000-0000-0000-0000-000000000200","Value":{"RepositoryId":"db6a820c-22ea-496e-a0f2-6823b32a911d","name_metricvalue":"Trap_Piano","setpieceHelper_metricvalue":"Activator_NoTool","setpieceType_metricvalue":"DefaultActivators","toolUsed_metricvalue":"NA","Item_triggered_metricvalue":"NotAvailable","Position":"ZDynamicObject::ToString() unknown type: SVector3"},"UserId":"00000000-0000-0000-0000-000000000000","SessionId":"","Origin":"gameclient","Id":"7260ec0d-98da-4aa1-b2e5-e2ad74d18db3"}
+		// { "Timestamp":75.629402, "Name" : "setpieces", "ContractSessionId" : "64e8780e-00bb-45d1-a270-ff1df03082de", "ContractId" : "00000000-0000-0000-0000-000000000200", "Value" : {"RepositoryId":"db6a820c-22ea-496e-a0f2-6823b32a911d", "name_metricvalue" : "Trap_Piano", "setpieceHelper_metricvalue" : "Activator_NoTool", "setpieceType_metricvalue" : "DefaultActivators", "toolUsed_metricvalue" : "NA", "Item_triggered_metricvalue" : "NotAvailable", "Position" : "ZDynamicObject::ToString() unknown type: SVector3"}, "UserId" : "00000000-0000-0000-0000-000000000000", "SessionId" : "", "Origin" : "gameclient", "Id" : "0fdcc023-01f6-4a15-b2f5-2c786ddf47fe" }
+		// { "Timestamp":76.096695, "Name" : "setpieces", "ContractSessionId" : "64e8780e-00bb-45d1-a270-ff1df03082de", "ContractId" : "00000000-0000-0000-0000-000000000200", "Value" : {"RepositoryId":"ab388850-d6cc-4e5c-a4a2-76bb22ca8f73", "name_metricvalue" : "NotAvailable", "setpieceHelper_metricvalue" : "DistractionLogic", "setpieceType_metricvalue" : "DistractionTriggered", "toolUsed_metricvalue" : "NA", "Item_triggered_metricvalue" : "NotAvailable", "Position" : "ZDynamicObject::ToString() unknown type: SVector3"}, "UserId" : "00000000-0000-0000-0000-000000000000", "SessionId" : "", "Origin" : "gameclient", "Id" : "26758af1-b9f6-4892-b33c-644bf2522a02" }
+
+		// Loudspeaker shot down
+		// {"Timestamp":110.426361,"Name":"setpieces","ContractSessionId":"64e8780e-00bb-45d1-a270-ff1df03082de","ContractId":"00000000-0000-0000-0000-000000000200","Value":{"RepositoryId":"2d7a91b9-1b3a-4db3-a8bf-6249db70c339","name_metricvalue":"Loudspeaker","setpieceHelper_metricvalue":"SuspendedObject","setpieceType_metricvalue":"trap","toolUsed_metricvalue":"NA","Item_triggered_metricvalue":"NA","Position":"ZDynamicObject::ToString() unknown type: SVector3"},"UserId":"00000000-0000-0000-0000-000000000000","SessionId":"","Origin":"gameclient","Id":"744fbb86-b8d1-47e0-b206-fa79b80b259f"}
+
+		// Car blown up
+		// {"Timestamp":340.653961,"Name":"setpieces","ContractSessionId":"64e8780e-00bb-45d1-a270-ff1df03082de","ContractId":"00000000-0000-0000-0000-000000000200","Value":{"RepositoryId":"2b29d641-2a0d-4781-b2dd-0df02bc2674b","name_metricvalue":"NotAvailable","setpieceHelper_metricvalue":"PropHelper_Explosion","setpieceType_metricvalue":"trap","toolUsed_metricvalue":"Exploded","Item_triggered_metricvalue":"NotAvailable","Position":"ZDynamicObject::ToString() unknown type: SVector3"},"UserId":"00000000-0000-0000-0000-000000000000","SessionId":"","Origin":"gameclient","Id":"1233f4a1-fafc-43db-a746-972af85d28dc"}
+
+		// Fuse box turned off
+		// {"Timestamp":35.705559,"Name":"setpieces","ContractSessionId":"3b541fce-5498-42bd-b853-b07526a07593","ContractId":"00000000-0000-0000-0000-000000000200","Value":{"RepositoryId":"e29d8ce5-64d6-4207-a55d-ebe5e84b16b3","name_metricvalue":"NotAvailable","setpieceHelper_metricvalue":"Activator_NoTool","setpieceType_metricvalue":"DefaultActivators","toolUsed_metricvalue":"NA","Item_triggered_metricvalue":"NotAvailable","Position":"ZDynamicObject::ToString() unknown type: SVector3"},"UserId":"00000000-0000-0000-0000-000000000000","SessionId":"","Origin":"gameclient","Id":"72ea0e72-4c48-4980-9341-c07c5000b7d4"}
+		// { "Timestamp":35.839172, "Name" : "setpieces", "ContractSessionId" : "3b541fce-5498-42bd-b853-b07526a07593", "ContractId" : "00000000-0000-0000-0000-000000000200", "Value" : {"RepositoryId":"e29d8ce5-64d6-4207-a55d-ebe5e84b16b3", "name_metricvalue" : "NotAvailable", "setpieceHelper_metricvalue" : "Activator_NoTool", "setpieceType_metricvalue" : "DefaultActivators", "toolUsed_metricvalue" : "NA", "Item_triggered_metricvalue" : "NotAvailable", "Position" : "ZDynamicObject::ToString() unknown type: SVector3"}, "UserId" : "00000000-0000-0000-0000-000000000000", "SessionId" : "", "Origin" : "gameclient", "Id" : "88fc03bf-2fc4-466d-9356-1c74210cace4" }
+
+		// Blown up propane:
+		// {"Timestamp":136.863831,"Name":"setpieces","ContractSessionId":"2517213287667595942-d688bab6-034a-488b-a483-89cfac74656f","ContractId":"00000000-0000-0000-0000-000000000400","Value":{"RepositoryId":"2b29d641-2a0d-4781-b2dd-0df02bc2674b","name_metricvalue":"PropaneFlask","setpieceHelper_metricvalue":"PropHelper_Explosion","setpieceType_metricvalue":"trap","toolUsed_metricvalue":"Exploded","Item_triggered_metricvalue":"NotAvailable","Position":"ZDynamicObject::ToString() unknown type: SVector3"},"UserId":"b1585b4d-36f0-48a0-8ffa-1b72f01759da","SessionId":"61e82efa0bcb4a3088825dd75e115f61-2714020697","Origin":"gameclient","Id":"4dcd73fe-7d2c-443b-aeac-10cd279ec971"}
+
+		// Flooded sink:
+		// {"Timestamp":219.718857,"Name":"setpieces","ContractSessionId":"01e7cfb4-0c1d-4d6e-99dc-9a604f9e1be0","ContractId":"00000000-0000-0000-0000-000000000200","Value":{"RepositoryId":"95e7e530-dbd0-4e1a-95f6-8d5c165a7991","name_metricvalue":"NotAvailable","setpieceHelper_metricvalue":"Activator_NoTool","setpieceType_metricvalue":"DefaultActivators","toolUsed_metricvalue":"NA","Item_triggered_metricvalue":"NotAvailable","Position":"ZDynamicObject::ToString() unknown type: SVector3"},"UserId":"00000000-0000-0000-0000-000000000000","SessionId":"","Origin":"gameclient","Id":"c9b351ed-80ac-47c9-a73d-9fcd61c49ca5"}
+		// { "Timestamp":220.185089, "Name" : "setpieces", "ContractSessionId" : "01e7cfb4-0c1d-4d6e-99dc-9a604f9e1be0", "ContractId" : "00000000-0000-0000-0000-000000000200", "Value" : {"RepositoryId":"95e7e530-dbd0-4e1a-95f6-8d5c165a7991", "name_metricvalue" : "NotAvailable", "setpieceHelper_metricvalue" : "Activator_NoTool", "setpieceType_metricvalue" : "DefaultActivators", "toolUsed_metricvalue" : "NA", "Item_triggered_metricvalue" : "NotAvailable", "Position" : "ZDynamicObject::ToString() unknown type: SVector3"}, "UserId" : "00000000-0000-0000-0000-000000000000", "SessionId" : "", "Origin" : "gameclient", "Id" : "e40d4a1c-5c02-4431-a784-b0e944cf7ae4" }
+		// { "Timestamp":224.197235, "Name" : "setpieces", "ContractSessionId" : "01e7cfb4-0c1d-4d6e-99dc-9a604f9e1be0", "ContractId" : "00000000-0000-0000-0000-000000000200", "Value" : {"RepositoryId":"3678cc55-c327-4e79-ab1b-52553c58ec83", "name_metricvalue" : "NotAvailable", "setpieceHelper_metricvalue" : "DistractionLogic", "setpieceType_metricvalue" : "DistractionTriggered", "toolUsed_metricvalue" : "NA", "Item_triggered_metricvalue" : "NotAvailable", "Position" : "ZDynamicObject::ToString() unknown type: SVector3"}, "UserId" : "00000000-0000-0000-0000-000000000000", "SessionId" : "", "Origin" : "gameclient", "Id" : "97285361-ceb7-4f3c-a9e9-0e4352aa70c8" }
+			
+		// Shot down Shisha sign:
+		// {"Timestamp":6.376209,"Name":"setpieces","ContractSessionId":"2517213287667595942-d688bab6-034a-488b-a483-89cfac74656f","ContractId":"00000000-0000-0000-0000-000000000400","Value":{"RepositoryId":"2d7a91b9-1b3a-4db3-a8bf-6249db70c339","name_metricvalue":"\n\n","setpieceHelper_metricvalue":"SuspendedObject","setpieceType_metricvalue":"trap","toolUsed_metricvalue":"NA","Item_triggered_metricvalue":"NA","Position":"ZDynamicObject::ToString() unknown type : SVector3"},"UserId":"b1585b4d - 36f0 - 48a0 - 8ffa - 1b72f01759da","SessionId":"61e82efa0bcb4a3088825dd75e115f61 - 2714020697","Origin":"gameclient","Id":"46904050 - dd0b - 406f - a8ea - 8d56cbbca556"}
+			
+		// Oil drum ignited:
+		// {"Timestamp":158.045746,"Name":"setpieces","ContractSessionId":"2517213287667595942-d688bab6-034a-488b-a483-89cfac74656f","ContractId":"00000000-0000-0000-0000-000000000400","Value":{"RepositoryId":"032151ce-e0be-4847-aab4-1b40fcdc2bc7","name_metricvalue":"Explosive_OilDrum","setpieceHelper_metricvalue":"PropHelper_OilSpill_Flammable","setpieceType_metricvalue":"trap","toolUsed_metricvalue":"Exploded","Item_triggered_metricvalue":"NotAvailable","Position":"ZDynamicObject::ToString() unknown type: SVector3"},"UserId":"b1585b4d-36f0-48a0-8ffa-1b72f01759da","SessionId":"61e82efa0bcb4a3088825dd75e115f61-2714020697","Origin":"gameclient","Id":"4667bd34-ed17-4eef-a46a-370904d2fe47"}
+			
+		// Marrakesh Toilet Drop:
+		// {"Timestamp":422.665924,"Name":"setpieces","ContractSessionId":"2517213287667595942-d688bab6-034a-488b-a483-89cfac74656f","ContractId":"00000000-0000-0000-0000-000000000400","Value":{"RepositoryId":"e29d8ce5-64d6-4207-a55d-ebe5e84b16b3","name_metricvalue":"NotAvailable","setpieceHelper_metricvalue":"Activator_NoTool","setpieceType_metricvalue":"DefaultActivators","toolUsed_metricvalue":"NA","Item_triggered_metricvalue":"NotAvailable","Position":"ZDynamicObject::ToString() unknown type: SVector3"},"UserId":"b1585b4d-36f0-48a0-8ffa-1b72f01759da","SessionId":"61e82efa0bcb4a3088825dd75e115f61-2714020697","Origin":"gameclient","Id":"b81c3ad3-b4b6-45db-8f08-75ddeb5d919a"}
+		// {"Timestamp":423.392487,"Name":"setpieces","ContractSessionId":"2517213287667595942-d688bab6-034a-488b-a483-89cfac74656f","ContractId":"00000000-0000-0000-0000-000000000400","Value":{"RepositoryId":"2d7a91b9-1b3a-4db3-a8bf-6249db70c339","name_metricvalue":"ToiletDrop  ","setpieceHelper_metricvalue":"SuspendedObject","setpieceType_metricvalue":"trap","toolUsed_metricvalue":"NA","Item_triggered_metricvalue":"NA","Position":"ZDynamicObject::ToString() unknown type: SVector3"},"UserId":"b1585b4d-36f0-48a0-8ffa-1b72f01759da","SessionId":"61e82efa0bcb4a3088825dd75e115f61-2714020697","Origin":"gameclient","Id":"a533b4d4-6cfc-4f35-8f77-42e62ee9a523"}
+		// {"Timestamp":423.649689,"Name":"setpieces","ContractSessionId":"2517213287667595942-d688bab6-034a-488b-a483-89cfac74656f","ContractId":"00000000-0000-0000-0000-000000000400","Value":{"RepositoryId":"e29d8ce5-64d6-4207-a55d-ebe5e84b16b3","name_metricvalue":"NotAvailable","setpieceHelper_metricvalue":"Activator_NoTool","setpieceType_metricvalue":"DefaultActivators","toolUsed_metricvalue":"NA","Item_triggered_metricvalue":"NotAvailable","Position":"ZDynamicObject::ToString() unknown type: SVector3"},"UserId":"b1585b4d-36f0-48a0-8ffa-1b72f01759da","SessionId":"61e82efa0bcb4a3088825dd75e115f61-2714020697","Origin":"gameclient","Id":"4990e672-515a-441a-8f9e-63c57284026c"}
+			
+		// Gas canister boom:
+		// {"Timestamp":468.406860,"Name":"setpieces","ContractSessionId":"2517213287667595942-d688bab6-034a-488b-a483-89cfac74656f","ContractId":"00000000-0000-0000-0000-000000000400","Value":{"RepositoryId":"e4bc6f9e-def7-4155-9524-16da8d68d4ad","name_metricvalue":"GasCanister_Large_A","setpieceHelper_metricvalue":"PropHelper_Explosion","setpieceType_metricvalue":"trap","toolUsed_metricvalue":"Exploded","Item_triggered_metricvalue":"NotAvailable","Position":"ZDynamicObject::ToString() unknown type: SVector3"},"UserId":"b1585b4d-36f0-48a0-8ffa-1b72f01759da","SessionId":"61e82efa0bcb4a3088825dd75e115f61-2714020697","Origin":"gameclient","Id":"d8133825-e9ef-4d0d-b5b3-a23db08758e1"}
+
+		// Small oil lamp (distraction object in Reza's office) destroyed:
+		// {"Timestamp":466.942963,"Name":"setpieces","ContractSessionId":"2517213287667595942-d688bab6-034a-488b-a483-89cfac74656f","ContractId":"00000000-0000-0000-0000-000000000400","Value":{"RepositoryId":"997fbfe6-ba8b-41a0-91bb-366bef9bef9b","name_metricvalue":"OilLamp","setpieceHelper_metricvalue":"ShotAndImpulseListener","setpieceType_metricvalue":"trap","toolUsed_metricvalue":"OnImpact","Item_triggered_metricvalue":"NotAvailable","Position":"ZDynamicObject::ToString() unknown type: SVector3"},"UserId":"b1585b4d-36f0-48a0-8ffa-1b72f01759da","SessionId":"61e82efa0bcb4a3088825dd75e115f61-2714020697","Origin":"gameclient","Id":"d3f6d21b-6817-4cdc-b4de-6fecf8982189"}
+		// {"Timestamp":466.963257,"Name":"setpieces","ContractSessionId":"2517213287667595942-d688bab6-034a-488b-a483-89cfac74656f","ContractId":"00000000-0000-0000-0000-000000000400","Value":{"RepositoryId":"0f0bb2c7-1cb3-4211-87ad-555df894026a","name_metricvalue":"OilLamp","setpieceHelper_metricvalue":"DistractionLogic_Visual","setpieceType_metricvalue":"DistractionTriggered","toolUsed_metricvalue":"NA","Item_triggered_metricvalue":"NotAvailable","Position":"ZDynamicObject::ToString() unknown type: SVector3"},"UserId":"b1585b4d-36f0-48a0-8ffa-1b72f01759da","SessionId":"61e82efa0bcb4a3088825dd75e115f61-2714020697","Origin":"gameclient","Id":"f220d7c8-e0fb-48f1-b4de-6fec5dfc41f3"}
+		// {"Timestamp":466.963257,"Name":"setpieces","ContractSessionId":"2517213287667595942-d688bab6-034a-488b-a483-89cfac74656f","ContractId":"00000000-0000-0000-0000-000000000400","Value":{"RepositoryId":"0f0bb2c7-1cb3-4211-87ad-555df894026a","name_metricvalue":"NotAvailable","setpieceHelper_metricvalue":"DistractionLogic_Visual","setpieceType_metricvalue":"DistractionFixed","toolUsed_metricvalue":"NA","Item_triggered_metricvalue":"NotAvailable","Position":"ZDynamicObject::ToString() unknown type: SVector3"},"UserId":"b1585b4d-36f0-48a0-8ffa-1b72f01759da","SessionId":"61e82efa0bcb4a3088825dd75e115f61-2714020697","Origin":"gameclient","Id":"a718105d-75f9-4d18-b4de-6fec660555f3"}
+
+		// Chandelier winch drop
+		// {"Timestamp":10.500926,"Name":"setpieces","ContractSessionId":"2517213274420850852-356e1881-82f8-4c5a-b7f1-63ab8432c042","ContractId":"00000000-0000-0000-0000-000000000200","Value":{"RepositoryId":"683a099f-5d1b-4800-a781-5d9dfe13b12c","name_metricvalue":"NotAvailable","setpieceHelper_metricvalue":"Activator_NoTool","setpieceType_metricvalue":"DefaultActivators","toolUsed_metricvalue":"NA","Item_triggered_metricvalue":"NotAvailable","Position":"ZDynamicObject::ToString() unknown type: SVector3"},"UserId":"b1585b4d-36f0-48a0-8ffa-1b72f01759da","SessionId":"61e82efa0bcb4a3088825dd75e115f61-2714020697","Origin":"gameclient","Id":"9fba84b6-85df-4d69-bd36-4376196d1202"}
+		// {"Timestamp":10.607255,"Name":"setpieces","ContractSessionId":"2517213274420850852-356e1881-82f8-4c5a-b7f1-63ab8432c042","ContractId":"00000000-0000-0000-0000-000000000200","Value":{"RepositoryId":"683a099f-5d1b-4800-a781-5d9dfe13b12c","name_metricvalue":"NotAvailable","setpieceHelper_metricvalue":"Activator_NoTool","setpieceType_metricvalue":"DefaultActivators","toolUsed_metricvalue":"NA","Item_triggered_metricvalue":"NotAvailable","Position":"ZDynamicObject::ToString() unknown type: SVector3"},"UserId":"b1585b4d-36f0-48a0-8ffa-1b72f01759da","SessionId":"61e82efa0bcb4a3088825dd75e115f61-2714020697","Origin":"gameclient","Id":"af42da25-9c48-44d1-bd46-3bb88cd91c88"}
+		// {"Timestamp":10.864028,"Name":"setpieces","ContractSessionId":"2517213274420850852-356e1881-82f8-4c5a-b7f1-63ab8432c042","ContractId":"00000000-0000-0000-0000-000000000200","Value":{"RepositoryId":"2d7a91b9-1b3a-4db3-a8bf-6249db70c339","name_metricvalue":"NotAvailable","setpieceHelper_metricvalue":"SuspendedObject","setpieceType_metricvalue":"trap","toolUsed_metricvalue":"NA","Item_triggered_metricvalue":"NA","Position":"ZDynamicObject::ToString() unknown type: SVector3"},"UserId":"b1585b4d-36f0-48a0-8ffa-1b72f01759da","SessionId":"61e82efa0bcb4a3088825dd75e115f61-2714020697","Origin":"gameclient","Id":"ad4e6c9d-4438-4fc1-bd6d-9697fe6ad6f0"}
+		// {"Timestamp":11.463453,"Name":"Investigate_Curious","ContractSessionId":"2517213274420850852-356e1881-82f8-4c5a-b7f1-63ab8432c042","ContractId":"00000000-0000-0000-0000-000000000200","Value":{"ActorId":2655118168.000000,"RepositoryId":"f9c3905a-ec94-43b6-aae6-8b2f752467f7","SituationType":"AIS_INVESTIGATE_CURIOUS","EventType":"AISE_ActorJoined","JoinReason":"AISJR_Default","InvestigationType":9.000000},"UserId":"b1585b4d-36f0-48a0-8ffa-1b72f01759da","SessionId":"61e82efa0bcb4a3088825dd75e115f61-2714020697","Origin":"gameclient","Id":"8ad219e4-5222-4f7b-bdc8-b6224db5aa6d"}
+		Logger::Info("Setpieces: {}", nlohmann::json{
+			{"name_metricvalue", ev.Value.name_metricvalue},
+			{"setpieceHelper_metricvalue", ev.Value.setpieceHelper_metricvalue},
+			{"setpieceType_metricvalue", ev.Value.setpieceType_metricvalue},
+			{"setpieceType_metricvalue", ev.Value.setpieceType_metricvalue},
+			{"Item_triggered_metricvalue", ev.Value.Item_triggered_metricvalue},
+			{"RepositoryId", ev.Value.RepositoryId},
+		}.dump());
+	});
+	//eventName == "ItemDestroyed" // broken camcorder
+	//eventName == "TargetEscapeFoiled" // Yuki killed in Gondola
+}
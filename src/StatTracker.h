@@ -0,0 +1,116 @@
+#pragma once
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "json.hpp"
+#include "ContractArena.h"
+#include "EventHistory.h"
+#include "EventSystem.h"
+#include "Memory.h"
+#include "RepoId.h"
+#include "RepoIndex.h"
+#include "Stats.h"
+#include "TargetRegistry.h"
+
+struct RepositoryLoadInfo
+{
+	bool loaded = false;
+	size_t items = 0;
+	size_t npcs = 0;
+	size_t bytes = 0;
+	double milliseconds = 0;
+};
+
+// What a finished contract took from the contract arena, and how long resetting for the next one took.
+struct ContractMemoryInfo
+{
+	uint64_t allocations = 0;
+	size_t bytes = 0;
+	size_t reservedBytes = 0;
+	double resetMicroseconds = 0;
+};
+
+// Platform-independent core of the mod: decodes game events, tracks Stats through the event handlers and derives the
+// DisplayStats from them. The plugin layers hooks, UI and LiveSplit on top; the replay tool drives it headlessly.
+class StatTracker
+{
+public:
+	StatTracker();
+	virtual ~StatTracker() = default;
+
+	// Takes the repo index built from repo.json and npc.json. The data must outlive the tracker.
+	auto LoadRepository(std::string_view index) -> bool;
+	auto GetRepositoryLoadInfo() const -> const RepositoryLoadInfo& { return this->repoLoadInfo; }
+
+	// Logs the heap usage of each memory subsystem (see Memory.h).
+	auto LogMemoryReport() const -> void;
+	auto GetContractArena() const -> const ContractArena& { return this->contractArena; }
+	auto GetLastContractMemoryInfo() const -> const ContractMemoryInfo& { return this->lastContractMemory; }
+
+	// Decodes and dispatches one event (with newlines already stripped). Handlers only mark the stat groups they change;
+	// display stats catch up on the next CommitDisplayStats. Returns false if the event was blacklisted or not handled.
+	// Throws nlohmann::json::exception.
+	auto HandleEvent(std::string_view eventData) -> bool;
+
+	// How long witness events are kept for, in seconds of game time (see WitnessEventStore). Applies to the current
+	// contract and every one after it.
+	auto SetWitnessRetention(double seconds) -> void;
+
+	// Every event sent this session, not just this contract, with counts of those that went unhandled.
+	auto GetEventHistory() const -> const EventHistory& { return this->eventHistory; }
+	auto GetStats() const -> const Stats& { return this->stats; }
+	auto GetDisplayStats() const -> const DisplayStats& { return this->displayStats; }
+	auto GetDisplayUpdateCounters() const -> const DisplayUpdateCounters& { return this->displayCounters; }
+	auto GetSilentAssassinStatus() const -> SilentAssassinStatus;
+	auto CalculateStealthRating() -> double;
+
+	// Recomputes the display values derived from any stat groups marked dirty since the last commit.
+	// Returns true if anything visible changed, or a new contract has started since. Meant to be called at most once per
+	// frame.
+	auto CommitDisplayStats() -> bool;
+
+protected:
+	virtual auto NewContract() -> void;
+
+	auto MarkDirty(StatGroup groups) -> void;
+	auto IsContractEnded() const -> bool;
+	auto IsRepoIdTargetNPC(const RepoId& id) const -> bool;
+	// Registers a target, either one the game has flagged as a contract target or a Freelancer syndicate target.
+	auto AddTarget(const RepoId& id) -> void;
+	auto GetRepoEntry(const RepoId& id) const -> std::optional<RepoIndex::Item>;
+	auto CreateItemInfo(const RepoId& repoId) -> ItemInfo;
+	auto AddObtainedItem(const RepoId& id, ItemInfo item) -> void;
+	auto RemoveObtainedItem(const RepoId& id) -> int;
+	auto AddDisposedItem(const RepoId& id, ItemInfo item) -> void;
+	auto GetNPCName(const RepoId& id) const -> std::optional<std::string_view>;
+	// Index of the NPC in stats.npcs, or NPCIndex::None for an empty ID.
+	auto InternNPC(const RepoId& id) -> uint32_t;
+
+private:
+	auto SetupEvents() -> void;
+
+protected:
+	// Declared before everything allocating from it, so it is destroyed after them.
+	ContractArena contractArena;
+	ContractMemoryInfo lastContractMemory;
+	Stats stats;
+	DisplayStats displayStats;
+	DisplayUpdateCounters displayCounters;
+	StatGroup dirtyStats = StatGroup::All;
+	// Set when the display stats are reset, for the next commit to report a change whatever it recomputes.
+	bool displayReset = true;
+	EventSystem events;
+	TargetRegistry targets;
+	EventHistory eventHistory;
+	std::mt19937 randomGenerator;
+	RepoIndex repo;
+	RepositoryLoadInfo repoLoadInfo;
+
+	double cutsceneEndTime = 0;
+	double missionEndTime = 0;
+	double lastEventTimestamp = 0;
+	double witnessRetention = 60;
+};
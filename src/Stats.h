@@ -1,12 +1,57 @@
 #pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <map>
 #include <set>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
 #include <unordered_set>
 #include <Glacier/Enums.h>
+#include "ContractArena.h"
 #include "Enums.h"
+#include "Memory.h"
+#include "NPCIndex.h"
 #include "PlayStyleRating.h"
-#include "util.h"
+#include "RepoId.h"
+#include "SilentAssassin.h"
+#include "WitnessEventStore.h"
+
+// Groups of stats which event handlers mark as changed, so that derived display values are only recomputed when
+// their inputs have changed.
+enum class StatGroup : uint32_t
+{
+	None = 0,
+	Kills = 1 << 0,
+	Pacifies = 1 << 1,
+	Bodies = 1 << 2,
+	Detection = 1 << 3,
+	Witnesses = 1 << 4,
+	Tension = 1 << 5,
+	Disguises = 1 << 6,
+	Items = 1 << 7,
+	Misc = 1 << 8,
+	Targets = 1 << 9, // which NPCs are considered targets
+	All = (1 << 10) - 1,
+};
+
+constexpr auto operator|(StatGroup a, StatGroup b) -> StatGroup {
+	return static_cast<StatGroup>(static_cast<uint32_t>(a) | static_cast<uint32_t>(b));
+}
+
+constexpr auto operator&(StatGroup a, StatGroup b) -> StatGroup {
+	return static_cast<StatGroup>(static_cast<uint32_t>(a) & static_cast<uint32_t>(b));
+}
+
+constexpr auto operator|=(StatGroup& a, StatGroup b) -> StatGroup& {
+	return a = a | b;
+}
+
+constexpr auto hasAnyStatGroup(StatGroup groups, StatGroup any) -> bool {
+	return (groups & any) != StatGroup::None;
+}
 
 enum class SilentAssassinStatus
 {
@@ -43,79 +88,118 @@ struct DisplayStats
 	SilentAssassinStatus silentAssassin = SilentAssassinStatus::OK;
 };
 
-enum class ItemInfoType {
-	None,
-	Key,
-	Intel,
-	Detonator,
-	Coin,
-	Firearm,
-	AmmoBox,
-	Explosive,
-	Melee,
-	LethalMelee,
-	Poison,
-	Briefcase,
-	Other,
+// How often display stats were asked to update versus actually recomputed, for the current mission.
+struct DisplayUpdateCounters
+{
+	int requested = 0;
+	int committed = 0;
+	int silentAssassin = 0;
+	int stealthRating = 0;
+	int playStyle = 0;
 };
 
+// Names are views into the repo index's string pool, which lives as long as the mod, so items are copied around
+// and stored without allocating.
 struct ItemInfo
 {
 	ItemInfoType type = ItemInfoType::None;
-	std::string name;
-	std::string commonName;
-	std::string itemType;
-	std::string inventoryCategoryIcon;
+	std::string_view name;
+	std::string_view commonName;
 	int count = 1;
 };
 
+static_assert(std::is_trivially_copyable_v<ItemInfo>);
+
+// The ways of killing or pacifying that are counted. None is a slot for kills which aren't any of them, so that
+// classifying a kill is always one indexed increment.
+enum class KillMethod : uint8_t
+{
+	Accident,
+	Headshot,
+	Melee,
+	Unarmed,
+	Thrown,
+	Pistol,
+	SMG,
+	Shotgun,
+	PistolElim,
+	SilencedWeapon,
+	Drown,
+	Push,
+	Burn,
+	AccidentExplosion,
+	FallingObject,
+	None,
+};
+
+inline constexpr auto KillMethodCount = static_cast<size_t>(KillMethod::None) + 1;
+
+// The KillMethod counted for each KillMethodBroad and, for accidents, each KillMethodStrict.
+inline constexpr auto killMethodsByBroad = std::array{
+	KillMethod::None, // Other
+	KillMethod::Thrown,
+	KillMethod::Unarmed,
+	KillMethod::Pistol,
+	KillMethod::SMG,
+	KillMethod::Shotgun,
+	KillMethod::PistolElim,
+};
+
+inline constexpr auto killMethodsByStrict = std::array{
+	KillMethod::None, // None
+	KillMethod::None, // Other
+	KillMethod::Drown,
+	KillMethod::Push,
+	KillMethod::Burn,
+	KillMethod::AccidentExplosion,
+	KillMethod::FallingObject,
+};
+
+constexpr auto getKillMethod(KillMethodBroad method) -> KillMethod {
+	return killMethodsByBroad[static_cast<size_t>(method)];
+}
+
+constexpr auto getKillMethod(KillMethodStrict method) -> KillMethod {
+	return killMethodsByStrict[static_cast<size_t>(method)];
+}
+
+static_assert(getKillMethod(KillMethodBroad::CloseCombatPistolElimination) == KillMethod::PistolElim);
+static_assert(getKillMethod(KillMethodStrict::AccidentSuspendedObject) == KillMethod::FallingObject);
+
+// Kills by method, split by whether the victim was a target.
 struct KillMethodStats
 {
-	int accident = 0;
-	int accidentTarget = 0;
-	int headshot = 0;
-	int headshotTarget = 0;
-	int melee = 0;
-	int meleeTarget = 0;
-	int unarmed = 0;
-	int unarmedTarget = 0;
-	int thrown = 0;
-	int thrownTarget = 0;
-	int pistol = 0;
-	int pistolTarget = 0;
-	int smg = 0;
-	int smgTarget = 0;
-	int shotgun = 0;
-	int shotgunTarget = 0;
-	int pistolElim = 0;
-	int pistolElimTarget = 0;
-	int silencedWeapon = 0;
-	int silencedWeaponTarget = 0;
-
-	int drown = 0;
-	int drownTarget = 0;
-	int push = 0;
-	int pushTarget = 0;
-	int burn = 0;
-	int burnTarget = 0;
-	int accidentExplosion = 0;
-	int accidentExplosionTarget = 0;
-	int fallingObject = 0;
-	int fallingObjectTarget = 0;
+	auto add(KillMethod method, bool isTarget) -> void {
+		++this->counts[static_cast<size_t>(method)][isTarget];
+	}
+
+	// Kills of anyone by the method.
+	auto get(KillMethod method) const -> int {
+		auto const& count = this->counts[static_cast<size_t>(method)];
+		return count[0] + count[1];
+	}
+
+	// Kills of targets by the method.
+	auto getTargets(KillMethod method) const -> int {
+		return this->counts[static_cast<size_t>(method)][1];
+	}
+
+private:
+	std::array<std::array<int, 2>, KillMethodCount> counts = {};
 };
 
 struct KillStats
 {
 	struct NoticedKillInfo
 	{
-		std::map<std::string, bool, InsensitiveCompareLexicographic> sightings;
+		ContractMap<RepoId, bool> sightings;
 		bool isSightedByNonTarget = false;
 	};
 
-	std::set<std::string, InsensitiveCompareLexicographic> targets;
-	std::set<std::string, InsensitiveCompareLexicographic> nonTargets;
-	std::set<std::string, InsensitiveCompareLexicographic> proxyDeaths;
-	std::unordered_map<std::string, NoticedKillInfo, StringHashLowercase, InsensitiveCompare> noticedKillInfos;
+	NPCSet targets;
+	NPCSet nonTargets;
+	ContractSet<RepoId> proxyDeaths;
+	ContractUnorderedMap<RepoId, NoticedKillInfo> noticedKillInfos;
 	int total = 0;
 	int noticed = 0;
 	int unnoticed = 0;
@@ -138,23 +222,31 @@ struct PacificationStats
 	int civilian = 0;
 };
 
+// Pacifications by method. Only Accident, Melee and Thrown are counted.
 struct PacificationMethodStats
 {
-	int accident = 0;
-	int melee = 0;
-	int thrown = 0;
+	auto add(KillMethod method) -> void {
+		++this->counts[static_cast<size_t>(method)];
+	}
+
+	auto get(KillMethod method) const -> int {
+		return this->counts[static_cast<size_t>(method)];
+	}
+
+private:
+	std::array<int, KillMethodCount> counts = {};
 };
 
 struct BodyStats
 {
 	struct MurderedBodyFoundInfo
 	{
-		std::map<std::string, bool, InsensitiveCompareLexicographic> sightings;
+		ContractMap<RepoId, bool> sightings;
 		bool isSightedByNonTarget = false;
 	};
 
-	std::set<std::string, InsensitiveCompareLexicographic> uniqueBodiesFound;
-	std::unordered_map<std::string, MurderedBodyFoundInfo, StringHashLowercase, InsensitiveCompare> foundMurderedInfos;
+	NPCSet uniqueBodiesFound;
+	ContractUnorderedMap<RepoId, MurderedBodyFoundInfo> foundMurderedInfos;
 	bool allHidden = false;
 	bool allTargetsHidden = false;
 	int hidden = 0;
@@ -231,39 +323,35 @@ struct CurrentStats
 	bool holdingIllegalWeapon = false;
 };
 
+// Everything in here is for the current contract, and its containers allocate from the tracker's ContractArena (which
+// is why NPC names are views into the repo index rather than strings). Only the tracker may modify it, inside a
+// ContractArena::Scope, and it is reset by releasing the arena and constructing a new Stats over the old one.
 struct Stats
 {
-	struct WitnessEvent {
-		double timestamp;
-		Events event;
-		std::string bodyId;
-		std::string witnessId;
-		bool isWitnessTarget;
-
-		WitnessEvent(double timestamp, Events event, std::string witnessId, bool isWitnessTarget, std::string bodyId = "") :
-			timestamp(timestamp), event(event), witnessId(witnessId), bodyId(bodyId), isWitnessTarget(isWitnessTarget)
-		{}
-	};
-
 	double trespassStartTime = 0;
 	double currentTrespassTime = 0;
 	double weaponHoldingStartTime = 0;
-	std::vector<WitnessEvent> witnessEvents;
-	std::string firstSpottedByID;
-	std::string firstSpottedByName;
-	std::string firstBodyFoundByID;
-	std::string firstBodyFoundByName;
-	std::string firstNTKID;
-	std::string firstNTKName;
+	WitnessEventStore witnessEvents;
+	RepoId firstSpottedByID;
+	std::string_view firstSpottedByName;
+	RepoId firstBodyFoundByID;
+	std::string_view firstBodyFoundByName;
+	RepoId firstNTKID;
+	std::string_view firstNTKName;
 	bool firstBodyFoundWasByTarget = false;
-	std::set<std::string, InsensitiveCompareLexicographic> witnesses;
-	std::set<std::string, InsensitiveCompareLexicographic> spottedBy;
-	std::set<std::string, InsensitiveCompareLexicographic> targetsSpottedBy;
-	std::set<std::string, InsensitiveCompareLexicographic> targetBodyWitnesses;
-	std::set<std::string, InsensitiveCompareLexicographic> targetKillNoticers;
-	std::set<std::string, InsensitiveCompareLexicographic> disguisesBlown;
-	std::map<std::string, ItemInfo, InsensitiveCompareLexicographic> itemsObtained;
-	std::map<std::string, ItemInfo, InsensitiveCompareLexicographic> itemsDisposed;
+	// Every NPC in the sets below, and the NPCs known to be targets.
+	NPCIndex npcs;
+	NPCSet targetNPCs;
+	NPCSet witnesses;
+	NPCSet spottedBy;
+	NPCSet targetsSpottedBy;
+	NPCSet targetBodyWitnesses;
+	NPCSet targetKillNoticers;
+	// Updated along with the witnesses, spotters, kills and targets.
+	SilentAssassinTracker silentAssassin;
+	ContractSet<RepoId> disguisesBlown;
+	ContractMap<RepoId, ItemInfo> itemsObtained;
+	ContractMap<RepoId, ItemInfo> itemsDisposed;
 	KillStats kills;
 	KillMethodStats killMethods;
 	PacificationStats pacifies;
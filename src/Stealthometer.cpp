@@ -4,17 +4,21 @@
 #include "EventSystem.h"
 #include "json.hpp"
 #include "LiveSplitClient.h"
-#include "Rating.h"
+#include "Profiler.h"
 #include "Stats.h"
 #include "Stealthometer.h"
-#include "util.h"
+#include "Timeline.h"
+#include "Trace.h"
 #include <algorithm>
 #include <charconv>
+#include <chrono>
 #include <cmrc/cmrc.hpp>
 #include <Common.h>
 #include <cstddef>
 #include <cstdint>
 #include <format>
+#include <filesystem>
+#include <fstream>
 #include <functional>
 #include <Functions.h>
 #include <Glacier/Enums.h>
@@ -41,6 +45,7 @@
 #include <Logging.h>
 #include <random>
 #include <ranges>
+#include <span>
 #include <string>
 #include <string_view>
 #include <system_error>
@@ -71,12 +76,15 @@ auto APIENTRY DllMain(HMODULE module, DWORD reason, LPVOID) -> BOOL {
 	return TRUE;
 }
 
-Stealthometer::Stealthometer() : window(this->displayStats), randomGenerator(std::random_device{}()), config(*this), liveSplitClient(config.Get()) {
+Stealthometer::Stealthometer() : window(this->displayStats), config(*this), liveSplitClient(config.Get()) {
 	this->SetupEvents();
 }
 
 Stealthometer::~Stealthometer() {
 	this->UninstallHooks();
+	this->eventWorker.stop();
+	Trace::stop();
+	Timeline::stop();
 }
 
 auto Stealthometer::Init() -> void
@@ -85,38 +93,11 @@ auto Stealthometer::Init() -> void
 
 	auto const fs = cmrc::stealthometer::get_filesystem();
 
-	if (!fs.is_file("data/repo.json")
-		|| !fs.is_file("data/npc.json"))
-		Logger::Error("Stealthometer: repo.json not found in embedded filesystem.");
+	if (!fs.is_file("data/repo.bin"))
+		Logger::Error("Stealthometer: repo.bin not found in embedded filesystem.");
 	else {
-		auto file = fs.open("data/repo.json");
-		auto repo = nlohmann::json::parse(file.begin(), file.end());
-
-		if (repo.is_array()) {
-			for (auto const& entry : repo) {
-				if (!entry.is_object()) continue;
-				auto id = entry.find("ID_");
-				if (id == entry.end()) continue;
-				this->repo.emplace(id.value().get<std::string>(), entry);
-			}
-		}
-		else Logger::Error("Stealthometer: repo.json invalid.");
-	}
-	if (fs.is_file("data/npc.json")) {
-		auto file = fs.open("data/npc.json");
-		auto repo = nlohmann::json::parse(file.begin(), file.end());
-
-		if (repo.is_array()) {
-			for (auto const& entry : repo) {
-				if (!entry.is_object()) continue;
-				auto id = entry.find("ID_");
-				if (id == entry.end()) continue;
-				auto name = entry.find("Name");
-				if (name == entry.end()) continue;
-				this->npcNames.emplace(id.value().get<std::string>(), name.value().get<std::string>());
-			}
-		}
-		else Logger::Error("Stealthometer: npc.json invalid.");
+		auto file = fs.open("data/repo.bin");
+		this->LoadRepository(std::string_view(file.begin(), file.size()));
 	}
 	//this->window.create(hInstance);
 }
@@ -154,7 +135,9 @@ auto Stealthometer::UninstallHooks() -> void {
 auto Stealthometer::OnEngineInitialized() -> void
 {
 	config.Load();
+	this->SetWitnessRetention(config.Get().witnessRetention);
 	this->InstallHooks();
+	this->UpdateEventWorker();
 
 	if (config.Get().externalWindow)
 		this->window.create(hInstance);
@@ -163,88 +146,194 @@ auto Stealthometer::OnEngineInitialized() -> void
 		this->liveSplitClient.start();
 }
 
-auto Stealthometer::IsRepoIdTargetNPC(const std::string& id) const -> bool {
-	if (this->freelanceTargets.contains(id))
-		return true;
+auto Stealthometer::OnFrameUpdateAlways(const SGameUpdateEvent& ev) -> void {
+	++this->frameCount;
+	Timeline::mark("frame");
+	this->UpdateEventWorker();
+	this->UpdateJournal();
+	this->UpdateTrace();
+	this->UpdateTimeline();
+	this->ProcessRunActions();
+	this->ProcessLoadRemoval();
+	this->UpdateStatWindow();
+}
+
+auto Stealthometer::UpdateStatWindow() -> void {
+	// Event handlers and the actor scan only mark which stats changed, so bursts of events in one frame cost a single
+	// recompute of the derived values and at most one window refresh.
+	AcquireSRWLockExclusive(&this->eventLock);
+	auto const updated = this->CommitDisplayStats();
+	ReleaseSRWLockExclusive(&this->eventLock);
+
+	if (updated) this->window.update();
+}
 
-	for (auto const& actor : this->actorData) {
-		if (!actor.isTarget) continue;
-		if (InsensitiveCompare{}(id, actor.repoId)) return true;
+auto Stealthometer::QueueRunAction(std::function<void()> action) -> void {
+	auto lock = std::lock_guard(this->runActionsMutex);
+	this->runActions.push_back(std::move(action));
+}
+
+auto Stealthometer::ProcessRunActions() -> void {
+	{
+		auto lock = std::lock_guard(this->runActionsMutex);
+		if (this->runActions.empty()) return;
+		std::swap(this->runActions, this->runActionsProcessing);
 	}
-	return false;
+
+	for (auto const& action : this->runActionsProcessing) action();
+	this->runActionsProcessing.clear();
 }
 
-auto Stealthometer::GetRepoEntry(const std::string& id) -> const nlohmann::json* {
-	if (!id.empty()) {
-		auto it = this->repo.find(id);
-		if (it != this->repo.end()) return &it->second;
+auto Stealthometer::UpdateEventWorker() -> void {
+	// Only started and stopped from the game thread, which is also the only thread posting events to the worker.
+	auto const enable = this->config.Get().threadedEvents;
+	if (enable == this->eventWorker.isRunning()) return;
+
+	if (enable) {
+		this->eventWorker.start([this](std::string_view eventData, EventWorker::Clock::time_point) {
+			this->ProcessEvent(eventData);
+		});
 	}
-	return nullptr;
+	else this->eventWorker.stop();
 }
 
-auto Stealthometer::GetNPCName(const std::string& id) -> const std::string* {
-	if (!id.empty()) {
-		auto it = this->npcNames.find(id);
-		if (it != this->npcNames.end()) return &it->second;
+auto Stealthometer::UpdateTrace() -> void {
+	auto const enable = this->config.Get().trace;
+	if (enable == Trace::isRunning()) return;
+
+	if (enable) Trace::start();
+	else Trace::stop();
+}
+
+auto Stealthometer::UpdateTimeline() -> void {
+	// Started from the game thread, so it's the one named here.
+	auto const enable = this->config.Get().recordTimeline;
+	if (enable == Timeline::isRunning()) return;
+
+	if (!enable) {
+		Timeline::stop();
+		return;
+	}
+
+	auto const time = std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now());
+	auto const dir = std::filesystem::path("Stealthometer") / "timelines";
+	auto const path = dir / std::format("{:%Y%m%d-%H%M%S}.json", time);
+	auto ec = std::error_code();
+	std::filesystem::create_directories(dir, ec);
+
+	if (Timeline::start(path)) {
+		Timeline::setThreadName("Game");
+		Logger::Info("Stealthometer: recording timeline to {}", path.string());
+	}
+	else {
+		Logger::Error("Stealthometer: failed to open timeline {}", path.string());
+		this->config.Get().recordTimeline = false;
 	}
-	return nullptr;
 }
 
-auto Stealthometer::OnFrameUpdateAlways(const SGameUpdateEvent& ev) -> void {
-	this->ProcessLoadRemoval();
+auto Stealthometer::UpdateJournal() -> void {
+	// Written from the game thread as events are sent, so it's opened and closed there too.
+	auto const enable = this->config.Get().recordJournal;
+	if (enable == this->journal.isOpen()) return;
+
+	if (!enable) {
+		this->journal.close();
+		return;
+	}
+
+	auto const time = std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now());
+	auto const dir = std::filesystem::path("Stealthometer") / "journals";
+	auto const path = dir / std::format("{:%Y%m%d-%H%M%S}.stmj", time);
+	auto ec = std::error_code();
+	std::filesystem::create_directories(dir, ec);
+
+	if (this->journal.open(path))
+		Logger::Info("Stealthometer: recording event journal to {}", path.string());
+	else {
+		Logger::Error("Stealthometer: failed to open event journal {}", path.string());
+		this->config.Get().recordJournal = false;
+	}
 }
 
-auto Stealthometer::OnFrameUpdatePlayMode(const SGameUpdateEvent& ev) -> void {
-	for (int i = 0; i < *Globals::NextActorId; ++i) {
-		const auto& actor = Globals::ActorManager->m_activatedActors[i];
-		const auto actorSpatial = actor.m_entityRef.QueryInterface<ZSpatialEntity>();
-		auto& actorData = this->actorData[i];
-
-		if (!actorData.ref) {
-			actorData.ref = &actor;
-			auto repoEntity = actor.m_entityRef.QueryInterface<ZRepositoryItemEntity>();
-			actorData.repoId = repoEntity->m_sId.ToString();
-			actorData.isTarget = actor.m_pInterfaceRef->m_bContractTarget;
-		}
+auto Stealthometer::WriteProfilerReport() -> void {
+	auto const time = std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now());
+	auto const dir = std::filesystem::path("Stealthometer") / "profiles";
+	auto const path = dir / std::format("{:%Y%m%d-%H%M%S}.txt", time);
+	auto ec = std::error_code();
+	std::filesystem::create_directories(dir, ec);
+
+	auto file = std::ofstream(path, std::ios::trunc);
+	if (!file) {
+		Logger::Error("Stealthometer: failed to open profiler report {}", path.string());
+		return;
+	}
 
-		if (!actorSpatial)
-			continue;
+	Profiler::writeReport(file);
+	Logger::Info("Stealthometer: wrote profiler report to {}", path.string());
+}
 
-		if (i > this->npcCount)
-			this->npcCount = i;
+// The game's activated actors and their behaviour states, as read by the ActorTracker.
+class GameActorSource final : public ActorSource
+{
+public:
+	auto getActorCount() -> size_t override {
+		auto const count = *Globals::NextActorId;
+		return count > 0 ? static_cast<size_t>(count) : 0;
+	}
 
-		if (actor.m_pInterfaceRef->m_nActorRuntimeId >= 0) {
-			// (&behaviour + 0xD8) = m_pPreviousBehavior ?
+	auto describe(size_t index) -> Description override {
+		auto const& actor = Globals::ActorManager->m_activatedActors[index];
+		auto repoEntity = actor.m_entityRef.QueryInterface<ZRepositoryItemEntity>();
+		auto const repoId = repoEntity->m_sId.ToString();
+		return {
+			.repoId = RepoId(std::string_view(repoId.c_str(), repoId.size())),
+			.isTarget = actor.m_pInterfaceRef->m_bContractTarget,
+		};
+	}
 
-			auto& behaviour = Globals::BehaviorService->m_aBehaviorStates[actor.m_pInterfaceRef->m_nActorRuntimeId];
-			if (!behaviour.m_pCurrentBehavior) continue;
-			auto behaviourType = behaviour.m_pCurrentBehavior->eBehaviorType;
-			auto lastBehaviourType = actorData.lastFrameBehaviour;
-			actorData.lastFrameBehaviour = behaviourType;
+	auto read(size_t index) -> State override {
+		auto const& actor = Globals::ActorManager->m_activatedActors[index];
+		auto const spatial = actor.m_entityRef.QueryInterface<ZSpatialEntity>();
+		auto state = State{.runtimeId = spatial ? static_cast<int32_t>(actor.m_pInterfaceRef->m_nActorRuntimeId) : -1};
+		if (state.runtimeId < 0) return state;
 
-			if (lastBehaviourType == behaviourType) continue;
+		// (&behaviour + 0xD8) = m_pPreviousBehavior ?
+		auto const& behaviour = Globals::BehaviorService->m_aBehaviorStates[state.runtimeId];
+		if (behaviour.m_pCurrentBehavior) state.behaviour = behaviour.m_pCurrentBehavior->eBehaviorType;
+		return state;
+	}
+};
 
-			auto tension = getBehaviourTension(behaviourType);
+auto Stealthometer::OnFrameUpdatePlayMode(const SGameUpdateEvent& ev) -> void {
+	auto const profile = ProfileScope(ProfileSection::FrameUpdate);
 
-			if (behaviourType != ECompiledBehaviorType::BT_Act)
-				Logger::Debug("{}: {}", behaviourToString(behaviourType), tension);
+	// Actor data and tension stats are shared with event handlers, which may be running on the event worker.
+	AcquireSRWLockExclusive(&this->eventLock);
 
-			if (!tension) continue;
+	auto source = GameActorSource();
+	this->actors.setBudget(this->config.Get().actorScanBudget);
+	auto const frame = this->actors.update(source);
 
-			if (behaviourType == ECompiledBehaviorType::BT_CloseCombat)
-				++this->stats.misc.closeCombatEngagements;
+	for (auto const index : frame.newTargets)
+		this->AddTarget(this->actors.getRepoId(index));
 
-			if (tension > actorData.highestTensionLevel) {
-				if (actorData.highestTensionLevel) tension -= actorData.highestTensionLevel;
-				actorData.highestTensionLevel += tension;
-				this->stats.tension.level += tension;
-				this->UpdateDisplayStats();
-			}
-		}
+	if (frame.closeCombatEngagements) {
+		this->stats.misc.closeCombatEngagements += frame.closeCombatEngagements;
+		this->MarkDirty(StatGroup::Misc);
+	}
+
+	if (frame.tensionRaises) {
+		this->stats.tension.level += frame.tension;
+		this->MarkDirty(StatGroup::Tension | StatGroup::Misc);
+		this->displayCounters.requested += frame.tensionRaises;
 	}
+
+	ReleaseSRWLockExclusive(&this->eventLock);
 }
 
 auto Stealthometer::ProcessLoadRemoval() -> void {
+	auto const profile = ProfileScope(ProfileSection::LoadRemoval);
+
 	class ZRenderManager {
 	public:
 		virtual ~ZRenderManager() = default;
@@ -274,6 +363,7 @@ auto Stealthometer::ProcessLoadRemoval() -> void {
 	if ((isLoadingScreenActive || loadingScreenActivated) && !loadRemovalActive) {
 		liveSplitClient.pause();
 		loadRemovalActive = true;
+		this->loadRemovalStart = Profiler::Clock::now();
 	}
 
 	if (isLoadingScreenActive)
@@ -288,6 +378,7 @@ auto Stealthometer::ProcessLoadRemoval() -> void {
 				this->startAfterLoad = false;
 			}
 			loadRemovalActive = false;
+			Timeline::span("loading screen", this->loadRemovalStart, Profiler::Clock::now());
 		}
 	}
 }
@@ -431,6 +522,32 @@ auto Stealthometer::DrawSettingsUI(bool focused) -> void {
 			config.Save();
 		}
 
+		// Applied on the next game frame by UpdateEventWorker.
+		if (ImGui::Checkbox("Threaded Event Processing", &cfg.threadedEvents)) {
+			config.Save();
+		}
+
+		// Opened or closed on the next game frame by UpdateJournal.
+		if (ImGui::Checkbox("Record Event Journal", &cfg.recordJournal)) {
+			config.Save();
+		}
+
+		// Opened or closed on the next game frame by UpdateTimeline.
+		if (ImGui::Checkbox("Record Timeline", &cfg.recordTimeline)) {
+			config.Save();
+		}
+
+		// Started or stopped on the next game frame by UpdateTrace.
+		if (ImGui::Checkbox("Trace Actors and Events", &cfg.trace)) {
+			config.Save();
+		}
+
+		// Applied on the next game frame by OnFrameUpdatePlayMode. 0 scans every actor every frame.
+		if (ImGui::InputInt("Actor Scan Budget (us)", &cfg.actorScanBudget)) {
+			cfg.actorScanBudget = std::max(cfg.actorScanBudget, 0);
+			config.Save();
+		}
+
 		if (ImGui::Button("LiveSplit")) this->liveSplitWindowOpen = true;
 
 		if (ImGui::Button("Kill Stats")) this->killsWindowOpen = true;
@@ -438,6 +555,18 @@ auto Stealthometer::DrawSettingsUI(bool focused) -> void {
 		if (ImGui::Button("KO Stats")) this->pacifiesWindowOpen = true;
 		ImGui::SameLine();
 		if (ImGui::Button("Misc Stats")) this->miscWindowOpen = true;
+		ImGui::SameLine();
+		if (ImGui::Button("Memory")) this->memoryWindowOpen = true;
+		ImGui::SameLine();
+		if (ImGui::Button("Events")) this->eventsWindowOpen = true;
+		ImGui::SameLine();
+		if (ImGui::Button("Profiler")) this->profilerWindowOpen = true;
+
+		auto const& repoLoadInfo = this->GetRepositoryLoadInfo();
+		if (repoLoadInfo.loaded)
+			ImGui::TextDisabled("Repo: %zu items, %zu NPCs (loaded in %.3f ms)", repoLoadInfo.items, repoLoadInfo.npcs, repoLoadInfo.milliseconds);
+		else
+			ImGui::TextDisabled("Repo: failed to load");
 
 		ImGui::PopFont();
 	}
@@ -503,10 +632,10 @@ auto Stealthometer::DrawOverlayUI(bool focused) -> void
 		else if (this->displayStats.silentAssassin == SilentAssassinStatus::RedeemableTarget) {
 			ImGui::PushStyleColor(ImGuiCol_Text, IM_COL32(217, 109, 0, 255));
 			if (!this->stats.firstSpottedByName.empty()) {
-				ImGui::Text(this->stats.firstSpottedByName.c_str());
+				ImGui::TextUnformatted(this->stats.firstSpottedByName.data(), this->stats.firstSpottedByName.data() + this->stats.firstSpottedByName.size());
 			}
 			else if (!this->stats.firstBodyFoundByName.empty()) {
-				ImGui::Text(this->stats.firstBodyFoundByName.c_str());
+				ImGui::TextUnformatted(this->stats.firstBodyFoundByName.data(), this->stats.firstBodyFoundByName.data() + this->stats.firstBodyFoundByName.size());
 			}
 			else ImGui::Text("Target");
 			ImGui::PopStyleColor();
@@ -523,19 +652,22 @@ auto Stealthometer::DrawOverlayUI(bool focused) -> void
 			if (this->stats.detection.nonTargetsSpottedBy > 0) {
 				str += "Spotted";
 				if (enableNames && !this->stats.firstSpottedByName.empty() && this->stats.firstSpottedByName != this->stats.firstBodyFoundByName) {
-					str += " by " + this->stats.firstSpottedByName;
+					str += " by ";
+					str += this->stats.firstSpottedByName;
 				}
 			}
 			if (this->stats.bodies.foundMurderedByNonTarget > 0) {
 				str += (str.empty() ? ""s : " | "s) + "Body Found"s;
 				if (enableNames && !this->stats.firstBodyFoundByName.empty()) {
-					str += " by " + this->stats.firstBodyFoundByName;
+					str += " by ";
+					str += this->stats.firstBodyFoundByName;
 				}
 			}
 			if (this->displayStats.civilianKills > 0 || this->displayStats.guardKills > 0) {
 				str += (str.empty() ? ""s : " | "s) + (cfg.useExtendedShorthand ? "NTK"s : "Non-Target Kill"s);
 				if (enableNames && !this->stats.firstNTKName.empty()) {
-					str += " of " + this->stats.firstNTKName;
+					str += " of ";
+					str += this->stats.firstNTKName;
 				}
 			}
 
@@ -571,10 +703,12 @@ auto Stealthometer::DrawLiveSplitUI(bool focused) -> void
 		if (ImGui::Checkbox("Enable", &cfg.liveSplitEnabled)) {
 			config.Save();
 
-			if (!cfg.liveSplitEnabled && liveSplitClient.isStarted())
-				liveSplitClient.stop();
-			else if (cfg.liveSplitEnabled && !liveSplitClient.isStarted())
-				liveSplitClient.start();
+			this->QueueRunAction([this, enable = cfg.liveSplitEnabled] {
+				if (!enable && this->liveSplitClient.isStarted())
+					this->liveSplitClient.stop();
+				else if (enable && !this->liveSplitClient.isStarted())
+					this->liveSplitClient.start();
+			});
 		}
 
 		static char liveSplitIPBuff[40] = "\0";
@@ -602,18 +736,20 @@ auto Stealthometer::DrawLiveSplitUI(bool focused) -> void
 
 		if (cfg.liveSplitEnabled && connected) {
 			if (ImGui::Button("Reset")) {
-				liveSplitClient.send(eClientMessage::Reset);
-				this->runData.shouldAutoStartLiveSplit = false;
+				this->QueueRunAction([this] {
+					this->liveSplitClient.send(eClientMessage::Reset);
+					this->runData.shouldAutoStartLiveSplit = false;
+				});
 			}
 			ImGui::SameLine();
 			if (ImGui::Button("Split"))
-				liveSplitClient.send(eClientMessage::Split);
+				this->QueueRunAction([this] { this->liveSplitClient.send(eClientMessage::Split); });
 			ImGui::SameLine();
 			if (ImGui::Button("Unsplit"))
-				liveSplitClient.send(eClientMessage::Unsplit);
+				this->QueueRunAction([this] { this->liveSplitClient.send(eClientMessage::Unsplit); });
 			ImGui::SameLine();
 			if (ImGui::Button("Pause/Resume"))
-				liveSplitClient.send(eClientMessage::Pause);
+				this->QueueRunAction([this] { this->liveSplitClient.send(eClientMessage::Pause); });
 		}
 
 		ImGui::PopFont();
@@ -642,7 +778,7 @@ auto Stealthometer::DrawExpandedStatsUI(bool focused) -> void {
 				if (ImGui::BeginTable("KillStatsTableL", 2, ImGuiTableFlags_SizingStretchProp | ImGuiTableFlags_Borders)) {
 					ImGui::TableSetupColumn("Value", ImGuiTableColumnFlags_WidthFixed, 30);
 					printRow("Guard", "%d", stats.kills.guard);
-					printRow("Target", "%d", stats.kills.targets);
+					printRow("Target", "%d", static_cast<int>(stats.kills.targets.size()));
 					printRow("Unnoticed", "%d", stats.kills.unnoticed);
 					printRow("Unnoticed Non-Target", "%d", stats.kills.unnoticedNonTarget);
 				}
@@ -656,7 +792,7 @@ auto Stealthometer::DrawExpandedStatsUI(bool focused) -> void {
 				if (ImGui::BeginTable("KillStatsTableR", 2, ImGuiTableFlags_SizingStretchProp | ImGuiTableFlags_Borders)) {
 					ImGui::TableSetupColumn("Value", ImGuiTableColumnFlags_WidthFixed, 30);
 					printRow("Civilian", "%d", stats.kills.civilian);
-					printRow("Non-Target", "%d", stats.kills.nonTargets);
+					printRow("Non-Target", "%d", static_cast<int>(stats.kills.nonTargets.size()));
 					printRow("Noticed", "%d", stats.kills.noticed);
 				}
 				ImGui::EndTable();
@@ -743,1057 +879,309 @@ auto Stealthometer::DrawExpandedStatsUI(bool focused) -> void {
 		ImGui::End();
 	}
 
-	ImGui::PopFont();
-}
-
-auto Stealthometer::OnDrawUI(bool focused) -> void {
-	this->DrawExpandedStatsUI(focused);
-	this->DrawLiveSplitUI(focused);
-	this->DrawOverlayUI(focused);
-
-	if (!this->statVisibleUI) return;
-
-	this->DrawSettingsUI(focused);
-}
+	if (this->memoryWindowOpen) {
+		ImGui::SetNextWindowSizeConstraints(ImVec2{350, 150}, ImVec2{600, -1});
 
-auto Stealthometer::NewContract() -> void {
-	for (auto& actorData : this->actorData) {
-		actorData = ActorData{};
-	}
-
-	this->stats = Stats();
-	this->displayStats = DisplayStats();
-	this->npcCount = 0;
-	this->missionEndTime = 0;
-	this->cutsceneEndTime = 0;
-	this->freelanceTargets.clear();
-	this->eventHistory.clear();
-	this->window.update();
-}
+		if (ImGui::Begin(ICON_MD_PIE_CHART " MEMORY", &this->memoryWindowOpen)) {
+			ImGui::PushFont(SDK()->GetImGuiRegularFont());
 
-auto Stealthometer::CreateItemInfo(const std::string& id) -> ItemInfo {
-	ItemInfo item;
-	item.type = ItemInfoType::None;
-	auto entry = this->GetRepoEntry(id);
-	if (entry) {
-		auto itemType = entry->value("ItemType", "");
-		auto inventoryCategoryIcon = entry->value("InventoryCategoryIcon", "");
-		auto itemInfoType = ItemInfoType::Other;
-
-		if (itemType == "eOther_Keycard_A") {
-			itemInfoType = ItemInfoType::Key;
-			++stats.misc.keyItemsPickedUp;
-		}
-		else if (itemType == "eDetonator" && inventoryCategoryIcon == "remote") {
-			itemInfoType = ItemInfoType::Detonator;
-		}
-		else if (itemType == "eCC_Brick") {
-			++stats.misc.itemsPickedUp;
-		}
-		else {
-			++stats.misc.itemsPickedUp;
-
-			if (itemType == "eDetonator" && inventoryCategoryIcon == "distraction")
-				itemInfoType = ItemInfoType::Coin;
-			else if (itemType == "eItemAmmo")
-				itemInfoType = ItemInfoType::AmmoBox;
-			else if (inventoryCategoryIcon == "QuestItem" || inventoryCategoryIcon == "questitem") {
-				itemInfoType = ItemInfoType::Intel;
-				++stats.misc.intelItemsPickedUp;
-			}
-			else if (inventoryCategoryIcon == "poison")
-				itemInfoType = ItemInfoType::Poison;
-			else if (inventoryCategoryIcon == "melee") {
-				if (itemType == "eCC_Knife") itemInfoType = ItemInfoType::LethalMelee;
-				else itemInfoType = ItemInfoType::Melee;
-			}
-			else if (inventoryCategoryIcon == "explosives") {
-				itemInfoType = ItemInfoType::Explosive;
-			}
-			else if (
-				inventoryCategoryIcon == "pistol"
-				|| inventoryCategoryIcon == "smg"
-				|| inventoryCategoryIcon == "shotgun"
-				|| inventoryCategoryIcon == "assaultrifle"
-				|| inventoryCategoryIcon == "sniperrifle"
-			) {
-				itemInfoType = ItemInfoType::Firearm;
+			if (ImGui::BeginTable("MemoryTable", 4, ImGuiTableFlags_SizingStretchProp | ImGuiTableFlags_Borders)) {
+				ImGui::TableSetupColumn("Subsystem");
+				ImGui::TableSetupColumn("Live KB");
+				ImGui::TableSetupColumn("Peak KB");
+				ImGui::TableSetupColumn("Allocations");
+				ImGui::TableHeadersRow();
+
+				Memory::forEachSubsystem([](MemorySubsystem subsystem, const MemoryUsage& usage) {
+					if (ImGui::TableNextColumn()) ImGui::TextUnformatted(Memory::getSubsystemName(subsystem));
+					if (ImGui::TableNextColumn()) ImGui::Text("%.1f", usage.liveBytes / 1024.0);
+					if (ImGui::TableNextColumn()) ImGui::Text("%.1f", usage.peakBytes / 1024.0);
+					if (ImGui::TableNextColumn()) ImGui::Text("%llu", static_cast<unsigned long long>(usage.allocations));
+				});
+				ImGui::EndTable();
 			}
-		}
 
-		switch (itemInfoType) {
-			case ItemInfoType::Detonator: break;
-			default:
-				if (id.empty()) break;
-				item.type = itemInfoType;
-				item.name = entry->value("Title", "");
-				item.commonName = entry->value("CommonName", "");
-				item.itemType = itemType;
-				item.inventoryCategoryIcon = inventoryCategoryIcon;
-				break;
+			auto const& arena = this->GetContractArena();
+			auto const& lastContract = this->GetLastContractMemoryInfo();
+			ImGui::TextDisabled("Contract arena: %.1f KB reserved in %zu blocks", arena.getBytesReserved() / 1024.0, arena.getBlockCount());
+			ImGui::TextDisabled(
+				"Last contract: %llu allocations, %.1f KB, reset in %.2f us",
+				static_cast<unsigned long long>(lastContract.allocations),
+				lastContract.bytes / 1024.0,
+				lastContract.resetMicroseconds
+			);
+			ImGui::TextDisabled("Repo index: %.1f KB embedded", this->GetRepositoryLoadInfo().bytes / 1024.0);
+			ImGui::TextDisabled("Actor data: %.1f KB fixed", sizeof(this->actors) / 1024.0);
+			ImGui::TextDisabled(
+				"Actor scan: %zu actors, at most %u frames between scans",
+				this->actors.size(),
+				static_cast<unsigned>(this->actors.getScanLatency())
+			);
+
+			if (ImGui::Button("Dump to Log")) this->LogMemoryReport();
+			ImGui::PopFont();
 		}
-	}
-	return item;
-}
-
-auto Stealthometer::AddObtainedItem(const std::string& id, ItemInfo item) -> void {
-	if (item.type == ItemInfoType::None) return;
-	if (id.empty()) return;
-	auto it = this->stats.itemsObtained.find(id);
-	if (it != this->stats.itemsObtained.end())
-		++it->second.count;
-	else
-		this->stats.itemsObtained.emplace(id, item);
-}
-
-auto Stealthometer::AddDisposedItem(const std::string& id, ItemInfo item) -> void {
-	if (item.type == ItemInfoType::None) return;
-	if (id.empty()) return;
-	auto it = this->stats.itemsDisposed.find(id);
-	if (it != this->stats.itemsDisposed.end())
-		++it->second.count;
-	else
-		this->stats.itemsDisposed.emplace(id, item);
-}
-
-auto Stealthometer::RemoveObtainedItem(const std::string& id) -> int {
-	if (id.empty()) return -1;
-	auto it = stats.itemsObtained.find(id);
-	if (it != stats.itemsObtained.end()) {
-		if (it->second.count > 1) return --it->second.count;
-		stats.itemsObtained.erase(it);
-		return 0;
-	}
-	return -1;
-}
-
-auto Stealthometer::GetSilentAssassinStatus() const -> SilentAssassinStatus {
-	// Non-Target Kills
-	auto nonTargetKills = this->stats.kills.nonTargets.size() + this->stats.kills.crowd;
-	if (nonTargetKills > 0) return SilentAssassinStatus::Fail;
-
-	// Spotted
-	auto isKilled = [this](const std::string& id) {
-		return this->stats.kills.targets.contains(id)
-			|| this->stats.kills.nonTargets.contains(id);
-	};
-	auto isTarget = [this](const std::string& id) {
-		return this->IsRepoIdTargetNPC(id);
-	};
-	auto witnessesNotKilled = this->stats.witnesses | std::views::filter(std::not_fn(isKilled));
-	auto spottedByNotKilled = this->stats.spottedBy | std::views::filter(std::not_fn(isKilled));
-	auto witnessesNonTarget = witnessesNotKilled | std::views::filter(std::not_fn(isTarget));
-	auto spottedByNonTarget = spottedByNotKilled | std::views::filter(std::not_fn(isTarget));
-	auto numWitnessesNT = std::distance(witnessesNonTarget.begin(), witnessesNonTarget.end());
-	auto numSpottedByNT = std::distance(spottedByNonTarget.begin(), spottedByNonTarget.end());
-
-	if (numWitnessesNT > 0 || numSpottedByNT > 0)
-		return SilentAssassinStatus::Fail;
-
-	// TODO: Learn if there are any situations that invalidate 'No Noticed Kills' independently from 'Never Spotted'.
-	// Otherwise, it's pointless considering this for SA tracking. 'No Noticed Kills' is seemingly not based on noticed kills.
-	
-	// Noticed Kills
-	//if (stats.kills.noticed > 0)
-	//	return SilentAssassinStatus::Fail;
-
-	// Bodies Found - if body found by non-target, it's definitely not recoverable.
-	if (this->stats.bodies.foundMurderedByNonTarget > 0)
-		return SilentAssassinStatus::Fail;
-
-	// We can shortcut the target redeemable SA logic by comparing the number of target witnesses vs. the number of target witnesses killed.
-	auto spottedByTarget = this->stats.targetBodyWitnesses.size() > this->stats.bodies.targetBodyWitnessesKilled
-		|| this->stats.targetsSpottedBy.size() > this->stats.detection.targetsSpottedByAndKilled;
-
-	// Evidence - also redeemable. Check if we have redeemability from both target and cams.
-	if (this->stats.detection.onCamera) {
-		if (spottedByTarget)
-			return SilentAssassinStatus::RedeemableCameraAndTarget;
-
-		return SilentAssassinStatus::RedeemableCamera;
-	}
-
-	return spottedByTarget ? SilentAssassinStatus::RedeemableTarget : SilentAssassinStatus::OK;
-}
-
-auto Stealthometer::CalculateStealthRating() -> double {
-	auto rating = 100.0;
-	rating -= this->stats.kills.civilian * 8;
-	rating -= this->stats.kills.guard * 5;
-	rating -= this->displayStats.witnesses * 10;
-	rating -= this->stats.detection.onCamera * 15;
-	rating -= this->displayStats.bodiesFound * 5;
-	rating -= this->stats.detection.spotted * 5;
-	rating -= std::max(this->stats.pacifies.nonTargets - 3, 0) * 2;
-	rating += std::min(this->displayStats.bodiesHidden * 3, 15);
-	// TODO: more + adjustments
-	return std::min(std::max(rating, 0.0), 100.0);
-}
-
-auto Stealthometer::UpdateDisplayStats() -> void {
-	this->window.update();
-
-	auto updated = false;
-
-	// Tension
-	auto level = this->stats.tension.level;
-	auto witness = static_cast<int>(this->stats.witnesses.size());
-	auto tension = std::min(level + witness, 470);
-
-	if (tension != this->displayStats.tension) {
-		this->displayStats.tension = tension;
-		updated = true;
-	}
-
-	// Pacifications
-	if (this->displayStats.pacifications != this->stats.pacifies.nonTargets) {
-		this->displayStats.pacifications = this->stats.pacifies.nonTargets;
-		updated = true;
-	}
-
-	// Spotted
-	if (this->displayStats.spotted != (this->stats.targetsSpottedBy.size() + this->stats.detection.nonTargetsSpottedBy)) {
-		this->displayStats.spotted = this->stats.targetsSpottedBy.size() + this->stats.detection.nonTargetsSpottedBy;
-		updated = true;
-	}
-
-	// Bodies Found
-	if (this->displayStats.bodiesFound != this->stats.bodies.found) {
-		this->displayStats.bodiesFound = this->stats.bodies.found;
-		updated = true;
-	}
-
-	// Disguises Taken
-	if (this->displayStats.disguisesTaken != this->stats.misc.disguisesTaken) {
-		this->displayStats.disguisesTaken = this->stats.misc.disguisesTaken;
-		updated = true;
-	}
-
-	// Recorded
-	if (this->displayStats.recorded != this->stats.detection.onCamera) {
-		this->displayStats.recorded = this->stats.detection.onCamera;
-		updated = true;
-	}
-
-	// Guard Kills
-	if (this->displayStats.guardKills != this->stats.kills.guard) {
-		this->displayStats.guardKills = this->stats.kills.guard;
-		updated = true;
+		ImGui::End();
 	}
 
-	// Civilian Kills
-	if (this->displayStats.civilianKills != this->stats.kills.civilian) {
-		this->displayStats.civilianKills = this->stats.kills.civilian;
-		updated = true;
-	}
+	if (this->eventsWindowOpen) {
+		ImGui::SetNextWindowSizeConstraints(ImVec2{350, 200}, ImVec2{800, -1});
 
-	// Witnesses
-	if (this->displayStats.witnesses != this->stats.witnesses.size()) {
-		this->displayStats.witnesses = static_cast<int>(this->stats.witnesses.size());
-		updated = true;
-	}
+		if (ImGui::Begin(ICON_MD_PIE_CHART " EVENTS", &this->eventsWindowOpen)) {
+			ImGui::PushFont(SDK()->GetImGuiRegularFont());
+			auto const& history = this->GetEventHistory();
+			ImGui::TextDisabled("%llu events this session, last %zu kept", static_cast<unsigned long long>(history.getTotal()), history.size());
+
+			auto const trace = Trace::getCounters();
+			ImGui::TextDisabled(
+				"Trace: %llu recorded, %llu dropped, %llu logged",
+				static_cast<unsigned long long>(trace.recorded),
+				static_cast<unsigned long long>(trace.dropped),
+				static_cast<unsigned long long>(trace.formatted)
+			);
+
+			if (ImGui::BeginTable("EventCountsTable", 3, ImGuiTableFlags_SizingStretchProp | ImGuiTableFlags_Borders | ImGuiTableFlags_ScrollY, ImVec2{0, 200})) {
+				ImGui::TableSetupColumn("Event");
+				ImGui::TableSetupColumn("Handled");
+				ImGui::TableSetupColumn("Unhandled");
+				ImGui::TableHeadersRow();
+
+				for (size_t i = 0; i < EventCount; ++i) {
+					auto const event = static_cast<Events>(i);
+					auto const handled = history.getHandledCount(event);
+					auto const unhandled = history.getUnhandledCount(event);
+					if (!handled && !unhandled) continue;
+					auto const name = this->events.getEventName(event);
+					if (ImGui::TableNextColumn()) ImGui::Text("%.*s", static_cast<int>(name.size()), name.data());
+					if (ImGui::TableNextColumn()) ImGui::Text("%llu", static_cast<unsigned long long>(handled));
+					if (ImGui::TableNextColumn()) ImGui::Text("%llu", static_cast<unsigned long long>(unhandled));
+				}
+				history.forEachUnknown([](std::string_view name, uint64_t count) {
+					if (ImGui::TableNextColumn()) ImGui::Text("%.*s (unknown)", static_cast<int>(name.size()), name.data());
+					if (ImGui::TableNextColumn()) ImGui::TextUnformatted("0");
+					if (ImGui::TableNextColumn()) ImGui::Text("%llu", static_cast<unsigned long long>(count));
+				});
+				ImGui::EndTable();
+			}
 
-	// Bodies Hidden
-	if (this->displayStats.bodiesHidden != this->stats.bodies.hidden) {
-		this->displayStats.bodiesHidden = this->stats.bodies.hidden;
-		updated = true;
-	}
+			if (ImGui::BeginChild("RecentEvents", ImVec2{0, 200}, true)) {
+				// Newest first, and only the visible rows of the up to 4096 kept.
+				auto clipper = ImGuiListClipper();
+				clipper.Begin(static_cast<int>(history.size()));
+				while (clipper.Step()) {
+					for (auto row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+						auto const& record = history.getRecord(history.size() - 1 - row);
+						auto const name = history.getName(record);
+						ImGui::Text("%10.3f %.*s%s", record.timestamp, static_cast<int>(name.size()), name.data(), record.handled ? "" : " (unhandled)");
+					}
+				}
+			}
+			ImGui::EndChild();
 
-	// Disguises Blown
-	if (this->displayStats.disguisesBlown != this->stats.disguisesBlown.size()) {
-		this->displayStats.disguisesBlown = this->stats.disguisesBlown.size();
-		updated = true;
+			if (ImGui::Button("Dump to Log")) history.log();
+			ImGui::PopFont();
+		}
+		ImGui::End();
 	}
 
-	// Targets Found
-	const auto targetsFound = this->stats.bodies.targetsFound > 0;
-	if (this->displayStats.targetsFound != targetsFound) {
-		this->displayStats.targetsFound = targetsFound;
-		updated = true;
-	}
+	if (this->profilerWindowOpen) {
+		ImGui::SetNextWindowSizeConstraints(ImVec2{450, 200}, ImVec2{900, -1});
 
-	// Noticed Kills
-	if (this->displayStats.noticedKills != this->stats.kills.noticed) {
-		this->displayStats.noticedKills = this->stats.kills.noticed;
-		updated = true;
-	}
+		if (ImGui::Begin(ICON_MD_PIE_CHART " PROFILER", &this->profilerWindowOpen)) {
+			ImGui::PushFont(SDK()->GetImGuiRegularFont());
 
-	// Silent Assassin Status
-	auto sa = this->GetSilentAssassinStatus();
+			// Times in microseconds, from histograms accurate to within 12.5%.
+			auto const drawRow = [](std::string_view name, const LatencyHistogram& histogram) {
+				auto const summary = histogram.summarize();
+				if (ImGui::TableNextColumn()) ImGui::Text("%.*s", static_cast<int>(name.size()), name.data());
+				if (ImGui::TableNextColumn()) ImGui::Text("%llu", static_cast<unsigned long long>(summary.count));
+				if (ImGui::TableNextColumn()) ImGui::Text("%.2f", summary.p50 / 1000.0);
+				if (ImGui::TableNextColumn()) ImGui::Text("%.2f", summary.p99 / 1000.0);
+				if (ImGui::TableNextColumn()) ImGui::Text("%.2f", summary.p999 / 1000.0);
+				if (ImGui::TableNextColumn()) ImGui::Text("%.2f", summary.max / 1000.0);
+			};
+			auto const beginTable = [](const char* id, const char* heading, float height) {
+				if (!ImGui::BeginTable(id, 6, ImGuiTableFlags_SizingStretchProp | ImGuiTableFlags_Borders | ImGuiTableFlags_ScrollY, ImVec2{0, height}))
+					return false;
+				ImGui::TableSetupColumn(heading);
+				ImGui::TableSetupColumn("Count");
+				ImGui::TableSetupColumn("p50 (us)");
+				ImGui::TableSetupColumn("p99 (us)");
+				ImGui::TableSetupColumn("p99.9 (us)");
+				ImGui::TableSetupColumn("Max (us)");
+				ImGui::TableHeadersRow();
+				return true;
+			};
+
+			if (beginTable("ProfilerSectionsTable", "Section", 0)) {
+				for (size_t i = 0; i < static_cast<size_t>(ProfileSection::Count); ++i) {
+					auto const section = static_cast<ProfileSection>(i);
+					drawRow(Profiler::getSectionName(section), Profiler::getSection(section));
+				}
+				ImGui::EndTable();
+			}
 
-	if (this->displayStats.silentAssassin != sa) {
-		this->displayStats.silentAssassin = sa;
-		updated = true;
-	}
+			if (beginTable("ProfilerEventsTable", "Event", 250)) {
+				for (size_t i = 0; i < EventCount; ++i) {
+					auto const event = static_cast<Events>(i);
+					if (!Profiler::getEvent(event).getCount()) continue;
+					drawRow(this->events.getEventName(event), Profiler::getEvent(event));
+					drawRow("  handlers", Profiler::getHandlers(event));
+				}
+				ImGui::EndTable();
+			}
 
-	// Stealth Rating
-	auto rating = this->CalculateStealthRating();
-	if (static_cast<int>(rating * 100) != static_cast<int>(this->displayStats.stealthRating * 100)) {
-		this->displayStats.stealthRating = rating;
-		updated = true;
-	}
+			auto const timeline = Timeline::getCounters();
+			ImGui::TextDisabled(
+				"Timeline: %llu spans recorded, %llu dropped, %llu written",
+				static_cast<unsigned long long>(timeline.recorded),
+				static_cast<unsigned long long>(timeline.dropped),
+				static_cast<unsigned long long>(timeline.written)
+			);
 
-	// Play Style
-	auto playStyleRating = getPlayStyleRating(stats);
-	if (playStyleRating) {
-		if (playStyleRating != this->displayStats.playstyle.rating) {
-			std::uniform_int_distribution<size_t> rng(0, playStyleRating->getTitles().size() - 1);
-			this->displayStats.playstyle.rating = playStyleRating;
-			this->displayStats.playstyle.index = rng(this->randomGenerator);
+			if (ImGui::Button("Reset")) Profiler::reset();
+			ImGui::SameLine();
+			if (ImGui::Button("Write to File")) this->WriteProfilerReport();
+			ImGui::PopFont();
 		}
+		ImGui::End();
 	}
 
-	if (updated) this->window.update();
+	ImGui::PopFont();
 }
 
-auto Stealthometer::IsContractEnded() const -> bool {
-	return this->missionEndTime > 0;
+auto Stealthometer::NewContract() -> void {
+	this->actors.reset();
+
+	StatTracker::NewContract();
 }
 
 auto Stealthometer::SetupEvents() -> void {
-	// Helper to be called when a body found event is sent with a valid repo ID.
-	auto onRealBodyFound = [this](const Stats::WitnessEvent& ev) {
-		auto const foundMurderedInfoIt = stats.bodies.foundMurderedInfos.find(ev.bodyId);
-		auto const bodyAlreadyFound = foundMurderedInfoIt != stats.bodies.foundMurderedInfos.end();
-
-		// If already found, just keep track of target vs. non-target sightings.
-		if (bodyAlreadyFound) {
-			if (ev.isWitnessTarget) {
-				stats.targetBodyWitnesses.emplace(ev.witnessId);
-			}
-			else if (!foundMurderedInfoIt->second.isSightedByNonTarget) {
-				foundMurderedInfoIt->second.isSightedByNonTarget = true;
-				++stats.bodies.foundMurderedByNonTarget;
-
-				// Get name of first NPC to find a body, replace target name with non target name
-				if (stats.firstBodyFoundByID.empty() && stats.firstBodyFoundWasByTarget) {
-					auto name = this->GetNPCName(ev.witnessId);
-					if (name) {
-						stats.firstBodyFoundByID = ev.witnessId;
-						stats.firstBodyFoundByName = *name;
-						stats.firstBodyFoundWasByTarget = ev.isWitnessTarget;
-					}
-				}
-			}
-
-			foundMurderedInfoIt->second.sightings.try_emplace(ev.witnessId, ev.isWitnessTarget);
-			return;
-		}
-
-		// Increment these only when this body was not already found as an 'accident' body.
-		if (stats.bodies.uniqueBodiesFound.emplace(ev.bodyId).second) {
-			if (this->IsRepoIdTargetNPC(ev.bodyId))
-				++this->stats.bodies.targetsFound;
-			++stats.bodies.found;
-		}
-
-		// Even if body already found, this is the first time it's found 'murdered' (e.g. since dragging an already found accident body).
-		++stats.bodies.foundMurdered;
-
-		// Track target body witnesses so they may be compared against the number of target body witnesses killed for redeemable SA tracking.
-		if (ev.isWitnessTarget)
-			stats.targetBodyWitnesses.emplace(ev.witnessId);
-		else
-			++stats.bodies.foundMurderedByNonTarget;
-
-		// Get name of first NPC to find a body
-		if (stats.firstBodyFoundByID.empty()) {
-			auto name = this->GetNPCName(ev.witnessId);
-			if (name) {
-				stats.firstBodyFoundByID = ev.witnessId;
-				stats.firstBodyFoundByName = *name;
-				stats.firstBodyFoundWasByTarget = ev.isWitnessTarget;
-			}
-		}
-
-		BodyStats::MurderedBodyFoundInfo bodyFoundInfo;
-		bodyFoundInfo.sightings.emplace(ev.witnessId, ev.isWitnessTarget);
-		bodyFoundInfo.isSightedByNonTarget = !ev.isWitnessTarget;
-		stats.bodies.foundMurderedInfos.try_emplace(ev.bodyId, std::move(bodyFoundInfo));
-	};
+	// Stat tracking handlers are set up by StatTracker, these only drive LiveSplit and the run data. They may run on the
+	// event worker, so they queue what they do for the game thread (see ProcessRunActions).
 	events.listen<Events::EvergreenCampaignActivated>([this](const ServerEvent<Events::EvergreenCampaignActivated>& ev) {
-		if (!this->freelancer.campaignInProgress)
-			this->liveSplitClient.send(eClientMessage::Reset);
+		this->QueueRunAction([this] {
+			if (!this->freelancer.campaignInProgress)
+				this->liveSplitClient.send(eClientMessage::Reset);
 
-		this->liveSplitClient.send(eClientMessage::StartOrSplit);
+			this->liveSplitClient.send(eClientMessage::StartOrSplit);
 
-		this->freelancer.campaignCompleted = false;
+			this->freelancer.campaignCompleted = false;
+		});
 	});
 	events.listen<Events::ScoringScreenEndState_CampaignCompleted>([this](const ServerEvent<Events::ScoringScreenEndState_CampaignCompleted>& ev) {
-		this->liveSplitClient.send(eClientMessage::Split);
-		this->runData.freelancer.campaignCompleted = true;
-		this->runData.freelancer.campaignInProgress = false;
+		this->QueueRunAction([this] {
+			this->liveSplitClient.send(eClientMessage::Split);
+			this->runData.freelancer.campaignCompleted = true;
+			this->runData.freelancer.campaignInProgress = false;
+		});
 	});
 	events.listen<Events::NoCampaignActive>([this](const ServerEvent<Events::NoCampaignActive>& ev) {
-		this->runData.freelancer.campaignInProgress = false;
-		this->runData.freelancer.noSyndicateActive = true;
+		this->QueueRunAction([this] {
+			this->runData.freelancer.campaignInProgress = false;
+			this->runData.freelancer.noSyndicateActive = true;
+		});
 	});
 	events.listen<Events::CampaignInProgress>([this](const ServerEvent<Events::CampaignInProgress>& ev) {
-		this->runData.freelancer.campaignInProgress = true;
+		this->QueueRunAction([this] {
+			this->runData.freelancer.campaignInProgress = true;
+		});
 	});
 	events.listen<Events::ContractStart>([this](const ServerEvent<Events::ContractStart>& ev) {
-		this->runData.missionType = ev.Value.ContractType;
-		this->runData.shouldAutoStartLiveSplit = true;
-		this->startAfterLoad = this->loadRemovalActive;
-		if (!this->loadRemovalActive)
-			this->liveSplitClient.send(eClientMessage::StartTimer);
-		Logger::Info("ContractStart: {}", ev.json.dump());
-		this->NewContract();
-	});
-	events.listen<Events::ContractLoad>([this](auto& ev) {
-		this->NewContract();
-	});
-	events.listen<Events::ContractEnd>([this](const ServerEvent<Events::ContractEnd>& ev) {
-		if (this->IsContractEnded()) return;
-		this->missionEndTime = ev.Timestamp;
+		this->QueueRunAction([this, contractType = ev.Value.ContractType] {
+			this->runData.missionType = contractType;
+			this->runData.shouldAutoStartLiveSplit = true;
+			this->startAfterLoad = this->loadRemovalActive;
+			if (!this->loadRemovalActive)
+				this->liveSplitClient.send(eClientMessage::StartTimer);
+		});
 	});
 	events.listen<Events::ExitGate>([this](const ServerEvent<Events::ExitGate>& ev) {
-		if (this->runData.missionType != MissionType::Evergreen) {
+		this->QueueRunAction([this, timestamp = ev.Timestamp] {
+			if (this->runData.missionType == MissionType::Evergreen) return;
 			this->liveSplitClient.pause();
-			this->liveSplitClient.send(eClientMessage::SetGameTime, {std::to_string(ev.Timestamp)});
+			this->liveSplitClient.send(eClientMessage::SetGameTime, {std::to_string(timestamp)});
 			this->liveSplitClient.send(eClientMessage::Split);
 			this->runData.shouldAutoStartLiveSplit = false;
-		}
-
-		this->missionEndTime = ev.Timestamp;
-	});
-	events.listen<Events::IntroCutEnd>([this](const ServerEvent<Events::IntroCutEnd>& ev) {
-		this->cutsceneEndTime = ev.Timestamp;
-	});
-	events.listen<Events::AddSyndicateTarget>([this](const ServerEvent<Events::AddSyndicateTarget>& ev) {
-		if (!ev.Value.repoID.empty())
-			this->freelanceTargets.emplace(ev.Value.repoID);
-	});
-	events.listen<Events::StartingSuit>([this](const ServerEvent<Events::StartingSuit>& ev) {
-		auto entry = this->GetRepoEntry(ev.Value.value);
-		if (entry) {
-			auto const isSuit = entry->value("IsHitmanSuit", false);
-			stats.misc.startedInSuit = isSuit;
-			stats.current.inSuit = isSuit;
-		}
-	});
-	events.listen<Events::ItemPickedUp>([this](const ServerEvent<Events::ItemPickedUp>& ev) {
-		if (this->IsContractEnded()) return;
-		// TODO: bit of a hacky workaround to fix Freelancer loadout items counting as picked up
-		// ignore any items picked up in the first 3 seconds (+ compensate for cutscene length)
-		auto time = ev.Timestamp;
-		time -= this->cutsceneEndTime;
-
-		if (time > 3.0) {
-			auto it = stats.itemsObtained.find(ev.Value.RepositoryId);
-			if (it != stats.itemsObtained.end()) {
-				++it->second.count;
-			}
-			else {
-				auto item = this->CreateItemInfo(ev.Value.RepositoryId);
-				if (item.type != ItemInfoType::None)
-					stats.itemsObtained.emplace(ev.Value.RepositoryId, item);
-			}
-		}
-	});
-	events.listen<Events::ItemDropped>([this](const ServerEvent<Events::ItemDropped>& ev) {
-		if (this->IsContractEnded()) return;
-		++stats.misc.itemsDropped;
-
-		auto& id = ev.Value.RepositoryId;
-		if (!id.empty()) {
-			this->RemoveObtainedItem(id);
-			auto item = this->CreateItemInfo(id);
-			this->AddDisposedItem(id, item);
-		}
-	});
-	events.listen<Events::ItemThrown>([this](const ServerEvent<Events::ItemThrown>& ev) {
-		if (this->IsContractEnded()) return;
-		// inventory removal handled in ItemRemovedFromInventory
-		++stats.misc.itemsThrown;
-
-		auto item = this->CreateItemInfo(ev.Value.RepositoryId);
-		this->AddDisposedItem(ev.Value.RepositoryId, item);
-	});
-	events.listen<Events::ItemRemovedFromInventory>([this](const ServerEvent<Events::ItemRemovedFromInventory>& ev) {
-		if (this->IsContractEnded()) return;
-		++stats.misc.itemsRemovedFromInventory;
-		this->RemoveObtainedItem(ev.Value.RepositoryId);
-	});
-	events.listen<Events::FirstNonHeadshot>([this](const ServerEvent<Events::FirstNonHeadshot>& ev) {
-		// TODO: ?
-	});
-	events.listen<Events::FirstMissedShot>([this](const ServerEvent<Events::FirstMissedShot>& ev) {
-		// TODO: ?
-	});
-	events.listen<Events::Actorsick>([this](const ServerEvent<Events::Actorsick>& ev) {
-		if (this->IsContractEnded()) return;
-		if (ev.Value.IsTarget) ++stats.misc.targetsMadeSick;
-		Logger::Debug("{} ActorSick: {}", ev.Timestamp, nlohmann::json{
-			{"ActorId", ev.Value.ActorId},
-			{"ActorName", ev.Value.ActorName},
-			{"ActorType", ev.Value.ActorType},
-			{"IsTarget", ev.Value.IsTarget},
-			{"actor_R_ID", ev.Value.actor_R_ID},
-			{"item_R_ID", ev.Value.item_R_ID},
-			{"setpiece_R_ID", ev.Value.setpiece_R_ID},
-		}.dump());
-	});
-	events.listen<Events::Trespassing>([this](const ServerEvent<Events::Trespassing>& ev) {
-		if (this->IsContractEnded()) return;
-
-		stats.current.trespassing = ev.Value.IsTrespassing;
-		if (stats.current.trespassing) {
-			stats.trespassStartTime = ev.Timestamp;
-			++stats.misc.timesTrespassed;
-		} else {
-			stats.misc.trespassTime += ev.Timestamp - stats.trespassStartTime;
-		}
-	});
-	events.listen<Events::SecuritySystemRecorder>([this](const ServerEvent<Events::SecuritySystemRecorder>& ev) {
-		if (this->IsContractEnded()) return;
-
-		bool destroyed = false;
-		switch (ev.Value.event) {
-			case SecuritySystemRecorderEvent::Spotted:
-				stats.detection.onCamera = true;
-				break;
-			case SecuritySystemRecorderEvent::Destroyed:
-				destroyed = true;
-				stats.misc.recorderDestroyed = true;
-				[[fallthrough]];
-			case SecuritySystemRecorderEvent::Erased:
-				if (stats.detection.onCamera) stats.misc.recordedThenErased = true;
-				stats.detection.onCamera = false;
-				if (!destroyed && !this->stats.misc.recorderDestroyed)
-					stats.misc.recorderErased = true;
-				break;
-			case SecuritySystemRecorderEvent::CameraDestroyed:
-				++stats.misc.camerasDestroyed;
-				break;
-		}
-	});
-	events.listen<Events::Agility_Start>([this](const ServerEvent<Events::Agility_Start>& ev) {
-		++stats.misc.agilityActions;
-	});
-	events.listen<Events::Drain_Pipe_Climbed>([this](const ServerEvent<Events::Drain_Pipe_Climbed>& ev) {
-		++stats.misc.agilityActions;
-	});
-	events.listen<Events::HoldingIllegalWeapon>([this](const ServerEvent<Events::HoldingIllegalWeapon>& ev) {
-		if (this->IsContractEnded()) return;
-
-		if (stats.current.holdingIllegalWeapon != ev.Value.IsHoldingIllegalWeapon) {
-			stats.weaponHoldingStartTime = ev.Timestamp;
-			++stats.misc.timesTrespassed;
-		} else {
-			stats.misc.weaponHoldingTime += ev.Timestamp - stats.weaponHoldingStartTime;
-		}
-
-		stats.current.holdingIllegalWeapon = ev.Value.IsHoldingIllegalWeapon;
-	});
-	// TODO: The game can send 0'd repository IDs for dead bodies in certain situations.
-	// This makes it difficult to uniquely identify bodies to keep count of bodies found.
-	// IsCrowdActor is also usually true when this happens. Seemingly the game always
-	// eventually sends other body found events with correct IDs. Need a good solution
-	// to link these events to reliably obtain the necessary information.
-	events.listen<Events::AccidentBodyFound>([this](const ServerEvent<Events::AccidentBodyFound>& ev) {
-		Logger::Debug("{} AccidentBodyFound: {}", ev.Timestamp, ev.json.dump());
-		if (this->IsContractEnded()) return;
-
-		const auto& bodyId = ev.Value.DeadBody.RepositoryId;
-
-		// Count only if this body is found for the first time, and ensure we don't double count if the body gets dragged and found again.
-		if (stats.bodies.uniqueBodiesFound.emplace(bodyId).second) {
-			if (this->IsRepoIdTargetNPC(bodyId))
-				++stats.bodies.targetsFound;
-
-			++stats.bodies.found;
-			++stats.bodies.foundAccidents;
-		}
-	});
-	events.listen<Events::DeadBodySeen>([this](const ServerEvent<Events::DeadBodySeen>& ev) {
-		Logger::Debug("{} DeadBodySeen: {}", ev.Timestamp, ev.json.dump());
-		if (this->IsContractEnded()) return;
-		++stats.bodies.deadSeen;
-	});
-	events.listen<Events::MurderedBodySeen>([this, onRealBodyFound](const ServerEvent<Events::MurderedBodySeen>& ev) {
-		Logger::Debug("{} MurderedBodySeen: {}", ev.Timestamp, ev.json.dump());
-		if (this->IsContractEnded()) return;
-
-		auto const& value = ev.Value;
-		auto const& deadBody = value.DeadBody;
-		auto const deadBodyId = deadBody.IsCrowdActor ? "" : deadBody.RepositoryId;
-
-		stats.witnessEvents.emplace_back(ev.Timestamp, Events::MurderedBodySeen, value.Witness, value.IsWitnessTarget, deadBodyId);
-
-		if (!deadBodyId.empty()) onRealBodyFound(stats.witnessEvents.back());
-	});
-	events.listen<Events::BodyFound>([this, onRealBodyFound](const ServerEvent<Events::BodyFound>& ev) {
-		Logger::Debug("{} BodyFound: {}", ev.Timestamp, ev.json.dump());
-
-		auto const& id = ev.Value.DeadBody.RepositoryId;
-
-		if (ev.Value.DeadBody.IsCrowdActor) {
-			if (this->IsContractEnded()) return;
-			++stats.bodies.foundCrowd;
-		}
-		else {
-			for (auto it = stats.witnessEvents.rbegin(); it != stats.witnessEvents.rend(); ++it) {
-				if (it->timestamp != ev.Timestamp) break; // floating-point equality comparison - should be low enough precision to be fine?
-				if (it->event != Events::MurderedBodySeen) continue;
-				if (!it->bodyId.empty()) continue;
-				it->bodyId = id;
-				onRealBodyFound(*it);
-			}
-		}
-	});
-	events.listen<Events::Disguise>([this](const ServerEvent<Events::Disguise>& ev) {
-		++stats.misc.disguisesTaken;
-		stats.misc.suitRetrieved = false;
-
-		auto entry = this->GetRepoEntry(ev.Value.value);
-		if (entry) {
-			auto isHitmanSuit = entry->value("IsHitmanSuit", false);
-			if (isHitmanSuit) stats.misc.suitRetrieved = true;
-		}
-	});
-	events.listen<Events::SituationContained>([this](const ServerEvent<Events::SituationContained>& ev) {
-		++stats.detection.situationsContained;
-	});
-	events.listen<Events::TargetBodySpotted>([this](const ServerEvent<Events::TargetBodySpotted>& ev) {
-		if (this->IsContractEnded()) return;
-		++stats.bodies.targetsFound;
-	});
-	events.listen<Events::BodyHidden>([this](const ServerEvent<Events::BodyHidden>& ev) {
-		if (this->IsContractEnded()) return;
-		++stats.bodies.hidden;
-	});
-	events.listen<Events::BodyBagged>([this](const ServerEvent<Events::BodyBagged>& ev) {
-		if (this->IsContractEnded()) return;
-		++stats.bodies.bagged;
-	});
-	events.listen<Events::AllBodiesHidden>([this](const ServerEvent<Events::AllBodiesHidden>& ev) {
-		if (this->IsContractEnded()) return;
-		stats.bodies.allHidden = true;
-	});
-	events.listen<Events::ShotsFired>([this](const ServerEvent<Events::ShotsFired>& ev) {
-		// not much we can do without a live update?
-		stats.misc.shotsFired = ev.Value.Total;
-	});
-	events.listen<Events::Spotted>([this](const ServerEvent<Events::Spotted>& ev) {
-		if (this->IsContractEnded()) return;
-
-		for (const auto& name : ev.Value.value) {
-			auto isTarget = this->IsRepoIdTargetNPC(name);
-
-			if (!stats.spottedBy.contains(name)) {
-				Logger::Info("Stealthometer: spotted by {} - Target: {}", name, isTarget);
-
-				if (stats.firstSpottedByName.empty()) {
-					auto realName = this->GetNPCName(name);
-					if (realName) {
-						stats.firstSpottedByID = name;
-						stats.firstSpottedByName = *realName;
-					}
-				}
-
-				++stats.detection.spotted;
-				stats.spottedBy.insert(name);
-
-				if (isTarget) {
-					// It's possible for the spotted event to fire right AFTER the target died. Handle this dumb edge case.
-					if (stats.kills.targets.contains(name)) continue;
-
-					stats.targetsSpottedBy.insert(name);
-				}
-
-				stats.detection.nonTargetsSpottedBy = static_cast<int>(stats.spottedBy.size()) - stats.targetsSpottedBy.size();
-			}
-		}
-	});
-	events.listen<Events::Witnesses>([this](const ServerEvent<Events::Witnesses>& ev) {
-		if (this->IsContractEnded()) return;
-
-		for (const auto& name : ev.Value.value) {
-			// It's possible for the witnesses event to fire right AFTER the NPC died. Handle this dumb edge case.
-			if (stats.kills.targets.contains(name) || stats.kills.nonTargets.contains(name)) continue;
-
-			stats.witnesses.insert(name);
-		}
-	});
-	events.listen<Events::DisguiseBlown>([this](const ServerEvent<Events::DisguiseBlown>& ev) {
-		if (this->IsContractEnded()) return;
-
-		stats.current.disguiseBlown = true;
-		stats.disguisesBlown.insert(ev.Value.value);
-	});
-	events.listen<Events::BrokenDisguiseCleared>([this](const ServerEvent<Events::BrokenDisguiseCleared>& ev) {
-		if (this->IsContractEnded()) return;
-
-		stats.current.disguiseBlown = false;
-		stats.disguisesBlown.erase(ev.Value.value);
-	});
-	events.listen<Events::_47_FoundTrespassing>([this](const ServerEvent<Events::_47_FoundTrespassing>& ev) {
-		if (this->IsContractEnded()) return;
-
-		++stats.detection.caughtTrespassing;
-	});
-	events.listen<Events::TargetEliminated>([this](const ServerEvent<Events::TargetEliminated>& ev) {
-		//++stats.kills.targets; // is this event sent in all target kill cases?
-	});
-	events.listen<Events::Door_Unlocked>([this](const ServerEvent<Events::Door_Unlocked>& ev) {
-		if (this->IsContractEnded()) return;
-
-		++stats.misc.doorsUnlocked;
-	});
-	events.listen<Events::CrowdNPC_Died>([this](const ServerEvent<Events::CrowdNPC_Died>& ev) {
-		if (this->IsContractEnded()) return;
-
-		++stats.kills.total;
-		++stats.kills.crowd;
-		++stats.kills.civilian;
-	});
-	events.listen<Events::NoticedKill>([this](const ServerEvent<Events::NoticedKill>& ev) {
-		if (this->IsContractEnded()) return;
-
-		Logger::Debug("{} NoticedKill: {}", ev.Timestamp, ev.json.dump());
-
-		// TODO:
-		//ev.Value.RepositoryId
-		//ev.Value.IsTarget
-		auto const& value = ev.Value;
-		auto const noticedKillInfoIt = stats.kills.noticedKillInfos.find(value.RepositoryId);
-		auto const killAlreadyNoticed = noticedKillInfoIt != stats.kills.noticedKillInfos.end();
-		auto const killAlreadyNoticedByNonTarget = killAlreadyNoticed && noticedKillInfoIt->second.isSightedByNonTarget;
-		auto witnessId = std::string("");
-
-		for (auto it = stats.witnessEvents.crbegin(); it != stats.witnessEvents.crend(); ++it) {
-			if (it->timestamp != ev.Timestamp) break;
-			if (!it->witnessId.empty()) {
-				witnessId = it->witnessId;
-				break;
-			}
-		}
-
-		stats.witnessEvents.emplace_back(ev.Timestamp, Events::NoticedKill, witnessId, false, value.RepositoryId);
-
-		if (killAlreadyNoticed) {
-			if (value.IsTarget) {
-				//stats.targetKillNoticers.emplace(value.)
-			}
-		}
-
-		++stats.kills.noticed;
-	});
-	events.listen<Events::Noticed_Pacified>([this](const ServerEvent<Events::Noticed_Pacified>& ev) {
-		if (this->IsContractEnded()) return;
-
-		// TODO:
-		//ev.Value.RepositoryId
-		//ev.Value.IsTarget
-		++stats.pacifies.noticed;
+		});
 	});
-	events.listen<Events::Unnoticed_Kill>([this](const ServerEvent<Events::Unnoticed_Kill>& ev) {
-		// TODO: ?
-		//ev.Value.RepositoryId
-		++stats.kills.unnoticed;
-		if (ev.Value.IsTarget)
-			++stats.kills.unnoticedTarget;
-		else
-			++stats.kills.unnoticedNonTarget;
-	});
-	events.listen<Events::Unnoticed_Pacified>([this](const ServerEvent<Events::Unnoticed_Pacified>& ev) {
-		// TODO: ?
-		//ev.Value.RepositoryId
-		++stats.pacifies.unnoticed;
-		if (!ev.Value.IsTarget)
-			++stats.pacifies.unnoticedNonTarget;
-	});
-	events.listen<Events::AmbientChanged>([this](const ServerEvent<Events::AmbientChanged>& ev) {
-		if (this->IsContractEnded()) return;
-
-		stats.current.tension = ev.Value.AmbientValue;
-
-		switch (ev.Value.AmbientValue) {
-		case EGameTension::EGT_Agitated:
-			Logger::Debug("Game tension: agitated - it actually happened!");
-			++stats.tension.agitated;
-			break;
-		case EGameTension::EGT_AlertedHigh:
-			++stats.tension.alertedHigh;
-			break;
-		case EGameTension::EGT_AlertedLow:
-			++stats.tension.alertedLow;
-			break;
-		case EGameTension::EGT_Arrest:
-			++stats.tension.arrest;
-			break;
-		case EGameTension::EGT_Combat:
-			++stats.tension.combat;
-			break;
-		case EGameTension::EGT_Hunting:
-			++stats.tension.hunting;
-			break;
-		case EGameTension::EGT_Searching:
-			++stats.tension.searching;
-			break;
-		}
-
-		if (isTensionHigher(ev.Value.PreviousAmbientValue, ev.Value.AmbientValue))
-			stats.tension.level += getTensionValue(ev.Value.AmbientValue) - getTensionValue(ev.Value.PreviousAmbientValue);
-	});
-	events.listen<Events::Pacify>([this](const ServerEvent<Events::Pacify>& ev) {
-		if (this->IsContractEnded()) return;
-
-		stats.bodies.allHidden = false;
-		++stats.pacifies.total;
-
-		if (ev.Value.IsTarget) stats.bodies.allTargetsHidden = false;
-		else ++stats.pacifies.nonTargets;
-
-		if (ev.Value.Accident) ++stats.pacifyMethods.accident;
-		if (ev.Value.KillClass == "melee") ++stats.pacifyMethods.melee;
-		if (ev.Value.KillMethodBroad == "throw") ++stats.pacifyMethods.thrown;
-
-		if (!ev.Value.IsTarget) {
-			if (ev.Value.ActorType == EActorType::eAT_Civilian) ++stats.pacifies.civilian;
-			else if (ev.Value.ActorType == EActorType::eAT_Guard) ++stats.pacifies.guard;
-		}
-	});
-	events.listen<Events::Kill>([this](const ServerEvent<Events::Kill>& ev) {
-		if (this->IsContractEnded()) return;
-
-		const auto& repoId = ev.Value.RepositoryId;
-		const auto isTarget = ev.Value.IsTarget;
-
-		stats.bodies.allHidden = false;
-		++stats.kills.total;
-
-		if (repoId == stats.firstSpottedByID) {
-			stats.firstSpottedByID = "";
-			stats.firstSpottedByName = "";
-		}
-		if (repoId == stats.firstBodyFoundByID) {
-			stats.firstBodyFoundByID = "";
-			stats.firstBodyFoundByName = "";
-		}
-
-		if (isTarget) {
-			auto res = stats.kills.targets.emplace(repoId);
-			if (res.second) {
-				if (stats.targetsSpottedBy.contains(repoId)) {
-					++stats.detection.targetsSpottedByAndKilled;
-					++stats.detection.uniqueNPCsCaughtByAndKilled;
-				}
-				else if (stats.spottedBy.contains(repoId)) {
-					stats.targetsSpottedBy.insert(repoId);
-					++stats.detection.targetsSpottedByAndKilled;
-					++stats.detection.uniqueNPCsCaughtByAndKilled;
-				}
-
-				if (stats.targetBodyWitnesses.contains(repoId))
-					++stats.bodies.targetBodyWitnessesKilled;
-			}
-		}
-		else if (ev.Value.KillContext == EDeathContext::eDC_NOT_HERO)
-			stats.kills.proxyDeaths.emplace(repoId);
-		else {
-			auto res = stats.kills.nonTargets.emplace(repoId);
-			if (res.second) {
-				if (ev.Value.ActorType == EActorType::eAT_Civilian) ++stats.kills.civilian;
-				if (ev.Value.ActorType == EActorType::eAT_Guard) ++stats.kills.guard;
-
-				if (stats.spottedBy.count(repoId))
-					++stats.detection.uniqueNPCsCaughtByAndKilled;
-			}
-
-			if (stats.firstNTKName.empty() && stats.firstNTKID != repoId) {
-				stats.firstNTKID = repoId;
-				auto name = this->GetNPCName(repoId);
-				if (name) {
-					stats.firstNTKName = *name;
-				}
-			}
-		}
-
-		if (ev.Value.IsHeadshot) {
-			++stats.killMethods.headshot;
-			if (isTarget) ++stats.killMethods.headshotTarget;
-		}
-
-		if (ev.Value.KillClass == "melee") {
-			++stats.killMethods.melee;
-			if (isTarget) ++stats.killMethods.meleeTarget;
-		}
+}
 
-		if (ev.Value.KillMethodBroad == "throw") {
-			++stats.killMethods.thrown;
-			if (isTarget) ++stats.killMethods.thrownTarget;
-		}
-		else if (ev.Value.KillMethodBroad == "unarmed") {
-			++stats.killMethods.unarmed;
-			if (isTarget) ++stats.killMethods.unarmedTarget;
-		}
-		else if (ev.Value.KillMethodBroad == "pistol") {
-			++stats.killMethods.pistol;
-			if (isTarget) ++stats.killMethods.pistolTarget;
-		}
-		else if (ev.Value.KillMethodBroad == "smg") {
-			++stats.killMethods.smg;
-			if (isTarget) ++stats.killMethods.smgTarget;
-		}
-		else if (ev.Value.KillMethodBroad == "shotgun") {
-			++stats.killMethods.shotgun;
-			if (isTarget) ++stats.killMethods.shotgunTarget;
-		}
-		else if (ev.Value.KillMethodBroad == "close_combat_pistol_elimination") {
-			++stats.killMethods.pistolElim;
-			if (isTarget) ++stats.killMethods.pistolElimTarget;
-		}
+auto Stealthometer::OnDrawUI(bool focused) -> void {
+	auto const profile = ProfileScope(ProfileSection::DrawUI);
+	Timeline::setThreadName("UI");
 
-		if (ev.Value.Accident) {
-			++stats.killMethods.accident;
-			if (isTarget) ++stats.killMethods.accidentTarget;
+	AcquireSRWLockShared(&this->eventLock);
+	this->DrawExpandedStatsUI(focused);
+	this->DrawOverlayUI(focused);
+	ReleaseSRWLockShared(&this->eventLock);
 
-			if (ev.Value.KillMethodStrict == "accident_drown") {
-				++stats.killMethods.drown;
-				if (isTarget) ++stats.killMethods.drownTarget;
-			}
-			else if (ev.Value.KillMethodStrict == "accident_push") {
-				++stats.killMethods.push;
-				if (isTarget) ++stats.killMethods.pushTarget;
-			}
-			else if (ev.Value.KillMethodStrict == "accident_burn") {
-				++stats.killMethods.burn;
-				if (isTarget) ++stats.killMethods.burnTarget;
-			}
-			else if (ev.Value.KillMethodStrict == "accident_explosion") {
-				++stats.killMethods.accidentExplosion;
-				if (isTarget) ++stats.killMethods.accidentExplosionTarget;
-			}
-			else if (ev.Value.KillMethodStrict == "accident_suspended_object") {
-				++stats.killMethods.fallingObject;
-				if (isTarget) ++stats.killMethods.fallingObjectTarget;
-			}
-			else if (ev.Value.KillMethodStrict.size()) {
-				Logger::Info("Stealthometer: Unhandled KillMethodStrict '{}'", ev.Value.KillMethodStrict);
-			}
-		}
+	this->DrawLiveSplitUI(focused);
 
-		if (ev.Value.WeaponSilenced) {
-			++stats.killMethods.silencedWeapon;
-			if (isTarget) ++stats.killMethods.silencedWeaponTarget;
-		}
+	if (!this->statVisibleUI) return;
 
-		auto witnessIt = stats.witnesses.find(repoId);
-		if (witnessIt != stats.witnesses.end()) {
-			stats.witnesses.erase(witnessIt);
-			++stats.detection.witnessesKilled;
-		}
-	});
-	events.listen<Events::setpieces>([this](const ServerEvent<Events::setpieces>& ev) {
-		// Photo taken
-		// {"Timestamp":14.068766,"Name":"setpieces","ContractSessionId":"2517189686363575049-c894c9d2-b984-4c5b-ad0a-2be27e3b04f5","ContractId":"d2419fe4-ea72-4e61-b91b-bb39706f551d","Value":{"RepositoryId":"6c3fa06e-7478-4484-81e6-f08dba1722eb","name_metricvalue":"NotAvailable","setpieceHelper_metricvalue":"Camera","setpieceType_metricvalue":"picturetaken","toolUsed_metricvalue":"NA","Item_triggered_metricvalue":"NA","Position":"ZDynamicObject::ToString() unknown type: SVector3"},"UserId":"b1585b4d-36f0-48a0-8ffa-1b72f01759da","SessionId":"61e82efa0bcb4a3088825dd75e115f61-2846824114","Origin":"gameclient","Id":"971f62e0-e3d9-4ad3-8c16-bfc7fd2fa8a8"}
-
-		// Reporter camera destroyed
-		// {"Timestamp":405.325409,"Name":"ItemDestroyed","ContractSessionId":"64e8780e-00bb-45d1-a270-ff1df03082de","ContractId":"00000000-0000-0000-0000-000000000200","Value":{"ItemName":"ActItem_Camera"},"UserId":"00000000-0000-0000-0000-000000000000","SessionId":"","Origin":"gameclient","Id":"9ce9fbf2-e001-42cc-a715-9bae8423285d"}
-
-		// Look at evacuation plan in Paris, basement security room
-		// { "Timestamp":1030.322388, "Name" : "setpieces", "ContractSessionId" : "64e8780e-00bb-45d1-a270-ff1df03082de", "ContractId" : "00000000-0000-0000-0000-000000000200", "Value" : {"RepositoryId":"7093201b-ff82-465f-a187-7245d9057954", "name_metricvalue" : "Paris_Evac_plan", "setpieceHelper_metricvalue" : "Activator_NoTool", "setpieceType_metricvalue" : "DefaultActivators", "toolUsed_metricvalue" : "NA", "Item_triggered_metricvalue" : "NotAvailable", "Position" : "ZDynamicObject::ToString() unknown type: SVector3"}, "UserId" : "00000000-0000-0000-0000-000000000000", "SessionId" : "", "Origin" : "gameclient", "Id" : "bfabe0cf-cb92-4918-a716-b708f3fdc615" }
-		// { "Timestamp":1030.836670, "Name" : "setpieces", "ContractSessionId" : "64e8780e-00bb-45d1-a270-ff1df03082de", "ContractId" : "00000000-0000-0000-0000-000000000200", "Value" : {"RepositoryId":"7093201b-ff82-465f-a187-7245d9057954", "name_metricvalue" : "Paris_Evac_plan", "setpieceHelper_metricvalue" : "Activator_NoTool", "setpieceType_metricvalue" : "DefaultActivators", "toolUsed_metricvalue" : "NA", "Item_triggered_metricvalue" : "NotAvailable", "Position" : "ZDynamicObject::ToString() unknown type: SVector3"}, "UserId" : "00000000-0000-0000-0000-000000000000", "SessionId" : "", "Origin" : "gameclient", "Id" : "39f70b5d-8689-47bd-a765-a73067bd737d" }
-			
-		// Piano lid pushed down
-		// {"Timestamp":75.528625,"Name":"setpieces","ContractSessionId":"64e8780e-00bb-45d1-a270-ff1df03082de","ContractId":"00000000-0000-0000-0000-000000000200","Value":{"RepositoryId":"db6a820c-22ea-496e-a0f2-6823b32a911d","name_metricvalue":"Trap_Piano","setpieceHelper_metricvalue":"Activator_NoTool","setpieceType_metricvalue":"DefaultActivators","toolUsed_metricvalue":"NA","Item_triggered_metricvalue":"NotAvailable","Position":"ZDynamicObject::ToString() unknown type: SVector3"},"UserId":"00000000-0000-0000-0000-000000000000","SessionId":"","Origin":"gameclient","Id":"7260ec0d-98da-4aa1-b2e5-e2ad74d18db3"}
-		// { "Timestamp":75.629402, "Name" : "setpieces", "ContractSessionId" : "64e8780e-00bb-45d1-a270-ff1df03082de", "ContractId" : "00000000-0000-0000-0000-000000000200", "Value" : {"RepositoryId":"db6a820c-22ea-496e-a0f2-6823b32a911d", "name_metricvalue" : "Trap_Piano", "setpieceHelper_metricvalue" : "Activator_NoTool", "setpieceType_metricvalue" : "DefaultActivators", "toolUsed_metricvalue" : "NA", "Item_triggered_metricvalue" : "NotAvailable", "Position" : "ZDynamicObject::ToString() unknown type: SVector3"}, "UserId" : "00000000-0000-0000-0000-000000000000", "SessionId" : "", "Origin" : "gameclient", "Id" : "0fdcc023-01f6-4a15-b2f5-2c786ddf47fe" }
-		// { "Timestamp":76.096695, "Name" : "setpieces", "ContractSessionId" : "64e8780e-00bb-45d1-a270-ff1df03082de", "ContractId" : "00000000-0000-0000-0000-000000000200", "Value" : {"RepositoryId":"ab388850-d6cc-4e5c-a4a2-76bb22ca8f73", "name_metricvalue" : "NotAvailable", "setpieceHelper_metricvalue" : "DistractionLogic", "setpieceType_metricvalue" : "DistractionTriggered", "toolUsed_metricvalue" : "NA", "Item_triggered_metricvalue" : "NotAvailable", "Position" : "ZDynamicObject::ToString() unknown type: SVector3"}, "UserId" : "00000000-0000-0000-0000-000000000000", "SessionId" : "", "Origin" : "gameclient", "Id" : "26758af1-b9f6-4892-b33c-644bf2522a02" }
-
-		// Loudspeaker shot down
-		// {"Timestamp":110.426361,"Name":"setpieces","ContractSessionId":"64e8780e-00bb-45d1-a270-ff1df03082de","ContractId":"00000000-0000-0000-0000-000000000200","Value":{"RepositoryId":"2d7a91b9-1b3a-4db3-a8bf-6249db70c339","name_metricvalue":"Loudspeaker","setpieceHelper_metricvalue":"SuspendedObject","setpieceType_metricvalue":"trap","toolUsed_metricvalue":"NA","Item_triggered_metricvalue":"NA","Position":"ZDynamicObject::ToString() unknown type: SVector3"},"UserId":"00000000-0000-0000-0000-000000000000","SessionId":"","Origin":"gameclient","Id":"744fbb86-b8d1-47e0-b206-fa79b80b259f"}
-
-		// Car blown up
-		// {"Timestamp":340.653961,"Name":"setpieces","ContractSessionId":"64e8780e-00bb-45d1-a270-ff1df03082de","ContractId":"00000000-0000-0000-0000-000000000200","Value":{"RepositoryId":"2b29d641-2a0d-4781-b2dd-0df02bc2674b","name_metricvalue":"NotAvailable","setpieceHelper_metricvalue":"PropHelper_Explosion","setpieceType_metricvalue":"trap","toolUsed_metricvalue":"Exploded","Item_triggered_metricvalue":"NotAvailable","Position":"ZDynamicObject::ToString() unknown type: SVector3"},"UserId":"00000000-0000-0000-0000-000000000000","SessionId":"","Origin":"gameclient","Id":"1233f4a1-fafc-43db-a746-972af85d28dc"}
-
-		// Fuse box turned off
-		// {"Timestamp":35.705559,"Name":"setpieces","ContractSessionId":"3b541fce-5498-42bd-b853-b07526a07593","ContractId":"00000000-0000-0000-0000-000000000200","Value":{"RepositoryId":"e29d8ce5-64d6-4207-a55d-ebe5e84b16b3","name_metricvalue":"NotAvailable","setpieceHelper_metricvalue":"Activator_NoTool","setpieceType_metricvalue":"DefaultActivators","toolUsed_metricvalue":"NA","Item_triggered_metricvalue":"NotAvailable","Position":"ZDynamicObject::ToString() unknown type: SVector3"},"UserId":"00000000-0000-0000-0000-000000000000","SessionId":"","Origin":"gameclient","Id":"72ea0e72-4c48-4980-9341-c07c5000b7d4"}
-		// { "Timestamp":35.839172, "Name" : "setpieces", "ContractSessionId" : "3b541fce-5498-42bd-b853-b07526a07593", "ContractId" : "00000000-0000-0000-0000-000000000200", "Value" : {"RepositoryId":"e29d8ce5-64d6-4207-a55d-ebe5e84b16b3", "name_metricvalue" : "NotAvailable", "setpieceHelper_metricvalue" : "Activator_NoTool", "setpieceType_metricvalue" : "DefaultActivators", "toolUsed_metricvalue" : "NA", "Item_triggered_metricvalue" : "NotAvailable", "Position" : "ZDynamicObject::ToString() unknown type: SVector3"}, "UserId" : "00000000-0000-0000-0000-000000000000", "SessionId" : "", "Origin" : "gameclient", "Id" : "88fc03bf-2fc4-466d-9356-1c74210cace4" }
-
-		// Blown up propane:
-		// {"Timestamp":136.863831,"Name":"setpieces","ContractSessionId":"2517213287667595942-d688bab6-034a-488b-a483-89cfac74656f","ContractId":"00000000-0000-0000-0000-000000000400","Value":{"RepositoryId":"2b29d641-2a0d-4781-b2dd-0df02bc2674b","name_metricvalue":"PropaneFlask","setpieceHelper_metricvalue":"PropHelper_Explosion","setpieceType_metricvalue":"trap","toolUsed_metricvalue":"Exploded","Item_triggered_metricvalue":"NotAvailable","Position":"ZDynamicObject::ToString() unknown type: SVector3"},"UserId":"b1585b4d-36f0-48a0-8ffa-1b72f01759da","SessionId":"61e82efa0bcb4a3088825dd75e115f61-2714020697","Origin":"gameclient","Id":"4dcd73fe-7d2c-443b-aeac-10cd279ec971"}
-
-		// Flooded sink:
-		// {"Timestamp":219.718857,"Name":"setpieces","ContractSessionId":"01e7cfb4-0c1d-4d6e-99dc-9a604f9e1be0","ContractId":"00000000-0000-0000-0000-000000000200","Value":{"RepositoryId":"95e7e530-dbd0-4e1a-95f6-8d5c165a7991","name_metricvalue":"NotAvailable","setpieceHelper_metricvalue":"Activator_NoTool","setpieceType_metricvalue":"DefaultActivators","toolUsed_metricvalue":"NA","Item_triggered_metricvalue":"NotAvailable","Position":"ZDynamicObject::ToString() unknown type: SVector3"},"UserId":"00000000-0000-0000-0000-000000000000","SessionId":"","Origin":"gameclient","Id":"c9b351ed-80ac-47c9-a73d-9fcd61c49ca5"}
-		// { "Timestamp":220.185089, "Name" : "setpieces", "ContractSessionId" : "01e7cfb4-0c1d-4d6e-99dc-9a604f9e1be0", "ContractId" : "00000000-0000-0000-0000-000000000200", "Value" : {"RepositoryId":"95e7e530-dbd0-4e1a-95f6-8d5c165a7991", "name_metricvalue" : "NotAvailable", "setpieceHelper_metricvalue" : "Activator_NoTool", "setpieceType_metricvalue" : "DefaultActivators", "toolUsed_metricvalue" : "NA", "Item_triggered_metricvalue" : "NotAvailable", "Position" : "ZDynamicObject::ToString() unknown type: SVector3"}, "UserId" : "00000000-0000-0000-0000-000000000000", "SessionId" : "", "Origin" : "gameclient", "Id" : "e40d4a1c-5c02-4431-a784-b0e944cf7ae4" }
-		// { "Timestamp":224.197235, "Name" : "setpieces", "ContractSessionId" : "01e7cfb4-0c1d-4d6e-99dc-9a604f9e1be0", "ContractId" : "00000000-0000-0000-0000-000000000200", "Value" : {"RepositoryId":"3678cc55-c327-4e79-ab1b-52553c58ec83", "name_metricvalue" : "NotAvailable", "setpieceHelper_metricvalue" : "DistractionLogic", "setpieceType_metricvalue" : "DistractionTriggered", "toolUsed_metricvalue" : "NA", "Item_triggered_metricvalue" : "NotAvailable", "Position" : "ZDynamicObject::ToString() unknown type: SVector3"}, "UserId" : "00000000-0000-0000-0000-000000000000", "SessionId" : "", "Origin" : "gameclient", "Id" : "97285361-ceb7-4f3c-a9e9-0e4352aa70c8" }
-			
-		// Shot down Shisha sign:
-		// {"Timestamp":6.376209,"Name":"setpieces","ContractSessionId":"2517213287667595942-d688bab6-034a-488b-a483-89cfac74656f","ContractId":"00000000-0000-0000-0000-000000000400","Value":{"RepositoryId":"2d7a91b9-1b3a-4db3-a8bf-6249db70c339","name_metricvalue":"\n\n","setpieceHelper_metricvalue":"SuspendedObject","setpieceType_metricvalue":"trap","toolUsed_metricvalue":"NA","Item_triggered_metricvalue":"NA","Position":"ZDynamicObject::ToString() unknown type : SVector3"},"UserId":"b1585b4d - 36f0 - 48a0 - 8ffa - 1b72f01759da","SessionId":"61e82efa0bcb4a3088825dd75e115f61 - 2714020697","Origin":"gameclient","Id":"46904050 - dd0b - 406f - a8ea - 8d56cbbca556"}
-			
-		// Oil drum ignited:
-		// {"Timestamp":158.045746,"Name":"setpieces","ContractSessionId":"2517213287667595942-d688bab6-034a-488b-a483-89cfac74656f","ContractId":"00000000-0000-0000-0000-000000000400","Value":{"RepositoryId":"032151ce-e0be-4847-aab4-1b40fcdc2bc7","name_metricvalue":"Explosive_OilDrum","setpieceHelper_metricvalue":"PropHelper_OilSpill_Flammable","setpieceType_metricvalue":"trap","toolUsed_metricvalue":"Exploded","Item_triggered_metricvalue":"NotAvailable","Position":"ZDynamicObject::ToString() unknown type: SVector3"},"UserId":"b1585b4d-36f0-48a0-8ffa-1b72f01759da","SessionId":"61e82efa0bcb4a3088825dd75e115f61-2714020697","Origin":"gameclient","Id":"4667bd34-ed17-4eef-a46a-370904d2fe47"}
-			
-		// Marrakesh Toilet Drop:
-		// {"Timestamp":422.665924,"Name":"setpieces","ContractSessionId":"2517213287667595942-d688bab6-034a-488b-a483-89cfac74656f","ContractId":"00000000-0000-0000-0000-000000000400","Value":{"RepositoryId":"e29d8ce5-64d6-4207-a55d-ebe5e84b16b3","name_metricvalue":"NotAvailable","setpieceHelper_metricvalue":"Activator_NoTool","setpieceType_metricvalue":"DefaultActivators","toolUsed_metricvalue":"NA","Item_triggered_metricvalue":"NotAvailable","Position":"ZDynamicObject::ToString() unknown type: SVector3"},"UserId":"b1585b4d-36f0-48a0-8ffa-1b72f01759da","SessionId":"61e82efa0bcb4a3088825dd75e115f61-2714020697","Origin":"gameclient","Id":"b81c3ad3-b4b6-45db-8f08-75ddeb5d919a"}
-		// {"Timestamp":423.392487,"Name":"setpieces","ContractSessionId":"2517213287667595942-d688bab6-034a-488b-a483-89cfac74656f","ContractId":"00000000-0000-0000-0000-000000000400","Value":{"RepositoryId":"2d7a91b9-1b3a-4db3-a8bf-6249db70c339","name_metricvalue":"ToiletDrop  ","setpieceHelper_metricvalue":"SuspendedObject","setpieceType_metricvalue":"trap","toolUsed_metricvalue":"NA","Item_triggered_metricvalue":"NA","Position":"ZDynamicObject::ToString() unknown type: SVector3"},"UserId":"b1585b4d-36f0-48a0-8ffa-1b72f01759da","SessionId":"61e82efa0bcb4a3088825dd75e115f61-2714020697","Origin":"gameclient","Id":"a533b4d4-6cfc-4f35-8f77-42e62ee9a523"}
-		// {"Timestamp":423.649689,"Name":"setpieces","ContractSessionId":"2517213287667595942-d688bab6-034a-488b-a483-89cfac74656f","ContractId":"00000000-0000-0000-0000-000000000400","Value":{"RepositoryId":"e29d8ce5-64d6-4207-a55d-ebe5e84b16b3","name_metricvalue":"NotAvailable","setpieceHelper_metricvalue":"Activator_NoTool","setpieceType_metricvalue":"DefaultActivators","toolUsed_metricvalue":"NA","Item_triggered_metricvalue":"NotAvailable","Position":"ZDynamicObject::ToString() unknown type: SVector3"},"UserId":"b1585b4d-36f0-48a0-8ffa-1b72f01759da","SessionId":"61e82efa0bcb4a3088825dd75e115f61-2714020697","Origin":"gameclient","Id":"4990e672-515a-441a-8f9e-63c57284026c"}
-			
-		// Gas canister boom:
-		// {"Timestamp":468.406860,"Name":"setpieces","ContractSessionId":"2517213287667595942-d688bab6-034a-488b-a483-89cfac74656f","ContractId":"00000000-0000-0000-0000-000000000400","Value":{"RepositoryId":"e4bc6f9e-def7-4155-9524-16da8d68d4ad","name_metricvalue":"GasCanister_Large_A","setpieceHelper_metricvalue":"PropHelper_Explosion","setpieceType_metricvalue":"trap","toolUsed_metricvalue":"Exploded","Item_triggered_metricvalue":"NotAvailable","Position":"ZDynamicObject::ToString() unknown type: SVector3"},"UserId":"b1585b4d-36f0-48a0-8ffa-1b72f01759da","SessionId":"61e82efa0bcb4a3088825dd75e115f61-2714020697","Origin":"gameclient","Id":"d8133825-e9ef-4d0d-b5b3-a23db08758e1"}
-
-		// Small oil lamp (distraction object in Reza's office) destroyed:
-		// {"Timestamp":466.942963,"Name":"setpieces","ContractSessionId":"2517213287667595942-d688bab6-034a-488b-a483-89cfac74656f","ContractId":"00000000-0000-0000-0000-000000000400","Value":{"RepositoryId":"997fbfe6-ba8b-41a0-91bb-366bef9bef9b","name_metricvalue":"OilLamp","setpieceHelper_metricvalue":"ShotAndImpulseListener","setpieceType_metricvalue":"trap","toolUsed_metricvalue":"OnImpact","Item_triggered_metricvalue":"NotAvailable","Position":"ZDynamicObject::ToString() unknown type: SVector3"},"UserId":"b1585b4d-36f0-48a0-8ffa-1b72f01759da","SessionId":"61e82efa0bcb4a3088825dd75e115f61-2714020697","Origin":"gameclient","Id":"d3f6d21b-6817-4cdc-b4de-6fecf8982189"}
-		// {"Timestamp":466.963257,"Name":"setpieces","ContractSessionId":"2517213287667595942-d688bab6-034a-488b-a483-89cfac74656f","ContractId":"00000000-0000-0000-0000-000000000400","Value":{"RepositoryId":"0f0bb2c7-1cb3-4211-87ad-555df894026a","name_metricvalue":"OilLamp","setpieceHelper_metricvalue":"DistractionLogic_Visual","setpieceType_metricvalue":"DistractionTriggered","toolUsed_metricvalue":"NA","Item_triggered_metricvalue":"NotAvailable","Position":"ZDynamicObject::ToString() unknown type: SVector3"},"UserId":"b1585b4d-36f0-48a0-8ffa-1b72f01759da","SessionId":"61e82efa0bcb4a3088825dd75e115f61-2714020697","Origin":"gameclient","Id":"f220d7c8-e0fb-48f1-b4de-6fec5dfc41f3"}
-		// {"Timestamp":466.963257,"Name":"setpieces","ContractSessionId":"2517213287667595942-d688bab6-034a-488b-a483-89cfac74656f","ContractId":"00000000-0000-0000-0000-000000000400","Value":{"RepositoryId":"0f0bb2c7-1cb3-4211-87ad-555df894026a","name_metricvalue":"NotAvailable","setpieceHelper_metricvalue":"DistractionLogic_Visual","setpieceType_metricvalue":"DistractionFixed","toolUsed_metricvalue":"NA","Item_triggered_metricvalue":"NotAvailable","Position":"ZDynamicObject::ToString() unknown type: SVector3"},"UserId":"b1585b4d-36f0-48a0-8ffa-1b72f01759da","SessionId":"61e82efa0bcb4a3088825dd75e115f61-2714020697","Origin":"gameclient","Id":"a718105d-75f9-4d18-b4de-6fec660555f3"}
-
-		// Chandelier winch drop
-		// {"Timestamp":10.500926,"Name":"setpieces","ContractSessionId":"2517213274420850852-356e1881-82f8-4c5a-b7f1-63ab8432c042","ContractId":"00000000-0000-0000-0000-000000000200","Value":{"RepositoryId":"683a099f-5d1b-4800-a781-5d9dfe13b12c","name_metricvalue":"NotAvailable","setpieceHelper_metricvalue":"Activator_NoTool","setpieceType_metricvalue":"DefaultActivators","toolUsed_metricvalue":"NA","Item_triggered_metricvalue":"NotAvailable","Position":"ZDynamicObject::ToString() unknown type: SVector3"},"UserId":"b1585b4d-36f0-48a0-8ffa-1b72f01759da","SessionId":"61e82efa0bcb4a3088825dd75e115f61-2714020697","Origin":"gameclient","Id":"9fba84b6-85df-4d69-bd36-4376196d1202"}
-		// {"Timestamp":10.607255,"Name":"setpieces","ContractSessionId":"2517213274420850852-356e1881-82f8-4c5a-b7f1-63ab8432c042","ContractId":"00000000-0000-0000-0000-000000000200","Value":{"RepositoryId":"683a099f-5d1b-4800-a781-5d9dfe13b12c","name_metricvalue":"NotAvailable","setpieceHelper_metricvalue":"Activator_NoTool","setpieceType_metricvalue":"DefaultActivators","toolUsed_metricvalue":"NA","Item_triggered_metricvalue":"NotAvailable","Position":"ZDynamicObject::ToString() unknown type: SVector3"},"UserId":"b1585b4d-36f0-48a0-8ffa-1b72f01759da","SessionId":"61e82efa0bcb4a3088825dd75e115f61-2714020697","Origin":"gameclient","Id":"af42da25-9c48-44d1-bd46-3bb88cd91c88"}
-		// {"Timestamp":10.864028,"Name":"setpieces","ContractSessionId":"2517213274420850852-356e1881-82f8-4c5a-b7f1-63ab8432c042","ContractId":"00000000-0000-0000-0000-000000000200","Value":{"RepositoryId":"2d7a91b9-1b3a-4db3-a8bf-6249db70c339","name_metricvalue":"NotAvailable","setpieceHelper_metricvalue":"SuspendedObject","setpieceType_metricvalue":"trap","toolUsed_metricvalue":"NA","Item_triggered_metricvalue":"NA","Position":"ZDynamicObject::ToString() unknown type: SVector3"},"UserId":"b1585b4d-36f0-48a0-8ffa-1b72f01759da","SessionId":"61e82efa0bcb4a3088825dd75e115f61-2714020697","Origin":"gameclient","Id":"ad4e6c9d-4438-4fc1-bd6d-9697fe6ad6f0"}
-		// {"Timestamp":11.463453,"Name":"Investigate_Curious","ContractSessionId":"2517213274420850852-356e1881-82f8-4c5a-b7f1-63ab8432c042","ContractId":"00000000-0000-0000-0000-000000000200","Value":{"ActorId":2655118168.000000,"RepositoryId":"f9c3905a-ec94-43b6-aae6-8b2f752467f7","SituationType":"AIS_INVESTIGATE_CURIOUS","EventType":"AISE_ActorJoined","JoinReason":"AISJR_Default","InvestigationType":9.000000},"UserId":"b1585b4d-36f0-48a0-8ffa-1b72f01759da","SessionId":"61e82efa0bcb4a3088825dd75e115f61-2714020697","Origin":"gameclient","Id":"8ad219e4-5222-4f7b-bdc8-b6224db5aa6d"}
-		Logger::Info("Setpieces: {}", nlohmann::json{
-			{"name_metricvalue", ev.Value.name_metricvalue},
-			{"setpieceHelper_metricvalue", ev.Value.setpieceHelper_metricvalue},
-			{"setpieceType_metricvalue", ev.Value.setpieceType_metricvalue},
-			{"setpieceType_metricvalue", ev.Value.setpieceType_metricvalue},
-			{"Item_triggered_metricvalue", ev.Value.Item_triggered_metricvalue},
-			{"RepositoryId", ev.Value.RepositoryId},
-		}.dump());
-	});
-	//eventName == "ItemDestroyed" // broken camcorder
-	//eventName == "TargetEscapeFoiled" // Yuki killed in Gondola
+	this->DrawSettingsUI(focused);
 }
 
+
 DEFINE_PLUGIN_DETOUR(Stealthometer, void*, OnLoadingScreenActivated, void* th, void* a1) {
 	loadingScreenActivated = true;
 	if (!loadRemovalActive) {
 		liveSplitClient.pause();
 		loadRemovalActive = true;
+		this->loadRemovalStart = Profiler::Clock::now();
 	}
 	return HookResult<void*>(HookAction::Continue());
 }
 
-DEFINE_PLUGIN_DETOUR(Stealthometer, void, ZAchievementManagerSimple_OnEventSent, ZAchievementManagerSimple* th, uint32_t eventId, const ZDynamicObject& ev) {
-	ZString eventData;
-	Functions::ZDynamicObject_ToString->Call(const_cast<ZDynamicObject*>(&ev), eventData);
+auto Stealthometer::ProcessEvent(std::string_view eventData) -> void {
+	AcquireSRWLockExclusive(&this->eventLock);
 
-	auto eventDataSV = std::string_view(eventData.c_str(), eventData.size());
-	auto fixedEventDataStr = std::string(eventData.size(), '\0');
-	std::remove_copy(eventDataSV.cbegin(), eventDataSV.cend(), fixedEventDataStr.begin(), '\n');
+	auto data = eventData;
+	if (data.find('\n') != std::string_view::npos) {
+		this->strippedEvent.resize(eventData.size());
+		this->strippedEvent.erase(std::remove_copy(eventData.cbegin(), eventData.cend(), this->strippedEvent.begin(), '\n'), this->strippedEvent.end());
+		data = this->strippedEvent;
+	}
 
 	try {
-		auto json = nlohmann::json::parse(fixedEventDataStr.c_str(), fixedEventDataStr.c_str() + fixedEventDataStr.size());
-		auto const eventName = json.value("Name", "");
-		auto const timestamp = json.value("Timestamp", 0.0);
-
-		if (timestamp) lastEventTimestamp = timestamp;
-
-		if (!eventNameBlacklist.contains(eventName)) {
-			if (!events.handle(eventName, json))
-				Logger::Info("Unhandled Event Sent: {}", eventData);
-			else {
-				this->UpdateDisplayStats();
-				this->eventHistory.push_back(eventName);
-			}
-		}
+		this->HandleEvent(data);
 	}
 	catch (const nlohmann::json::exception& ex) {
 		Logger::Error("JSON exception: {}", ex.what());
 		Logger::Error("{}", eventData);
 	}
+	// This may be the event worker's thread, where anything uncaught would terminate the game.
+	catch (const std::exception& ex) {
+		Logger::Error("Exception handling event: {}", ex.what());
+		Logger::Error("{}", eventData);
+	}
+	catch (...) {
+		Logger::Error("Unknown exception handling event");
+		Logger::Error("{}", eventData);
+	}
+
+	ReleaseSRWLockExclusive(&this->eventLock);
+}
+
+DEFINE_PLUGIN_DETOUR(Stealthometer, void, ZAchievementManagerSimple_OnEventSent, ZAchievementManagerSimple* th, uint32_t eventId, const ZDynamicObject& ev) {
+	auto const profile = ProfileScope(ProfileSection::EventSent);
+	auto const start = Profiler::Clock::now();
+	ZString eventData;
+	Functions::ZDynamicObject_ToString->Call(const_cast<ZDynamicObject*>(&ev), eventData);
+	Profiler::getSection(ProfileSection::EventStringify).record(Profiler::getNanoseconds(start));
+
+	auto eventDataSV = std::string_view(eventData.c_str(), eventData.size());
+
+	if (this->journal.isOpen())
+		this->journal.write(eventDataSV, this->frameCount);
+
+	// With threaded processing, the game thread only pays for copying the event into the worker's ring. An event too
+	// large for the ring is handled here once the worker has caught up, to keep events in order.
+	if (!this->eventWorker.isRunning() || !this->eventWorker.post(eventDataSV)) {
+		if (this->eventWorker.isRunning()) this->eventWorker.drain();
+		this->ProcessEvent(eventDataSV);
+	}
 
 	return HookResult<void>(HookAction::Continue());
 }
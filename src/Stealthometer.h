@@ -1,30 +1,28 @@
 #pragma once
-#include <random>
-#include <unordered_map>
-#include <unordered_set>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
 #include <vector>
 #include <IPluginInterface.h>
 #include <Glacier/ZEntity.h>
 #include <Glacier/ZInput.h>
 #include "json.hpp"
+#include "ActorTracker.h"
 #include "Config.h"
 #include "Events.h"
+#include "EventJournal.h"
+#include "EventSystem.h"
+#include "EventWorker.h"
 #include "LiveSplitClient.h"
+#include "RepoId.h"
 #include "RunData.h"
 #include "Stats.h"
+#include "StatTracker.h"
 #include "StatWindow.h"
-#include "util.h"
 
-struct ActorData
-{
-	const TEntityRef<ZActor>* ref = nullptr;
-	bool isTarget = false;
-	int highestTensionLevel = 0;
-	ECompiledBehaviorType lastFrameBehaviour = ECompiledBehaviorType::BT_Invalid;
-	std::string repoId;
-};
-
-class Stealthometer : public IPluginInterface
+class Stealthometer : public IPluginInterface, protected StatTracker
 {
 public:
 	Stealthometer();
@@ -37,29 +35,29 @@ public:
 	auto OnFrameUpdateAlways(const SGameUpdateEvent&) -> void;
 	auto OnFrameUpdatePlayMode(const SGameUpdateEvent&) -> void;
 
-	auto NewContract() -> void;
-	auto UpdateDisplayStats() -> void;
-	auto CalculateStealthRating() -> double;
-	auto GetSilentAssassinStatus() const -> SilentAssassinStatus;
 	auto ProcessLoadRemoval() -> void;
 
 	auto InstallHooks() -> void;
 	auto UninstallHooks() -> void;
 
+protected:
+	auto NewContract() -> void override;
+
 private:
 	auto SetupEvents() -> void;
+	auto ProcessEvent(std::string_view eventData) -> void;
+	auto QueueRunAction(std::function<void()> action) -> void;
+	auto ProcessRunActions() -> void;
+	auto UpdateEventWorker() -> void;
+	auto UpdateJournal() -> void;
+	auto UpdateTrace() -> void;
+	auto UpdateTimeline() -> void;
+	auto WriteProfilerReport() -> void;
+	auto UpdateStatWindow() -> void;
 	auto DrawSettingsUI(bool focused) -> void;
 	auto DrawExpandedStatsUI(bool focused) -> void;
 	auto DrawLiveSplitUI(bool focused) -> void;
 	auto DrawOverlayUI(bool focused) -> void;
-	auto IsContractEnded() const -> bool;
-	auto IsRepoIdTargetNPC(const std::string& id) const -> bool;
-	auto GetRepoEntry(const std::string& id) -> const nlohmann::json*;
-	auto CreateItemInfo(const std::string& repoId) -> ItemInfo;
-	auto AddObtainedItem(const std::string& id, ItemInfo item) -> void;
-	auto RemoveObtainedItem(const std::string& id) -> int;
-	auto AddDisposedItem(const std::string& id, ItemInfo item) -> void;
-	auto GetNPCName(const std::string& id) -> const std::string*;
 
 private:
 	//DEFINE_PLUGIN_DETOUR(Stealthometer, void, ZGameStatsManager_SendAISignals, ZGameStatsManager* th);
@@ -68,26 +66,24 @@ private:
 
 private:
 	SRWLOCK eventLock = {};
-	Stats stats;
-	DisplayStats displayStats;
+	// Events with the newlines stripped, for those that have any. Reused under eventLock so handling doesn't allocate.
+	std::string strippedEvent;
 	StatWindow window;
-	EventSystem events;
+	EventWorker eventWorker;
+	EventJournalWriter journal;
 	Config config;
 	LiveSplitClient liveSplitClient;
-	std::unordered_set<std::string, StringHashLowercase, InsensitiveCompare> freelanceTargets;
-	std::array<ActorData, 1000> actorData;
-	std::vector<std::string> eventHistory;
-	std::mt19937 randomGenerator;
-	std::unordered_map<std::string, nlohmann::json, StringHashLowercase, InsensitiveCompare> repo;
-	std::unordered_map<std::string, std::string, StringHashLowercase, InsensitiveCompare> npcNames;
+	ActorTracker actors;
 
+	// LiveSplit and the run data are only touched from the game thread. Event handlers (possibly on the event worker)
+	// and the UI queue what they need done with them here.
+	std::mutex runActionsMutex;
+	std::vector<std::function<void()>> runActions;
+	std::vector<std::function<void()>> runActionsProcessing;
 	RunData runData;
 	FreelancerRunData freelancer;
 
-	int npcCount = 0;
-	double cutsceneEndTime = 0;
-	double missionEndTime = 0;
-	double lastEventTimestamp = 0;
+	uint64_t frameCount = 0;
 	bool hooksInstalled = false;
 	bool statVisibleUI = false;
 	bool externalWindowEnabled = true;
@@ -99,12 +95,17 @@ private:
 	bool killsWindowOpen = false;
 	bool pacifiesWindowOpen = false;
 	bool miscWindowOpen = false;
+	bool memoryWindowOpen = false;
+	bool eventsWindowOpen = false;
+	bool profilerWindowOpen = false;
 	ImVec2 overlaySize = {};
 
 	bool loadRemovalActive = false;
 	bool isLoadingScreenCheckHasBeenTrue = false;
 	bool loadingScreenActivated = false;
 	bool startAfterLoad = false;
+	// When load removal last became active, for the timeline.
+	std::chrono::steady_clock::time_point loadRemovalStart;
 };
 
 DEFINE_ZHM_PLUGIN(Stealthometer)
@@ -0,0 +1,31 @@
+#pragma once
+#include <unordered_set>
+#include "Memory.h"
+#include "RepoId.h"
+
+// Repository IDs of the NPCs which are targets in the current contract, from the actors the game flags as contract
+// targets and from AddSyndicateTarget events.
+class TargetRegistry
+{
+public:
+	auto clear() -> void {
+		this->ids.clear();
+	}
+
+	// Returns true if the ID wasn't already registered.
+	auto add(const RepoId& id) -> bool {
+		if (id.empty()) return false;
+		return this->ids.insert(id).second;
+	}
+
+	auto contains(const RepoId& id) const -> bool {
+		return this->ids.contains(id);
+	}
+
+	auto size() const -> size_t {
+		return this->ids.size();
+	}
+
+private:
+	CountedUnorderedSet<RepoId, MemorySubsystem::Targets> ids;
+};
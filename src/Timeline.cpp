@@ -0,0 +1,296 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "EventNames.h"
+#include "RecordRing.h"
+#include "Timeline.h"
+
+namespace
+{
+	using Clock = Profiler::Clock;
+
+	// LiveSplit writes are put on a track of their own, after those of the threads.
+	constexpr uint32_t LiveSplitTrack = 1000;
+
+	struct Track
+	{
+		RecordRing<ProfileSpan, 16384> ring;
+		std::atomic<const char*> name = nullptr;
+		uint32_t id = 0;
+	};
+
+	// Gives the thread's track back to the writer when the thread exits.
+	struct TrackOwner
+	{
+		Track* track = nullptr;
+
+		~TrackOwner();
+	};
+
+	thread_local const char* threadName = nullptr;
+	thread_local TrackOwner threadTrack;
+
+	// The tracks of every thread which has recorded a span, and the thread writing them out. A thread's track is given
+	// back when it exits, and once what's left in its ring is written, it gets a new id for the next thread to record to
+	// take it over. So threads being restarted don't keep adding rings, and each thread still has a track of its own.
+	class TimelineWriter
+	{
+	public:
+		~TimelineWriter() {
+			this->stop();
+		}
+
+		auto getTrack() -> Track& {
+			if (!threadTrack.track) threadTrack.track = this->acquireTrack();
+			return *threadTrack.track;
+		}
+
+		auto releaseTrack(Track& track) -> void {
+			auto lock = std::lock_guard(this->tracksMutex);
+			this->exitedTracks.push_back(&track);
+		}
+
+		auto start(const std::filesystem::path& path) -> bool {
+			auto lock = std::lock_guard(this->threadMutex);
+			if (this->thread.joinable()) return false;
+
+			this->file.open(path, std::ios::binary | std::ios::trunc);
+			if (!this->file) return false;
+
+			// Anything recorded after the last timeline stopped is from before this one.
+			this->forEachSpan([](const Track&, const ProfileSpan&) { });
+			{
+				auto tracksLock = std::lock_guard(this->tracksMutex);
+				this->retiredTracks.clear();
+			}
+
+			this->startTime = Clock::now().time_since_epoch().count();
+			this->buffer = "[";
+			this->first = true;
+			this->running = true;
+			this->thread = std::thread([this] { this->run(); });
+			Profiler::recordingTimeline = true;
+			return true;
+		}
+
+		auto stop() -> void {
+			auto lock = std::lock_guard(this->threadMutex);
+			if (!this->thread.joinable()) return;
+
+			Profiler::recordingTimeline = false;
+			this->running = false;
+			this->thread.join();
+
+			// Names are written last, so a track named after it first recorded still gets one.
+			this->appendMetadata("process_name", 0, "Stealthometer");
+			this->appendMetadata("thread_name", LiveSplitTrack, "LiveSplit");
+			{
+				auto tracksLock = std::lock_guard(this->tracksMutex);
+				for (auto const& track : this->tracks) {
+					if (std::ranges::find(this->freeTracks, track.get()) != this->freeTracks.end()) continue;
+					this->appendTrackName(track->id, track->name.load(std::memory_order_relaxed));
+				}
+				for (auto const& [id, name] : this->retiredTracks)
+					this->appendTrackName(id, name);
+			}
+			this->buffer += "\n]\n";
+			this->file << this->buffer;
+			this->buffer.clear();
+			this->file.close();
+		}
+
+		auto isRunning() -> bool {
+			return this->running;
+		}
+
+		std::atomic<uint64_t> recorded = 0;
+		std::atomic<uint64_t> dropped = 0;
+		std::atomic<uint64_t> written = 0;
+
+	private:
+		auto acquireTrack() -> Track* {
+			auto lock = std::lock_guard(this->tracksMutex);
+			auto track = static_cast<Track*>(nullptr);
+			if (this->freeTracks.empty())
+				track = this->tracks.emplace_back(std::make_unique<Track>()).get();
+			else {
+				track = this->freeTracks.back();
+				this->freeTracks.pop_back();
+			}
+			track->id = ++this->lastTrackId;
+			track->name = threadName;
+			return track;
+		}
+
+		auto run() -> void {
+			using namespace std::chrono_literals;
+
+			for (;;) {
+				auto const running = this->running.load();
+				this->write();
+				if (!running) break;
+				std::this_thread::sleep_for(20ms);
+			}
+		}
+
+		// Writes what each ring holds. Trace viewers sort spans themselves, so they're written as they're found.
+		auto write() -> void {
+			auto const count = this->forEachSpan([this](const Track& track, const ProfileSpan& span) { this->appendSpan(track, span); });
+			if (this->buffer.empty()) return;
+
+			this->file << this->buffer;
+			this->buffer.clear();
+			this->written.fetch_add(count, std::memory_order_relaxed);
+		}
+
+		template<typename TFunc>
+		auto forEachSpan(TFunc&& func) -> size_t {
+			auto lock = std::lock_guard(this->tracksMutex);
+			size_t count = 0;
+			for (auto const& track : this->tracks)
+				count += track->ring.drain([&](const ProfileSpan& span) { func(*track, span); });
+
+			// Their threads had exited before the rings were drained, so nothing more will be recorded to these. Their names
+			// are kept for the file's metadata.
+			for (auto const track : this->exitedTracks) {
+				this->retiredTracks.emplace_back(track->id, track->name.load(std::memory_order_relaxed));
+				this->freeTracks.push_back(track);
+			}
+			this->exitedTracks.clear();
+			return count;
+		}
+
+		auto appendSpan(const Track& track, const ProfileSpan& span) -> void {
+			auto const toMicroseconds = [](int64_t ticks) {
+				return std::chrono::duration<double, std::micro>(Clock::duration(ticks)).count();
+			};
+
+			auto name = std::string_view(span.name ? span.name : "");
+			auto category = "game";
+			auto event = std::string_view();
+
+			if (span.section != ProfileSection::Count) {
+				// Section names are indented for the profiler's report.
+				name = Profiler::getSectionName(span.section);
+				name.remove_prefix(std::min(name.find_first_not_of(' '), name.size()));
+				category = "mod";
+
+				if (span.event < EventCount) {
+					event = getEventName(static_cast<Events>(span.event));
+					category = "event";
+					if (span.section == ProfileSection::EventDispatch) name = event;
+				}
+			}
+
+			auto const tid = span.section == ProfileSection::LiveSplitSend ? LiveSplitTrack : track.id;
+			auto const ts = toMicroseconds(span.start - this->startTime);
+			char line[256];
+
+			if (span.section == ProfileSection::Count && span.end == span.start) {
+				std::snprintf(line, sizeof(line), R"({"name":"%.*s","cat":"%s","ph":"i","s":"t","ts":%.3f,"pid":1,"tid":%u})",
+					static_cast<int>(name.size()), name.data(), category, ts, tid);
+			}
+			else if (!event.empty() && name != event) {
+				std::snprintf(line, sizeof(line), R"({"name":"%.*s","cat":"%s","ph":"X","ts":%.3f,"dur":%.3f,"pid":1,"tid":%u,"args":{"event":"%.*s"}})",
+					static_cast<int>(name.size()), name.data(), category, ts, toMicroseconds(span.end - span.start), tid,
+					static_cast<int>(event.size()), event.data());
+			}
+			else {
+				std::snprintf(line, sizeof(line), R"({"name":"%.*s","cat":"%s","ph":"X","ts":%.3f,"dur":%.3f,"pid":1,"tid":%u})",
+					static_cast<int>(name.size()), name.data(), category, ts, toMicroseconds(span.end - span.start), tid);
+			}
+			this->appendLine(line);
+		}
+
+		auto appendMetadata(const char* kind, uint32_t tid, const std::string& name) -> void {
+			char line[256];
+			std::snprintf(line, sizeof(line), R"({"name":"%s","ph":"M","pid":1,"tid":%u,"args":{"name":"%s"}})", kind, tid, name.c_str());
+			this->appendLine(line);
+		}
+
+		auto appendTrackName(uint32_t id, const char* name) -> void {
+			this->appendMetadata("thread_name", id, name ? name : "Thread " + std::to_string(id));
+		}
+
+		auto appendLine(const char* line) -> void {
+			this->buffer += this->first ? "\n" : ",\n";
+			this->buffer += line;
+			this->first = false;
+		}
+
+	private:
+		std::mutex tracksMutex;
+		std::vector<std::unique_ptr<Track>> tracks;
+		// Tracks of threads that have exited, and those of them free for another thread once drained. A ring has one
+		// producer at a time, handed over under tracksMutex.
+		std::vector<Track*> exitedTracks;
+		std::vector<Track*> freeTracks;
+		// The ids and names tracks had before being taken over, since this timeline started.
+		std::vector<std::pair<uint32_t, const char*>> retiredTracks;
+		uint32_t lastTrackId = 0;
+		std::mutex threadMutex;
+		std::thread thread;
+		std::atomic<bool> running = false;
+		std::ofstream file;
+		std::string buffer;
+		bool first = true;
+		int64_t startTime = 0;
+	};
+
+	TimelineWriter writer;
+
+	TrackOwner::~TrackOwner() {
+		if (this->track) writer.releaseTrack(*this->track);
+	}
+}
+
+auto Profiler::recordSpan(const ProfileSpan& span) -> void {
+	if (writer.getTrack().ring.push(span))
+		writer.recorded.fetch_add(1, std::memory_order_relaxed);
+	else
+		writer.dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+auto Timeline::start(const std::filesystem::path& path) -> bool {
+	return writer.start(path);
+}
+
+auto Timeline::stop() -> void {
+	writer.stop();
+}
+
+auto Timeline::isRunning() -> bool {
+	return writer.isRunning();
+}
+
+auto Timeline::getCounters() -> Counters {
+	return Counters{
+		.recorded = writer.recorded.load(std::memory_order_relaxed),
+		.dropped = writer.dropped.load(std::memory_order_relaxed),
+		.written = writer.written.load(std::memory_order_relaxed),
+	};
+}
+
+auto Timeline::setThreadName(const char* name) -> void {
+	threadName = name;
+	if (threadTrack.track) threadTrack.track->name.store(name, std::memory_order_relaxed);
+}
+
+auto Timeline::mark(const char* name) -> void {
+	if (!Profiler::isRecordingTimeline()) return;
+	auto const now = Clock::now().time_since_epoch().count();
+	Profiler::recordSpan(ProfileSpan{.start = now, .end = now, .name = name});
+}
+
+auto Timeline::span(const char* name, Profiler::Clock::time_point start, Profiler::Clock::time_point end) -> void {
+	if (!Profiler::isRecordingTimeline()) return;
+	Profiler::recordSpan(ProfileSpan{.start = start.time_since_epoch().count(), .end = end.time_since_epoch().count(), .name = name});
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include "Profiler.h"
+
+// Writes what the profiler times as it happens, to a Chrome trace-event file (the JSON array format) that
+// chrome://tracing and Perfetto open as a timeline. Each thread gets a track, with LiveSplit writes on one of their
+// own whichever thread sent them. Spans go into a ring for the recording thread, and a background thread turns them
+// into JSON and writes them out, so the game thread never formats or waits on the file.
+namespace Timeline
+{
+	struct Counters
+	{
+		uint64_t recorded = 0;
+		uint64_t dropped = 0;
+		uint64_t written = 0;
+	};
+
+	// Starts recording to a new file at the path. Returns false if it couldn't be created or one is already open.
+	auto start(const std::filesystem::path& path) -> bool;
+	// Stops recording, then writes what's left and closes the file.
+	auto stop() -> void;
+	auto isRunning() -> bool;
+	auto getCounters() -> Counters;
+
+	// Names the calling thread's track. Takes a string literal, and is cheap enough to call every frame.
+	auto setThreadName(const char* name) -> void;
+
+	// A marker now, or a span from start to end, on the calling thread's track. The name must be a string literal.
+	auto mark(const char* name) -> void;
+	auto span(const char* name, Profiler::Clock::time_point start, Profiler::Clock::time_point end) -> void;
+}
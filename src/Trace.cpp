@@ -0,0 +1,222 @@
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Enums.h"
+#include "Log.h"
+#include "Trace.h"
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	// The rings of every thread which has traced, and the thread formatting them. A thread's ring is given back when it
+	// exits, for the next thread to trace to take over, so threads being restarted don't keep adding rings. Rings are
+	// only freed with the tracer, as what a thread recorded may not have been formatted yet when it exits.
+	class Tracer
+	{
+	public:
+		~Tracer() {
+			this->stop();
+		}
+
+		auto getRing() -> TraceRing& {
+			thread_local auto owner = RingOwner{.tracer = this};
+			if (!owner.ring) owner.ring = this->acquireRing();
+			return *owner.ring;
+		}
+
+		auto start() -> void {
+			auto lock = std::lock_guard(this->threadMutex);
+			if (this->thread.joinable()) return;
+
+			this->startTime = Clock::now().time_since_epoch().count();
+			this->running = true;
+			this->thread = std::thread([this] { this->run(); });
+			Trace::enabled = true;
+		}
+
+		auto stop() -> void {
+			auto lock = std::lock_guard(this->threadMutex);
+			if (!this->thread.joinable()) return;
+
+			Trace::enabled = false;
+			this->running = false;
+			this->thread.join();
+		}
+
+		auto isRunning() -> bool {
+			return this->running;
+		}
+
+		std::atomic<uint64_t> recorded = 0;
+		std::atomic<uint64_t> dropped = 0;
+		std::atomic<uint64_t> formatted = 0;
+
+	private:
+		struct RingOwner
+		{
+			Tracer* tracer = nullptr;
+			TraceRing* ring = nullptr;
+
+			~RingOwner() {
+				if (this->ring) this->tracer->releaseRing(*this->ring);
+			}
+		};
+
+		auto acquireRing() -> TraceRing* {
+			auto lock = std::lock_guard(this->ringsMutex);
+			if (this->freeRings.empty())
+				return this->rings.emplace_back(std::make_unique<TraceRing>()).get();
+
+			auto const ring = this->freeRings.back();
+			this->freeRings.pop_back();
+			return ring;
+		}
+
+		auto releaseRing(TraceRing& ring) -> void {
+			auto lock = std::lock_guard(this->ringsMutex);
+			this->freeRings.push_back(&ring);
+		}
+
+		auto run() -> void {
+			using namespace std::chrono_literals;
+
+			for (;;) {
+				auto const running = this->running.load();
+				this->drain();
+				if (!running) break;
+				std::this_thread::sleep_for(20ms);
+			}
+		}
+
+		// Formats what each ring holds, merged in the order it was recorded.
+		auto drain() -> void {
+			this->pending.clear();
+			{
+				auto lock = std::lock_guard(this->ringsMutex);
+				for (auto const& ring : this->rings)
+					ring->drain([this](const TraceRecord& record) { this->pending.push_back(record); });
+			}
+			if (this->pending.empty()) return;
+
+			std::stable_sort(this->pending.begin(), this->pending.end(), [](const TraceRecord& a, const TraceRecord& b) {
+				return a.time < b.time;
+			});
+
+			for (auto const& record : this->pending)
+				Logger::Info("{}", Trace::format(record, this->startTime));
+			this->formatted.fetch_add(this->pending.size(), std::memory_order_relaxed);
+		}
+
+	private:
+		std::mutex ringsMutex;
+		std::vector<std::unique_ptr<TraceRing>> rings;
+		// Rings of threads that have exited. A ring has one producer at a time, handed over under ringsMutex.
+		std::vector<TraceRing*> freeRings;
+		std::vector<TraceRecord> pending;
+		std::mutex threadMutex;
+		std::thread thread;
+		std::atomic<bool> running = false;
+		int64_t startTime = 0;
+	};
+
+	Tracer tracer;
+}
+
+auto Trace::push(TraceRecord record) -> void {
+	record.time = Clock::now().time_since_epoch().count();
+	if (tracer.getRing().push(record))
+		tracer.recorded.fetch_add(1, std::memory_order_relaxed);
+	else
+		tracer.dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+auto Trace::start() -> void {
+	tracer.start();
+}
+
+auto Trace::stop() -> void {
+	tracer.stop();
+}
+
+auto Trace::isRunning() -> bool {
+	return tracer.isRunning();
+}
+
+auto Trace::getCounters() -> Counters {
+	return Counters{
+		.recorded = tracer.recorded.load(std::memory_order_relaxed),
+		.dropped = tracer.dropped.load(std::memory_order_relaxed),
+		.formatted = tracer.formatted.load(std::memory_order_relaxed),
+	};
+}
+
+auto Trace::getEventName(TraceEvent event) -> const char* {
+	switch (event) {
+		case TraceEvent::BehaviourChanged: return "BehaviourChanged";
+		case TraceEvent::ActorSick: return "ActorSick";
+		case TraceEvent::AccidentBodyFound: return "AccidentBodyFound";
+		case TraceEvent::DeadBodySeen: return "DeadBodySeen";
+		case TraceEvent::MurderedBodySeen: return "MurderedBodySeen";
+		case TraceEvent::BodyFound: return "BodyFound";
+		case TraceEvent::NoticedKill: return "NoticedKill";
+	}
+	return "?";
+}
+
+auto Trace::format(const TraceRecord& record, int64_t start) -> std::string {
+	auto const seconds = std::chrono::duration<double>(Clock::duration(record.time - start)).count();
+	auto const& values = record.values;
+	auto line = std::format("Trace {:.6f} {}", seconds, getEventName(record.event));
+
+	switch (record.event) {
+		case TraceEvent::BehaviourChanged:
+			std::format_to(
+				std::back_inserter(line),
+				": actor {} {} {} tension {}",
+				record.actorIndex,
+				record.actor.toString(),
+				behaviourToString(static_cast<ECompiledBehaviorType>(values[0])),
+				values[1]
+			);
+			break;
+		case TraceEvent::ActorSick:
+			std::format_to(std::back_inserter(line), " {}: actor {} target {} type {}", record.timestamp, record.actor.toString(), values[0] != 0, values[1]);
+			break;
+		case TraceEvent::AccidentBodyFound:
+		case TraceEvent::BodyFound:
+			std::format_to(
+				std::back_inserter(line),
+				" {}: body {} crowd {} context {} type {}",
+				record.timestamp,
+				record.actor.toString(),
+				values[0] != 0,
+				values[1],
+				values[2]
+			);
+			break;
+		case TraceEvent::DeadBodySeen:
+			std::format_to(std::back_inserter(line), " {}: body {}", record.timestamp, record.actor.toString());
+			break;
+		case TraceEvent::MurderedBodySeen:
+			std::format_to(
+				std::back_inserter(line),
+				" {}: body {} crowd {} witness {} target {}",
+				record.timestamp,
+				record.actor.toString(),
+				values[0] != 0,
+				record.other.toString(),
+				values[1] != 0
+			);
+			break;
+		case TraceEvent::NoticedKill:
+			std::format_to(std::back_inserter(line), " {}: victim {} target {}", record.timestamp, record.actor.toString(), values[0] != 0);
+			break;
+	}
+	return line;
+}
@@ -0,0 +1,109 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "RecordRing.h"
+#include "RepoId.h"
+
+enum class TraceEvent : uint16_t
+{
+	BehaviourChanged,
+	ActorSick,
+	AccidentBodyFound,
+	DeadBodySeen,
+	MurderedBodySeen,
+	BodyFound,
+	NoticedKill,
+};
+
+// Something traced, as the raw values it's described by. What the values mean depends on the event (see
+// Trace::format). Records are a fixed size and hold nothing needing formatting or allocation, so tracing one is a
+// copy into a ring, and all the formatting happens later on the trace thread.
+struct TraceRecord
+{
+	// Steady clock ticks when recorded. Filled in by Trace::record.
+	int64_t time = 0;
+	// Game time of the event, for those traced from an event.
+	double timestamp = 0;
+	RepoId actor;
+	RepoId other;
+	TraceEvent event = TraceEvent::BehaviourChanged;
+	uint16_t actorIndex = 0;
+	std::array<int32_t, 3> values = {};
+
+	// One for each event, filling in the values it's formatted from.
+	static auto behaviourChanged(uint16_t actorIndex, const RepoId& actor, int32_t behaviour, int32_t tension) -> TraceRecord {
+		return TraceRecord(TraceEvent::BehaviourChanged, 0, actor, RepoId(), actorIndex, {behaviour, tension, 0});
+	}
+
+	static auto actorSick(double timestamp, const RepoId& actor, bool isTarget, int32_t actorType) -> TraceRecord {
+		return TraceRecord(TraceEvent::ActorSick, timestamp, actor, RepoId(), 0, {isTarget, actorType, 0});
+	}
+
+	// For AccidentBodyFound or BodyFound.
+	static auto bodyFound(TraceEvent event, double timestamp, const RepoId& body, bool isCrowd, int32_t deathContext, int32_t deathType) -> TraceRecord {
+		return TraceRecord(event, timestamp, body, RepoId(), 0, {isCrowd, deathContext, deathType});
+	}
+
+	static auto deadBodySeen(double timestamp, const RepoId& body) -> TraceRecord {
+		return TraceRecord(TraceEvent::DeadBodySeen, timestamp, body, RepoId(), 0, {});
+	}
+
+	static auto murderedBodySeen(double timestamp, const RepoId& body, const RepoId& witness, bool isCrowd, bool isWitnessTarget) -> TraceRecord {
+		return TraceRecord(TraceEvent::MurderedBodySeen, timestamp, body, witness, 0, {isCrowd, isWitnessTarget, 0});
+	}
+
+	static auto noticedKill(double timestamp, const RepoId& victim, bool isTarget) -> TraceRecord {
+		return TraceRecord(TraceEvent::NoticedKill, timestamp, victim, RepoId(), 0, {isTarget, 0, 0});
+	}
+
+	TraceRecord() = default;
+
+private:
+	TraceRecord(TraceEvent event, double timestamp, const RepoId& actor, const RepoId& other, uint16_t actorIndex, std::array<int32_t, 3> values) :
+		timestamp(timestamp), actor(actor), other(other), event(event), actorIndex(actorIndex), values(values)
+	{ }
+};
+
+static_assert(sizeof(TraceRecord) == 64);
+
+// Each thread tracing has its own ring, so recording never waits on another thread.
+using TraceRing = RecordRing<TraceRecord, 4096>;
+
+// Structured tracing for the hot paths: actor behaviour changes on the game thread and the event handlers, which
+// used to format debug logs as they went. While tracing is off, recording is a relaxed load and a branch. While it's
+// on, records go into a ring for the thread and a background thread formats them into the log in time order.
+namespace Trace
+{
+	struct Counters
+	{
+		uint64_t recorded = 0;
+		uint64_t dropped = 0;
+		uint64_t formatted = 0;
+	};
+
+	inline std::atomic<bool> enabled = false;
+
+	inline auto isEnabled() -> bool {
+		return enabled.load(std::memory_order_relaxed);
+	}
+
+	auto push(TraceRecord record) -> void;
+
+	inline auto record(const TraceRecord& record) -> void {
+		if (isEnabled()) push(record);
+	}
+
+	// Enables recording and starts the thread formatting records.
+	auto start() -> void;
+	// Disables recording, then formats what's left and joins the thread.
+	auto stop() -> void;
+	auto isRunning() -> bool;
+
+	auto getCounters() -> Counters;
+	auto getEventName(TraceEvent event) -> const char*;
+	// The log line for a record, with its time given relative to start.
+	auto format(const TraceRecord& record, int64_t start) -> std::string;
+}
@@ -0,0 +1,107 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include "ContractArena.h"
+#include "Enums.h"
+#include "Memory.h"
+#include "NPCIndex.h"
+
+// A sighting of a body or a kill. NPCs are interned in the contract's NPCIndex, so an event is a few words rather than
+// carrying two RepoIds. Either NPC may be NPCIndex::None: the witness of a noticed kill isn't always known, and the
+// body of a MurderedBodySeen isn't until the matching BodyFound arrives.
+struct WitnessEvent
+{
+	double timestamp = 0;
+	Events event = Events::MurderedBodySeen;
+	bool isWitnessTarget = false;
+	uint32_t witness = NPCIndex::None;
+	uint32_t body = NPCIndex::None;
+};
+
+// The contract's witness events in timestamp order, grouped into buckets of events sent at the same instant. The game
+// sends the events describing one sighting with the same timestamp, so correlating them only ever looks at the latest
+// bucket, which is found in O(1) rather than by scanning back from the end. Timestamps don't go backwards within a
+// contract, so other ranges of time are found by binary search.
+// Events older than the retention window (relative to the latest bucket) are dropped, and the space they held is
+// reused once they make up half of the store, which keeps its size bounded by the busiest stretch of that length.
+class WitnessEventStore
+{
+public:
+	static constexpr double Unlimited = std::numeric_limits<double>::infinity();
+
+	auto setRetention(double seconds) -> void {
+		this->retention = std::max(seconds, 0.0);
+	}
+
+	auto add(const WitnessEvent& ev) -> WitnessEvent& {
+		if (this->empty() || ev.timestamp != this->events.back().timestamp) {
+			this->expire(ev.timestamp);
+			this->latest = this->events.size();
+		}
+		++this->added;
+		return this->events.emplace_back(ev);
+	}
+
+	// Events sent at the given instant, provided it's the latest one; otherwise none.
+	auto getLatest(double timestamp) -> std::span<WitnessEvent> {
+		if (this->empty() || this->events.back().timestamp != timestamp) return {};
+		return std::span(this->events).subspan(this->latest);
+	}
+
+	auto getLatest(double timestamp) const -> std::span<const WitnessEvent> {
+		if (this->empty() || this->events.back().timestamp != timestamp) return {};
+		return std::span(this->events).subspan(this->latest);
+	}
+
+	// Retained events with timestamps in [from, to].
+	auto getRange(double from, double to) const -> std::span<const WitnessEvent> {
+		auto const retained = this->getEvents();
+		auto const begin = std::lower_bound(retained.begin(), retained.end(), from, [](const WitnessEvent& ev, double time) {
+			return ev.timestamp < time;
+		});
+		auto const end = std::upper_bound(begin, retained.end(), to, [](double time, const WitnessEvent& ev) {
+			return time < ev.timestamp;
+		});
+		return {begin, end};
+	}
+
+	// Every retained event, oldest first.
+	auto getEvents() const -> std::span<const WitnessEvent> {
+		return std::span(this->events).subspan(this->first);
+	}
+
+	auto size() const -> size_t {
+		return this->events.size() - this->first;
+	}
+
+	auto empty() const -> bool {
+		return this->events.size() == this->first;
+	}
+
+	// Events added this contract, including any since dropped.
+	auto getAdded() const -> size_t {
+		return this->added;
+	}
+
+private:
+	auto expire(double now) -> void {
+		auto const cutoff = now - this->retention;
+		while (this->first < this->events.size() && this->events[this->first].timestamp < cutoff) ++this->first;
+
+		if (this->first >= 32 && this->first * 2 >= this->events.size()) {
+			this->events.erase(this->events.begin(), this->events.begin() + static_cast<ptrdiff_t>(this->first));
+			this->first = 0;
+		}
+	}
+
+private:
+	ContractVector<WitnessEvent, MemorySubsystem::WitnessEvents> events;
+	// Index of the oldest retained event, and of the first event in the latest bucket.
+	size_t first = 0;
+	size_t latest = 0;
+	size_t added = 0;
+	double retention = Unlimited;
+};
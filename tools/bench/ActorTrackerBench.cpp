@@ -0,0 +1,300 @@
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "ActorTracker.h"
+#include "Bench.h"
+#include "Enums.h"
+#include "RepoId.h"
+
+namespace
+{
+	constexpr size_t actorCount = 1000;
+
+	// Stand-ins for the game's actor and behaviour state structures, reached through the same pointers.
+	struct SyntheticBehaviour
+	{
+		ECompiledBehaviorType eBehaviorType = ECompiledBehaviorType::BT_Act;
+	};
+
+	struct SyntheticBehaviourState
+	{
+		SyntheticBehaviour* m_pCurrentBehavior = nullptr;
+		char padding[0xD8] = {};
+	};
+
+	struct SyntheticInterface
+	{
+		int32_t m_nActorRuntimeId = -1;
+		bool m_bContractTarget = false;
+	};
+
+	struct SyntheticActor
+	{
+		SyntheticInterface* m_pInterfaceRef = nullptr;
+		bool spatial = true;
+		std::string repoId;
+	};
+
+	// 1000 actors, most of them acting, with a few changing behaviour each frame.
+	class SyntheticActors final : public ActorSource
+	{
+	public:
+		explicit SyntheticActors(double changeRate) : interfaces(actorCount), states(actorCount), behaviours(actorCount), actors(actorCount) {
+			auto random = std::mt19937(8642);
+			for (size_t i = 0; i < actorCount; ++i) {
+				this->interfaces[i].m_nActorRuntimeId = i % 50 == 49 ? -1 : static_cast<int32_t>(i);
+				this->interfaces[i].m_bContractTarget = i % 200 == 0;
+				this->states[i].m_pCurrentBehavior = i % 100 == 99 ? nullptr : &this->behaviours[i];
+				this->actors[i] = {&this->interfaces[i], i % 40 != 39, Bench::makeGuid(random)};
+			}
+
+			auto const changes = static_cast<size_t>(actorCount * changeRate);
+			for (size_t i = 0; i < changes; ++i) this->changing.push_back(random() % actorCount);
+		}
+
+		// Moves the changing actors between acting and a behaviour with tension.
+		auto step() -> void {
+			for (auto const i : this->changing) {
+				auto& behaviour = this->behaviours[i].eBehaviorType;
+				behaviour = behaviour == ECompiledBehaviorType::BT_Act ? ECompiledBehaviorType::BT_AgitatedGuard : ECompiledBehaviorType::BT_Act;
+			}
+		}
+
+		auto getActorCount() -> size_t override {
+			return actorCount;
+		}
+
+		auto describe(size_t index) -> Description override {
+			auto const& actor = this->actors[index];
+			return {RepoId(actor.repoId), actor.m_pInterfaceRef->m_bContractTarget};
+		}
+
+		auto read(size_t index) -> State override {
+			auto const& actor = this->actors[index];
+			auto state = State{.runtimeId = actor.spatial ? actor.m_pInterfaceRef->m_nActorRuntimeId : -1};
+			if (state.runtimeId < 0) return state;
+
+			auto const& behaviour = this->states[state.runtimeId];
+			if (behaviour.m_pCurrentBehavior) state.behaviour = behaviour.m_pCurrentBehavior->eBehaviorType;
+			return state;
+		}
+
+		std::vector<SyntheticInterface> interfaces;
+		std::vector<SyntheticBehaviourState> states;
+		std::vector<SyntheticBehaviour> behaviours;
+		std::vector<SyntheticActor> actors;
+		std::vector<size_t> changing;
+	};
+
+	// The per-frame scan as it was before the ActorTracker: a struct per actor, read and compared one at a time.
+	struct LegacyActorScan
+	{
+		struct ActorData
+		{
+			const SyntheticActor* ref = nullptr;
+			bool isTarget = false;
+			int highestTensionLevel = 0;
+			ECompiledBehaviorType lastFrameBehaviour = ECompiledBehaviorType::BT_Invalid;
+			RepoId repoId;
+		};
+
+		std::array<ActorData, actorCount> actorData;
+		int tension = 0;
+		int targets = 0;
+
+		auto update(SyntheticActors& source) -> void {
+			for (size_t i = 0; i < actorCount; ++i) {
+				auto const& actor = source.actors[i];
+				auto& actorData = this->actorData[i];
+
+				if (!actorData.ref) {
+					actorData.ref = &actor;
+					actorData.repoId = RepoId(actor.repoId);
+					actorData.isTarget = actor.m_pInterfaceRef->m_bContractTarget;
+					if (actorData.isTarget) ++this->targets;
+				}
+
+				if (!actor.spatial || actor.m_pInterfaceRef->m_nActorRuntimeId < 0) continue;
+
+				auto const& behaviour = source.states[actor.m_pInterfaceRef->m_nActorRuntimeId];
+				if (!behaviour.m_pCurrentBehavior) continue;
+				auto const behaviourType = behaviour.m_pCurrentBehavior->eBehaviorType;
+				auto const lastBehaviourType = actorData.lastFrameBehaviour;
+				actorData.lastFrameBehaviour = behaviourType;
+				if (lastBehaviourType == behaviourType) continue;
+
+				auto tension = getBehaviourTension(behaviourType);
+				if (!tension) continue;
+
+				if (tension > actorData.highestTensionLevel) {
+					if (actorData.highestTensionLevel) tension -= actorData.highestTensionLevel;
+					actorData.highestTensionLevel += tension;
+					this->tension += tension;
+				}
+			}
+		}
+	};
+
+	// Actors which hold each behaviour for a random number of frames, at least minDwell, now and then a tense one. Each
+	// time one leaves a tense behaviour the tracker never saw it in, it's counted as a missed transition.
+	class DwellingActors final : public ActorSource
+	{
+	public:
+		DwellingActors(size_t count, int minDwell, uint32_t seed) : random(seed), minDwell(minDwell), behaviours(count), dwell(count), unseen(count) {
+			for (size_t i = 0; i < count; ++i) this->dwell[i] = this->pickDwell();
+		}
+
+		auto step(const ActorTracker& tracker) -> void {
+			for (size_t i = 0; i < this->behaviours.size(); ++i) {
+				if (tracker.getLastBehaviour(i) == this->behaviours[i]) this->unseen[i] = false;
+				if (--this->dwell[i] > 0) continue;
+
+				this->missed += this->unseen[i];
+				this->behaviours[i] = this->pickBehaviour();
+				this->dwell[i] = this->pickDwell();
+				this->unseen[i] = getBehaviourTension(this->behaviours[i]) > 0;
+				this->transitions += this->unseen[i];
+			}
+		}
+
+		auto getActorCount() -> size_t override {
+			return this->behaviours.size();
+		}
+
+		auto describe(size_t index) -> Description override {
+			return {RepoId(), index % 100 == 0};
+		}
+
+		auto read(size_t index) -> State override {
+			return {static_cast<int32_t>(index), this->behaviours[index]};
+		}
+
+		size_t transitions = 0;
+		size_t missed = 0;
+
+	private:
+		auto pickDwell() -> int {
+			return this->minDwell + static_cast<int>(this->random() % (this->minDwell * 4 + 1));
+		}
+
+		auto pickBehaviour() -> ECompiledBehaviorType {
+			constexpr ECompiledBehaviorType tense[] = {
+				ECompiledBehaviorType::BT_AgitatedBystander,
+				ECompiledBehaviorType::BT_Scared,
+				ECompiledBehaviorType::BT_AgitatedGuard,
+				ECompiledBehaviorType::BT_SituationAct,
+				ECompiledBehaviorType::BT_CloseCombat,
+				ECompiledBehaviorType::BT_StandOffArrest,
+				ECompiledBehaviorType::BT_CoverFightSeasonTwo,
+			};
+			if (this->random() % 10) return ECompiledBehaviorType::BT_Act;
+			return tense[this->random() % std::size(tense)];
+		}
+
+	private:
+		std::mt19937 random;
+		int minDwell;
+		std::vector<ECompiledBehaviorType> behaviours;
+		std::vector<int> dwell;
+		std::vector<bool> unseen;
+	};
+}
+
+// Per-frame cost of scanning 1000 actors for behaviour changes, through a synthetic source reached through the same
+// pointers as the game's. "array of structs" is the scan as it was; "columns" is the ActorTracker. The two differ by
+// less than this machine's noise between runs, so they take turns in short rounds and the best round of each counts.
+auto Bench::actorTracker() -> void {
+	constexpr double rates[] = {0, 0.01, 0.1};
+	constexpr int rounds = 2000;
+	constexpr int framesPerRound = 100;
+
+	auto const timeRound = [](auto&& func) {
+		auto const start = Clock::now();
+		for (auto frame = 0; frame < framesPerRound; ++frame) func();
+		return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / framesPerRound;
+	};
+
+	for (auto const rate : rates) {
+		auto legacySource = SyntheticActors(rate);
+		auto legacy = std::make_unique<LegacyActorScan>();
+		auto source = SyntheticActors(rate);
+		auto tracker = std::make_unique<ActorTracker>();
+		auto tension = 0;
+		auto legacyBest = std::numeric_limits<double>::max();
+		auto best = std::numeric_limits<double>::max();
+
+		for (auto round = 0; round < rounds; ++round) {
+			legacyBest = std::min(legacyBest, timeRound([&] {
+				legacySource.step();
+				legacy->update(legacySource);
+			}));
+			best = std::min(best, timeRound([&] {
+				source.step();
+				tension += tracker->update(source).tension;
+			}));
+		}
+		doNotOptimize(legacy->tension);
+		doNotOptimize(tension);
+
+		auto const changes = std::to_string(static_cast<int>(rate * actorCount)) + " changes/frame";
+		std::printf("  %-48s %12.1f ns/op\n", ("array of structs, " + changes).c_str(), legacyBest);
+		std::printf("  %-48s %12.1f ns/op (%+.1f%%)\n", ("columns, " + changes).c_str(), best, (best / legacyBest - 1) * 100);
+	}
+
+	std::printf("  %-48s %12.1f KB\n", "columns, size", sizeof(ActorTracker) / 1024.0);
+	std::printf("  %-48s %12.1f KB\n", "array of structs, size", sizeof(LegacyActorScan::actorData) / 1024.0);
+}
+
+// Scans synthetic populations under per-frame budgets, reporting the cost per frame, the most frames between scans of
+// an actor, and how many actors went into a tense behaviour and out again without the tracker seeing it. A budget of
+// 0 scans every actor every frame and is the reference the tension total is checked against. With behaviours held for
+// at least minDwell frames, none should be missed while the latency is no more than that, and any that are get flagged.
+auto Bench::actorScan() -> void {
+	constexpr size_t populations[] = {300, 1000};
+	constexpr double budgets[] = {0, 10, 4, 2, 1};
+	constexpr int dwells[] = {12, 2};
+	constexpr int frames = 5000;
+
+	for (auto const minDwell : dwells) {
+		for (auto const population : populations) {
+			auto reference = 0;
+
+			for (auto const budget : budgets) {
+				auto source = DwellingActors(population, minDwell, 97531);
+				auto tracker = std::make_unique<ActorTracker>();
+				tracker->setBudget(budget);
+
+				auto tension = 0;
+				auto elapsed = Clock::duration();
+				for (auto frame = 0; frame < frames; ++frame) {
+					auto const start = Clock::now();
+					tension += tracker->update(source).tension;
+					elapsed += Clock::now() - start;
+					source.step(*tracker);
+				}
+				auto const ns = std::chrono::duration<double, std::nano>(elapsed).count() / frames;
+				if (!budget) reference = tension;
+
+				std::printf(
+					"  %4zu actors, dwell %2d, budget %4.1f us: %8.1f ns/frame, latency %2u, missed %3zu/%zu, tension %d/%d%s\n",
+					population,
+					minDwell,
+					budget,
+					ns,
+					static_cast<unsigned>(tracker->getScanLatency()),
+					source.missed,
+					source.transitions,
+					tension,
+					reference,
+					source.missed && tracker->getScanLatency() <= static_cast<uint32_t>(minDwell) ? " (MISSED WITHIN LATENCY)" : ""
+				);
+			}
+		}
+	}
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <string_view>
+
+namespace Bench
+{
+	using Clock = std::chrono::steady_clock;
+
+	inline volatile const void* sink = nullptr;
+
+	// Keeps the optimizer from discarding a benchmarked result.
+	template<typename T>
+	inline auto doNotOptimize(const T& value) -> void {
+		sink = &value;
+		std::atomic_signal_fence(std::memory_order_seq_cst);
+	}
+
+	// Random GUID in the lowercase form the game sends repository IDs in.
+	inline auto makeGuid(std::mt19937& random) -> std::string {
+		char guid[37];
+		std::snprintf(guid, sizeof(guid), "%08x-%04x-%04x-%04x-%08x%04x", static_cast<unsigned>(random()), static_cast<unsigned>(random() & 0xFFFF),
+			static_cast<unsigned>(random() & 0xFFFF), static_cast<unsigned>(random() & 0xFFFF), static_cast<unsigned>(random()), static_cast<unsigned>(random() & 0xFFFF));
+		return guid;
+	}
+
+	// Runs func in batches of doubling size until a batch takes long enough to time reliably, then prints and
+	// returns the time per call in nanoseconds.
+	template<typename TFunc>
+	auto run(std::string_view name, TFunc&& func) -> double {
+		using namespace std::chrono_literals;
+
+		for (int i = 0; i < 100; ++i) func();
+
+		for (uint64_t iterations = 64;; iterations *= 2) {
+			auto const start = Clock::now();
+			for (uint64_t i = 0; i < iterations; ++i) func();
+			auto const elapsed = Clock::now() - start;
+
+			if (elapsed >= 250ms || iterations >= (1ull << 32)) {
+				auto const ns = std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(iterations);
+				std::printf("  %-48.*s %12.1f ns/op\n", static_cast<int>(name.size()), name.data(), ns);
+				return ns;
+			}
+		}
+	}
+
+	auto actorScan() -> void;
+	auto actorTracker() -> void;
+	auto cumulativeLists() -> void;
+	auto eventDecode() -> void;
+	auto eventNames() -> void;
+	auto npcSets() -> void;
+	auto profiler() -> void;
+	auto repoIds() -> void;
+	auto targets() -> void;
+	auto trace() -> void;
+}
@@ -0,0 +1,87 @@
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Bench.h"
+#include "EventSystem.h"
+#include "NPCIndex.h"
+
+// Cost of a Spotted event as its list grows over a mission. "full list" is how the events were handled before they
+// were diffed: the whole array decoded and every ID looked up again. "appended" is a list one longer than the last,
+// which is how they normally arrive, and "unchanged" is the same list again.
+auto Bench::cumulativeLists() -> void {
+	constexpr size_t sizes[] = {25, 50, 100, 200, 400};
+	constexpr size_t maxSize = 400;
+	constexpr int samples = 200;
+
+	auto random = std::mt19937(1357);
+	auto ids = std::vector<std::string>();
+	for (size_t i = 0; i < maxSize; ++i) ids.push_back(makeGuid(random));
+
+	// The event with the first count IDs.
+	auto const makeEvent = [&](size_t count) {
+		auto data = std::string(R"({"Timestamp":87.402710,"Name":"Spotted","ContractSessionId":"2519902561212542207-4d6e5e7f-0a1b-4c2d-8e3f-9a0b1c2d3e4f","ContractId":"00000000-0000-0000-0000-000000000200","Value":[)");
+		for (size_t i = 0; i < count; ++i) {
+			if (i) data += ',';
+			data += '"' + ids[i] + '"';
+		}
+		data += R"(],"UserId":"fe0a9f17-2c4b-4d4e-8e72-0d3a1b4c5d6e","SessionId":"1e0b4c9d5f8a4b3e8c2d1f0a9b8c7d6e-2519902561","Origin":"gameclient","Id":"f3a0c2d1-6b5e-4f7a-9c8d-0e1f2a3b4c5d"})";
+		return data;
+	};
+
+	auto events = std::vector<std::string>();
+	for (size_t i = 0; i <= maxSize; ++i) events.push_back(makeEvent(i));
+
+	auto arena = ContractArena();
+	auto const scope = ContractArena::Scope(arena);
+	auto npcs = NPCIndex();
+	auto spottedBy = NPCSet();
+	for (auto const& id : ids) spottedBy.insert(npcs.add(RepoId(id)));
+
+	size_t handled = 0;
+	auto const spotted = [&](const RepoId& id) {
+		handled += spottedBy.contains(npcs.add(id));
+	};
+
+	auto system = EventSystem();
+	system.listen<Events::Spotted>([&spotted](const ServerEvent<Events::Spotted>& ev) {
+		for (auto const& id : ev.Value.added) spotted(id);
+	});
+
+	for (auto const size : sizes) {
+		auto const data = std::string_view(events[size]);
+
+		auto const label = [size](const char* kind) {
+			return std::string(kind) + ", " + std::to_string(size) + " IDs";
+		};
+
+		Bench::run(label("full list"), [&] {
+			ServerEventHeader header;
+			RepoIdArrayEventValue value;
+			EventDecoder::decode(data, header, getEventFieldObject(value), getEventFieldTable<RepoIdArrayEventValue>());
+			for (auto const& id : value.value) spotted(id);
+		});
+
+		// Each sample replays the list growing up to size - 1 untimed, then times the event adding the last ID.
+		auto appended = 0.0;
+		for (auto sample = 0; sample < samples; ++sample) {
+			system.resetLists();
+			for (size_t i = 1; i < size; ++i) system.handle(Events::Spotted, std::string_view(events[i]));
+
+			auto const start = Clock::now();
+			system.handle(Events::Spotted, data);
+			appended += std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+		}
+		appended /= samples;
+
+		std::printf("  %-48s %12.1f ns/op\n", label("appended").c_str(), appended);
+
+		Bench::run(label("unchanged"), [&] {
+			system.handle(Events::Spotted, data);
+		});
+	}
+
+	doNotOptimize(handled);
+}
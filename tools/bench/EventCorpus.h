@@ -0,0 +1,12 @@
+#pragma once
+#include <string_view>
+
+// Representative event payloads as sent by the game, for benchmarks.
+namespace EventCorpus
+{
+	inline constexpr std::string_view Kill = R"({"Timestamp":312.845581,"Name":"Kill","ContractSessionId":"2519902561212542207-4d6e5e7f-0a1b-4c2d-8e3f-9a0b1c2d3e4f","ContractId":"00000000-0000-0000-0000-000000000200","Value":{"RepositoryId":"c0ab162c-1502-40d5-8ed9-6b4a9fb5df8b","ActorId":2655118168.000000,"ActorName":"Sierra Knox","ActorType":0.000000,"KillType":7.000000,"KillContext":3.000000,"KillClass":"melee","Accident":false,"WeaponSilenced":false,"Explosive":false,"ExplosionType":0.000000,"Projectile":false,"Sniper":false,"IsHeadshot":false,"IsTarget":true,"ThroughWall":false,"BodyPartId":-1.000000,"TotalDamage":100000.000000,"IsMoving":false,"RoomId":1121.000000,"ActorPosition":"-111.541, -54.3261, 14.1237","HeroPosition":"-111.079, -53.7472, 14.1198","DamageEvents":["InCloseCombat","Strangle"],"PlayerId":4294967295.000000,"OutfitRepositoryId":"fd56a934-f402-4b02-bdcc-ff96a2a9d6b1","OutfitIsHitmanSuit":false,"KillMethodBroad":"fiberwire","KillMethodStrict":"fiberwire","EvergreenRarity":-1.000000,"KillItemRepositoryId":"1a11a060-358c-4054-98ec-d3491af1d7c6","KillItemInstanceId":"5a3c5d54-62bc-4e1c-bc0e-6ba6b7e0a8a4","KillItemCategory":"fiberwire","History":[{"Explosive":false,"Headshot":false,"Accident":false,"WeaponSilenced":false,"Projectile":false,"Sniper":false,"ThroughWall":false,"InstanceId":"5a3c5d54-62bc-4e1c-bc0e-6ba6b7e0a8a4","RepositoryId":"1a11a060-358c-4054-98ec-d3491af1d7c6","BodyPartId":-1.000000,"TotalDamage":100000.000000}]},"UserId":"fe0a9f17-2c4b-4d4e-8e72-0d3a1b4c5d6e","SessionId":"1e0b4c9d5f8a4b3e8c2d1f0a9b8c7d6e-2519902561","Origin":"gameclient","Id":"6ed2b4cf-4a15-4a5f-8b4e-2b7c3f0f6f2e"})";
+
+	inline constexpr std::string_view Pacify = R"({"Timestamp":128.172302,"Name":"Pacify","ContractSessionId":"2519902561212542207-4d6e5e7f-0a1b-4c2d-8e3f-9a0b1c2d3e4f","ContractId":"00000000-0000-0000-0000-000000000200","Value":{"RepositoryId":"0b6a5b4e-2a07-4a4f-9b1a-9c7f5c9f2c43","ActorId":1904526338.000000,"ActorName":"Dario Freeman","ActorType":1.000000,"KillType":4.000000,"KillContext":1.000000,"KillClass":"unknown","Accident":false,"WeaponSilenced":false,"Explosive":false,"ExplosionType":0.000000,"Projectile":false,"Sniper":false,"IsHeadshot":false,"IsTarget":false,"ThroughWall":false,"BodyPartId":-1.000000,"TotalDamage":0.000000,"IsMoving":false,"RoomId":1083.000000,"ActorPosition":"-98.2213, -41.0095, 10.1158","HeroPosition":"-97.7001, -40.6583, 10.1158","DamageEvents":[],"PlayerId":4294967295.000000,"OutfitRepositoryId":"fd56a934-f402-4b02-bdcc-ff96a2a9d6b1","OutfitIsHitmanSuit":false,"KillMethodBroad":"unarmed","KillMethodStrict":"","EvergreenRarity":-1.000000,"History":[]},"UserId":"fe0a9f17-2c4b-4d4e-8e72-0d3a1b4c5d6e","SessionId":"1e0b4c9d5f8a4b3e8c2d1f0a9b8c7d6e-2519902561","Origin":"gameclient","Id":"0e7d64f1-b8a5-4ec4-9b6b-2f0b7a3a0d19"})";
+
+	inline constexpr std::string_view Spotted = R"({"Timestamp":87.402710,"Name":"Spotted","ContractSessionId":"2519902561212542207-4d6e5e7f-0a1b-4c2d-8e3f-9a0b1c2d3e4f","ContractId":"00000000-0000-0000-0000-000000000200","Value":["0b6a5b4e-2a07-4a4f-9b1a-9c7f5c9f2c43","3f1b7f14-9c7e-4a55-9d49-0e1fd8a1c7b2","a7c2b6c4-7f83-4d5e-8f0a-1c2d3e4f5a6b"],"UserId":"fe0a9f17-2c4b-4d4e-8e72-0d3a1b4c5d6e","SessionId":"1e0b4c9d5f8a4b3e8c2d1f0a9b8c7d6e-2519902561","Origin":"gameclient","Id":"f3a0c2d1-6b5e-4f7a-9c8d-0e1f2a3b4c5d"})";
+}
@@ -0,0 +1,46 @@
+#include <string>
+#include "Bench.h"
+#include "EventCorpus.h"
+#include "EventSystem.h"
+#include "json.hpp"
+
+// Compares parsing an event into a DOM alone (nlohmann::json::parse, what was paid before any value was built from it)
+// against the streaming path (EventDecoder, straight into the typed value and its handlers) for the events that
+// dominate a typical session.
+auto Bench::eventDecode() -> void {
+	EventSystem events;
+	size_t handled = 0;
+
+	events.listen<Events::Kill>([&](const ServerEvent<Events::Kill>& ev) {
+		handled += ev.Value.History.size();
+		doNotOptimize(ev.Value.RepositoryId);
+	});
+	events.listen<Events::Pacify>([&](const ServerEvent<Events::Pacify>& ev) {
+		handled += ev.Value.IsTarget;
+		doNotOptimize(ev.Value.RepositoryId);
+	});
+	events.listen<Events::Spotted>([&](const ServerEvent<Events::Spotted>& ev) {
+		handled += ev.Value.added.size();
+		doNotOptimize(ev.Value.added);
+	});
+
+	// Spotted repeats its list, which would otherwise be skipped after the first time (see cumulative-lists).
+	auto const benchEvent = [&](std::string_view label, std::string_view data) {
+		auto const dom = Bench::run(std::string(label) + " dom", [&] {
+			auto const json = nlohmann::json::parse(data.data(), data.data() + data.size());
+			doNotOptimize(json);
+		});
+		auto const sax = Bench::run(std::string(label) + " sax", [&] {
+			events.resetLists();
+			auto const header = EventDecoder::peek(data);
+			events.handle(header.Name, data);
+		});
+		std::printf("  %-48s %12.2fx\n", (std::string(label) + " speedup").c_str(), dom / sax);
+	};
+
+	benchEvent("Kill", EventCorpus::Kill);
+	benchEvent("Pacify", EventCorpus::Pacify);
+	benchEvent("Spotted", EventCorpus::Spotted);
+
+	doNotOptimize(handled);
+}
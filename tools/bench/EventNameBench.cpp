@@ -0,0 +1,45 @@
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "Bench.h"
+#include "EventNames.h"
+
+// Per-event cost of classifying the name of an incoming event: the previous blacklist set + listener map probes
+// against the perfect hash table, over every known name plus a few the game may send that aren't in either.
+auto Bench::eventNames() -> void {
+	std::vector<std::string> names;
+	std::unordered_set<std::string> blacklist;
+	std::unordered_map<std::string, Events> listeners;
+
+	for (auto const& entry : eventNameTable.entries()) {
+		if (entry.name.empty()) continue;
+		names.emplace_back(entry.name);
+		if (entry.info.kind == EventNameKind::Blacklisted) blacklist.emplace(entry.name);
+		else listeners.emplace(entry.name, entry.info.event);
+	}
+	names.emplace_back("Evergreen_Unlisted_Event");
+	names.emplace_back("ChallengeProgress");
+	names.emplace_back("Kil");
+
+	std::printf("  %zu names (%zu slots, %zu buckets)\n", names.size(), decltype(eventNameTable)::SlotCount, decltype(eventNameTable)::BucketCount);
+
+	auto const perName = static_cast<double>(names.size());
+	auto const maps = Bench::run("unordered_set + unordered_map (all names)", [&] {
+		size_t found = 0;
+		for (auto const& name : names) {
+			if (blacklist.contains(name)) continue;
+			found += listeners.find(name) != listeners.end();
+		}
+		doNotOptimize(found);
+	});
+	auto const table = Bench::run("perfect hash (all names)", [&] {
+		size_t found = 0;
+		for (auto const& name : names)
+			found += lookupEventName(name).kind == EventNameKind::Event;
+		doNotOptimize(found);
+	});
+
+	std::printf("  %-48s %12.1f ns/name\n", "unordered_set + unordered_map", maps / perName);
+	std::printf("  %-48s %12.1f ns/name\n", "perfect hash", table / perName);
+}
@@ -1,9 +1,13 @@
 #pragma once
 #include <algorithm>
+#include <cctype>
+#include <iterator>
 #include <string>
 #include <string_view>
 
-struct InsensitiveCompare
+// The case-insensitive string functors the mod keyed its repository ID sets with before RepoId, as util.h had them,
+// for the benches to compare against.
+struct LegacyCompare
 {
 	auto operator()(std::string_view a, std::string_view b) const -> bool {
 		return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](unsigned char a, unsigned char b) {
@@ -12,7 +16,7 @@ struct InsensitiveCompare
 	}
 };
 
-struct InsensitiveCompareLexicographic
+struct LegacyCompareLexicographic
 {
 	auto operator()(std::string_view a, std::string_view b) const -> bool {
 		return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(), [](unsigned char a, unsigned char b) {
@@ -21,9 +25,8 @@ struct InsensitiveCompareLexicographic
 	}
 };
 
-struct StringHashLowercase
+struct LegacyHash
 {
-public:
 	auto operator()(const std::string& str) const {
 		std::string lower;
 		std::transform(str.begin(), str.end(), std::back_inserter(lower), [](unsigned char c) -> unsigned char { return std::tolower(c); });
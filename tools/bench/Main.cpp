@@ -0,0 +1,47 @@
+#include <cstdio>
+#include <string_view>
+#include "Bench.h"
+
+struct Suite
+{
+	std::string_view name;
+	auto (*run)() -> void;
+};
+
+static constexpr Suite suites[] = {
+	{"actor-scan", Bench::actorScan},
+	{"actor-tracker", Bench::actorTracker},
+	{"cumulative-lists", Bench::cumulativeLists},
+	{"event-decode", Bench::eventDecode},
+	{"event-names", Bench::eventNames},
+	{"npc-sets", Bench::npcSets},
+	{"profiler", Bench::profiler},
+	{"repo-ids", Bench::repoIds},
+	{"targets", Bench::targets},
+	{"trace", Bench::trace},
+};
+
+// Usage: stealthometer-bench [suite...]
+// Runs every suite when none are named.
+auto main(int argc, char** argv) -> int {
+	auto ran = 0;
+
+	for (auto const& suite : suites) {
+		auto selected = argc < 2;
+		for (auto i = 1; i < argc && !selected; ++i)
+			selected = suite.name == argv[i];
+		if (!selected) continue;
+
+		std::printf("%.*s\n", static_cast<int>(suite.name.size()), suite.name.data());
+		suite.run();
+		++ran;
+	}
+
+	if (!ran) {
+		std::fprintf(stderr, "No matching suites. Available:\n");
+		for (auto const& suite : suites)
+			std::fprintf(stderr, "  %.*s\n", static_cast<int>(suite.name.size()), suite.name.data());
+		return 1;
+	}
+	return 0;
+}
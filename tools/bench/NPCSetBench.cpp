@@ -0,0 +1,211 @@
+#include <cstdio>
+#include <random>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "Bench.h"
+#include "ContractArena.h"
+#include "NPCIndex.h"
+#include "RepoId.h"
+#include "SilentAssassin.h"
+
+namespace
+{
+	// The per-contract NPC sets as they were before NPCIndex: ordered sets of IDs, plus the map of observers the
+	// Silent Assassin counts were kept incrementally in.
+	struct LegacyNPCSets
+	{
+		struct Observer
+		{
+			bool witness = false;
+			bool spotter = false;
+			bool killed = false;
+			bool target = false;
+		};
+
+		std::unordered_set<RepoId> targetNPCs;
+		std::set<RepoId> spottedBy;
+		std::set<RepoId> targetsSpottedBy;
+		std::set<RepoId> witnesses;
+		std::set<RepoId> killedTargets;
+		std::set<RepoId> killedNonTargets;
+		std::unordered_map<RepoId, Observer> observers;
+		int nonTargetWitnesses = 0;
+		int nonTargetSpotters = 0;
+
+		template<typename TFunc>
+		auto update(const RepoId& id, TFunc func) -> void {
+			auto& observer = this->observers[id];
+			this->count(observer, -1);
+			func(observer);
+			this->count(observer, 1);
+		}
+
+		auto count(const Observer& observer, int delta) -> void {
+			if (observer.killed || observer.target) return;
+			if (observer.witness) this->nonTargetWitnesses += delta;
+			if (observer.spotter) this->nonTargetSpotters += delta;
+		}
+
+		auto spotted(const RepoId& id) -> void {
+			auto const isTarget = this->targetNPCs.contains(id);
+			if (this->spottedBy.contains(id)) return;
+			this->spottedBy.insert(id);
+			this->update(id, [isTarget](Observer& observer) { observer.spotter = true; observer.target = isTarget; });
+			if (isTarget && !this->killedTargets.contains(id)) this->targetsSpottedBy.insert(id);
+		}
+
+		auto witnessed(const RepoId& id) -> void {
+			if (this->killedTargets.contains(id) || this->killedNonTargets.contains(id)) return;
+			if (this->witnesses.insert(id).second)
+				this->update(id, [this, &id](Observer& observer) { observer.witness = true; observer.target = this->targetNPCs.contains(id); });
+		}
+
+		auto killed(const RepoId& id) -> void {
+			auto& kills = this->targetNPCs.contains(id) ? this->killedTargets : this->killedNonTargets;
+			if (kills.insert(id).second) this->update(id, [](Observer& observer) { observer.killed = true; });
+			if (this->witnesses.erase(id)) this->update(id, [](Observer& observer) { observer.witness = false; });
+		}
+
+		auto isSpottedIncremental() const -> bool {
+			return this->nonTargetWitnesses > 0 || this->nonTargetSpotters > 0;
+		}
+
+		// As the SA status was evaluated before the counts were kept: probing each witness and spotter.
+		auto isSpottedFiltered() const -> bool {
+			auto const living = [this](const RepoId& id) {
+				return !this->killedTargets.contains(id) && !this->killedNonTargets.contains(id) && !this->targetNPCs.contains(id);
+			};
+			for (auto const& id : this->witnesses) if (living(id)) return true;
+			for (auto const& id : this->spottedBy) if (living(id)) return true;
+			return false;
+		}
+	};
+
+	// The same handlers, as StatTracker now has them.
+	struct NPCSets
+	{
+		NPCIndex npcs;
+		NPCSet targetNPCs;
+		NPCSet spottedBy;
+		NPCSet targetsSpottedBy;
+		NPCSet witnesses;
+		NPCSet killedTargets;
+		NPCSet killedNonTargets;
+		SilentAssassinTracker silentAssassin;
+
+		auto target(const RepoId& id) -> void {
+			auto const npc = this->npcs.add(id);
+			this->targetNPCs.insert(npc);
+			this->silentAssassin.exclude(npc, this->witnesses.contains(npc), this->spottedBy.contains(npc));
+		}
+
+		auto spotted(const RepoId& id) -> void {
+			auto const npc = this->npcs.add(id);
+			if (!this->spottedBy.insert(npc)) return;
+			this->silentAssassin.addSpotter(npc);
+			if (this->targetNPCs.contains(npc) && !this->killedTargets.contains(npc)) this->targetsSpottedBy.insert(npc);
+		}
+
+		auto witnessed(const RepoId& id) -> void {
+			auto const npc = this->npcs.add(id);
+			if (this->killedTargets.contains(npc) || this->killedNonTargets.contains(npc)) return;
+			if (this->witnesses.insert(npc)) this->silentAssassin.addWitness(npc);
+		}
+
+		auto killed(const RepoId& id) -> void {
+			auto const npc = this->npcs.add(id);
+			if ((this->targetNPCs.contains(npc) ? this->killedTargets : this->killedNonTargets).insert(npc))
+				this->silentAssassin.exclude(npc, this->witnesses.contains(npc), this->spottedBy.contains(npc));
+			if (this->witnesses.erase(npc)) this->silentAssassin.removeWitness(npc);
+		}
+
+		auto isSpotted() const -> bool {
+			return this->silentAssassin.getNonTargetWitnesses() > 0 || this->silentAssassin.getNonTargetSpotters() > 0;
+		}
+
+		// The same question answered from the sets, a word of 64 NPCs at a time.
+		auto isSpottedFromSets() const -> bool {
+			return NPCSet::anyExcept(this->witnesses, this->killedTargets, this->killedNonTargets, this->targetNPCs)
+				|| NPCSet::anyExcept(this->spottedBy, this->killedTargets, this->killedNonTargets, this->targetNPCs);
+		}
+	};
+}
+
+// Spotted and Witnesses handling and the "spotted" part of the Silent Assassin evaluation with 600 NPCs involved in a
+// contract. Every witness and spotter is dead or a target, so SA holds and each evaluation has to look at all of them.
+auto Bench::npcSets() -> void {
+	constexpr size_t npcCount = 600;
+	constexpr size_t idsPerEvent = 8;
+
+	auto arena = ContractArena();
+	auto const scope = ContractArena::Scope(arena);
+	auto random = std::mt19937(2468);
+
+	auto ids = std::vector<RepoId>();
+	for (size_t i = 0; i < npcCount; ++i) ids.emplace_back(makeGuid(random));
+
+	auto legacy = LegacyNPCSets();
+	auto sets = NPCSets();
+
+	for (size_t i = 0; i < npcCount; i += 50) {
+		legacy.targetNPCs.insert(ids[i]);
+		sets.target(ids[i]);
+	}
+	for (size_t i = 0; i < npcCount; ++i) {
+		if (i % 2) {
+			legacy.spotted(ids[i]);
+			sets.spotted(ids[i]);
+		}
+		else {
+			legacy.witnessed(ids[i]);
+			sets.witnessed(ids[i]);
+		}
+		legacy.killed(ids[i]);
+		sets.killed(ids[i]);
+	}
+
+	// Events name a handful of NPCs which have mostly been seen before.
+	auto events = std::vector<std::vector<RepoId>>(256);
+	for (auto& event : events) {
+		for (size_t i = 0; i < idsPerEvent; ++i) event.push_back(ids[random() % npcCount]);
+	}
+
+	if (legacy.isSpottedIncremental() || legacy.isSpottedFiltered() || sets.isSpotted() || sets.isSpottedFromSets())
+		std::printf("  unexpected: SA is already failed\n");
+
+	std::printf("  %zu NPCs, %zu IDs per event\n", npcCount, idsPerEvent);
+
+	size_t next = 0;
+	auto const perId = static_cast<double>(idsPerEvent);
+	auto const legacySpotted = Bench::run("Spotted: std::set + SA observers", [&] {
+		for (auto const& id : events[next++ % events.size()]) legacy.spotted(id);
+	});
+	auto const indexedSpotted = Bench::run("Spotted: NPCIndex + NPCSet + SA counts", [&] {
+		for (auto const& id : events[next++ % events.size()]) sets.spotted(id);
+	});
+	auto const legacyWitnesses = Bench::run("Witnesses: std::set + SA observers", [&] {
+		for (auto const& id : events[next++ % events.size()]) legacy.witnessed(id);
+	});
+	auto const indexedWitnesses = Bench::run("Witnesses: NPCIndex + NPCSet + SA counts", [&] {
+		for (auto const& id : events[next++ % events.size()]) sets.witnessed(id);
+	});
+	Bench::run("SA spotted: filter std::sets", [&] {
+		doNotOptimize(legacy.isSpottedFiltered());
+	});
+	Bench::run("SA spotted: incremental counts", [&] {
+		doNotOptimize(legacy.isSpottedIncremental());
+	});
+	Bench::run("SA spotted: NPCSet::anyExcept", [&] {
+		doNotOptimize(sets.isSpottedFromSets());
+	});
+	Bench::run("SA spotted: SilentAssassinTracker", [&] {
+		doNotOptimize(sets.isSpotted());
+	});
+
+	std::printf("  %-48s %12.1f ns/ID\n", "Spotted: std::set + SA observers", legacySpotted / perId);
+	std::printf("  %-48s %12.1f ns/ID\n", "Spotted: NPCIndex + NPCSet + SA counts", indexedSpotted / perId);
+	std::printf("  %-48s %12.1f ns/ID\n", "Witnesses: std::set + SA observers", legacyWitnesses / perId);
+	std::printf("  %-48s %12.1f ns/ID\n", "Witnesses: NPCIndex + NPCSet + SA counts", indexedWitnesses / perId);
+}
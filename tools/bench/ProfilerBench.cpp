@@ -0,0 +1,26 @@
+#include <cstdint>
+#include "Bench.h"
+#include "Profiler.h"
+
+// What the always-on profiler adds to each timed section: recording a sample into a histogram, and a whole scope,
+// clock reads included. Summarizing is what the profiler window does each frame it's open.
+auto Bench::profiler() -> void {
+	auto histogram = LatencyHistogram();
+	uint64_t sample = 0;
+
+	Bench::run("record", [&] {
+		histogram.record(sample);
+		sample = (sample + 977) % 100000;
+	});
+
+	Bench::run("scope", [&] {
+		auto const scope = ProfileScope(histogram);
+	});
+
+	Bench::run("summarize", [&] {
+		auto const summary = histogram.summarize();
+		doNotOptimize(summary);
+	});
+
+	std::printf("  %-48s %12.1f KB\n", "histogram, size", sizeof(LatencyHistogram) / 1024.0);
+}
@@ -0,0 +1,82 @@
+#include <algorithm>
+#include <cctype>
+#include <set>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "Bench.h"
+#include "LegacyStrings.h"
+#include "RepoId.h"
+
+// Repository ID containers: the case-insensitive string sets the stats used to be kept in against RepoId keys.
+// Lookups use a mix of lowercase and uppercase IDs, as the game isn't consistent about which it sends.
+auto Bench::repoIds() -> void {
+	constexpr size_t count = 1000;
+
+	auto random = std::mt19937(4321);
+	auto ids = std::vector<std::string>();
+	for (size_t i = 0; i < count; ++i) {
+		ids.push_back(makeGuid(random));
+		if (i % 2) std::transform(ids[i].begin(), ids[i].end(), ids[i].begin(), [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+	}
+
+	auto parsed = std::vector<RepoId>();
+	for (auto const& id : ids) parsed.emplace_back(id);
+
+	std::printf("  %zu IDs\n", count);
+
+	auto const perId = static_cast<double>(count);
+	auto const parse = Bench::run("RepoId::parse", [&] {
+		auto id = RepoId();
+		size_t ok = 0;
+		for (auto const& str : ids) ok += RepoId::parse(str, id);
+		doNotOptimize(ok);
+	});
+	auto const hashString = Bench::run("LegacyHash", [&] {
+		size_t hash = 0;
+		for (auto const& str : ids) hash ^= LegacyHash()(str);
+		doNotOptimize(hash);
+	});
+	auto const hashId = Bench::run("RepoId::hash", [&] {
+		size_t hash = 0;
+		for (auto const& id : parsed) hash ^= id.hash();
+		doNotOptimize(hash);
+	});
+
+	auto const setString = Bench::run("set<string, LegacyCompareLexicographic>", [&] {
+		std::set<std::string, LegacyCompareLexicographic> set;
+		for (auto const& str : ids) set.emplace(str);
+		size_t found = 0;
+		for (auto const& str : ids) found += set.contains(str);
+		doNotOptimize(found);
+	});
+	auto const unorderedString = Bench::run("unordered_set<string, LegacyHash>", [&] {
+		std::unordered_set<std::string, LegacyHash, LegacyCompare> set;
+		for (auto const& str : ids) set.emplace(str);
+		size_t found = 0;
+		for (auto const& str : ids) found += set.contains(str);
+		doNotOptimize(found);
+	});
+	auto const setId = Bench::run("set<RepoId>", [&] {
+		std::set<RepoId> set;
+		for (auto const& id : parsed) set.emplace(id);
+		size_t found = 0;
+		for (auto const& id : parsed) found += set.contains(id);
+		doNotOptimize(found);
+	});
+	auto const unorderedId = Bench::run("unordered_set<RepoId>", [&] {
+		std::unordered_set<RepoId> set;
+		for (auto const& id : parsed) set.emplace(id);
+		size_t found = 0;
+		for (auto const& id : parsed) found += set.contains(id);
+		doNotOptimize(found);
+	});
+
+	std::printf("  %-48s %12.1f ns/id\n", "parse", parse / perId);
+	std::printf("  %-48s %12.1f ns/id\n", "hash (string)", hashString / perId);
+	std::printf("  %-48s %12.1f ns/id\n", "hash (RepoId)", hashId / perId);
+	std::printf("  %-48s %12.1f ns/id\n", "set insert + lookup (string)", setString / perId);
+	std::printf("  %-48s %12.1f ns/id\n", "unordered_set insert + lookup (string)", unorderedString / perId);
+	std::printf("  %-48s %12.1f ns/id\n", "set insert + lookup (RepoId)", setId / perId);
+	std::printf("  %-48s %12.1f ns/id\n", "unordered_set insert + lookup (RepoId)", unorderedId / perId);
+}
@@ -0,0 +1,74 @@
+#include <array>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "Bench.h"
+#include "LegacyStrings.h"
+#include "TargetRegistry.h"
+
+// Per-lookup cost of asking whether a repository ID is a target with 1000 actors loaded: the previous freelance
+// target set probe + scan of every actor slot against the target registry.
+auto Bench::targets() -> void {
+	struct Actor
+	{
+		bool isTarget = false;
+		std::string repoId;
+	};
+
+	auto random = std::mt19937(1234);
+
+	auto actors = std::array<Actor, 1000>();
+	auto freelanceTargets = std::unordered_set<std::string, LegacyHash, LegacyCompare>();
+	auto registry = TargetRegistry();
+	auto ids = std::vector<std::string>();
+
+	for (size_t i = 0; i < actors.size(); ++i) {
+		actors[i].repoId = makeGuid(random);
+		actors[i].isTarget = i % 200 == 0;
+		if (actors[i].isTarget) registry.add(RepoId(actors[i].repoId));
+		ids.push_back(actors[i].repoId);
+	}
+	for (auto i = 0; i < 3; ++i) {
+		auto const id = makeGuid(random);
+		freelanceTargets.emplace(id);
+		registry.add(RepoId(id));
+		ids.push_back(id);
+	}
+
+	// Events report IDs in mixed case, so look some of them up upper-cased.
+	for (size_t i = 0; i < ids.size(); i += 3) {
+		for (auto& c : ids[i]) c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+	}
+
+	// The registry is looked up with IDs already parsed when the event was decoded.
+	auto repoIds = std::vector<RepoId>();
+	for (auto const& id : ids) repoIds.emplace_back(id);
+
+	std::printf("  %zu actors, %zu targets, %zu lookups per op\n", actors.size(), registry.size(), ids.size());
+
+	auto const perLookup = static_cast<double>(ids.size());
+	auto const scan = Bench::run("freelance set + actor scan (all IDs)", [&] {
+		size_t found = 0;
+		for (auto const& id : ids) {
+			auto isTarget = freelanceTargets.contains(id);
+			for (auto const& actor : actors) {
+				if (isTarget) break;
+				if (!actor.isTarget) continue;
+				isTarget = LegacyCompare{}(id, actor.repoId);
+			}
+			found += isTarget;
+		}
+		doNotOptimize(found);
+	});
+	auto const indexed = Bench::run("target registry (all IDs)", [&] {
+		size_t found = 0;
+		for (auto const& id : repoIds)
+			found += registry.contains(id);
+		doNotOptimize(found);
+	});
+
+	std::printf("  %-48s %12.1f ns/lookup\n", "freelance set + actor scan", scan / perLookup);
+	std::printf("  %-48s %12.1f ns/lookup\n", "target registry", indexed / perLookup);
+}
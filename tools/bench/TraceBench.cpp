@@ -0,0 +1,46 @@
+#include <format>
+#include <random>
+#include <string>
+#include "Bench.h"
+#include "Enums.h"
+#include "Log.h"
+#include "RepoId.h"
+#include "Trace.h"
+
+// Cost on the recording thread of a behaviour change: formatting the debug line as the actor scan used to (which the
+// SDK's logger does whatever the level), and recording it with tracing off and on. The trace thread's formatting is
+// left out of the timings but still runs, with logging dropped.
+auto Bench::trace() -> void {
+	auto random = std::mt19937(1357);
+	auto const repoId = RepoId(makeGuid(random));
+	auto const behaviour = ECompiledBehaviorType::BT_AgitatedGuard;
+	auto const tension = getBehaviourTension(behaviour);
+	auto const record = TraceRecord::behaviourChanged(42, repoId, static_cast<int32_t>(behaviour), tension);
+
+	Bench::run("debug line, formatted", [&] {
+		auto line = std::format("{}: {}", behaviourToString(behaviour), tension);
+		doNotOptimize(line);
+	});
+
+	Bench::run("trace, disabled", [&] {
+		Trace::record(record);
+	});
+
+	auto const level = Logger::level;
+	Logger::level = Logger::Level::None;
+	Trace::start();
+	auto const before = Trace::getCounters();
+	Bench::run("trace, enabled", [&] {
+		Trace::record(record);
+	});
+	Trace::stop();
+	Logger::level = level;
+
+	auto const after = Trace::getCounters();
+	std::printf(
+		"  %-48s %12llu recorded, %llu dropped (ring full)\n",
+		"trace, enabled",
+		static_cast<unsigned long long>(after.recorded - before.recorded),
+		static_cast<unsigned long long>(after.dropped - before.dropped)
+	);
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include <string_view>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Read-only memory mapping of a whole file.
+class MappedFile
+{
+public:
+	MappedFile(const char* path) {
+#ifdef _WIN32
+		this->file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (this->file == INVALID_HANDLE_VALUE) return;
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(this->file, &size) || !size.QuadPart) return;
+
+		this->mapping = CreateFileMappingA(this->file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!this->mapping) return;
+
+		auto const view = MapViewOfFile(this->mapping, FILE_MAP_READ, 0, 0, 0);
+		if (view) this->view = std::string_view(static_cast<const char*>(view), static_cast<size_t>(size.QuadPart));
+#else
+		this->fd = ::open(path, O_RDONLY);
+		if (this->fd < 0) return;
+
+		struct stat st;
+		if (fstat(this->fd, &st) != 0 || !st.st_size) return;
+
+		auto const view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, this->fd, 0);
+		if (view != MAP_FAILED) this->view = std::string_view(static_cast<const char*>(view), static_cast<size_t>(st.st_size));
+#endif
+	}
+
+	MappedFile(const MappedFile&) = delete;
+	auto operator=(const MappedFile&) -> MappedFile& = delete;
+
+	~MappedFile() {
+#ifdef _WIN32
+		if (this->view.data()) UnmapViewOfFile(this->view.data());
+		if (this->mapping) CloseHandle(this->mapping);
+		if (this->file != INVALID_HANDLE_VALUE) CloseHandle(this->file);
+#else
+		if (this->view.data()) munmap(const_cast<char*>(this->view.data()), this->view.size());
+		if (this->fd >= 0) ::close(this->fd);
+#endif
+	}
+
+	auto isOpen() const -> bool {
+		return this->view.data() != nullptr;
+	}
+
+	auto data() const -> std::string_view {
+		return this->view;
+	}
+
+private:
+	std::string_view view;
+#ifdef _WIN32
+	HANDLE file = INVALID_HANDLE_VALUE;
+	HANDLE mapping = nullptr;
+#else
+	int fd = -1;
+#endif
+};
@@ -0,0 +1,82 @@
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include "EventJournal.h"
+#include "../common/MappedFile.h"
+
+static auto writeFile(const char* path, std::string_view data) -> bool {
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	file.write(data.data(), static_cast<std::streamsize>(data.size()));
+	return file.good();
+}
+
+static auto toText(std::string_view in, std::string& out) -> size_t {
+	auto decoder = EventJournalDecoder(in);
+	if (!decoder.isValid()) throw std::runtime_error("not a binary event journal");
+
+	auto entry = EventJournalEntry{};
+	std::string json;
+	size_t count = 0;
+
+	while (decoder.next(entry, json)) {
+		EventJournal::appendText(out, entry);
+		++count;
+	}
+	return count;
+}
+
+static auto toBinary(std::string_view in, std::string& out) -> size_t {
+	if (EventJournal::isBinary(in)) throw std::runtime_error("already a binary event journal");
+
+	auto const entries = EventJournal::parseText(in);
+	auto encoder = EventJournalEncoder();
+	out += encoder.header();
+
+	for (auto const& entry : entries)
+		encoder.encode(entry, out);
+
+	return entries.size();
+}
+
+static auto usage() -> int {
+	std::fprintf(stderr, "Usage: stealthometer-journal <command> <input> <output>\n");
+	std::fprintf(stderr, "  to-text     convert a binary journal to the text form (one JSON event per line)\n");
+	std::fprintf(stderr, "  to-binary   convert a text journal to the binary form the mod records\n");
+	return 1;
+}
+
+auto main(int argc, char** argv) -> int {
+	if (argc != 4) return usage();
+
+	auto const command = std::string_view(argv[1]);
+	auto const convert = command == "to-text" ? toText : command == "to-binary" ? toBinary : nullptr;
+	if (!convert) return usage();
+
+	auto const file = MappedFile(argv[2]);
+	if (!file.isOpen()) {
+		std::fprintf(stderr, "Failed to read %s\n", argv[2]);
+		return 1;
+	}
+
+	std::string out;
+	size_t count = 0;
+
+	try {
+		count = convert(file.data(), out);
+	}
+	catch (const std::exception& ex) {
+		std::fprintf(stderr, "Failed to convert %s: %s\n", argv[2], ex.what());
+		return 1;
+	}
+
+	if (!writeFile(argv[3], out)) {
+		std::fprintf(stderr, "Failed to write %s\n", argv[3]);
+		return 1;
+	}
+
+	std::printf("%zu events, %zu -> %zu bytes (%.1f%%)\n", count, file.data().size(), out.size(),
+		100.0 * static_cast<double>(out.size()) / static_cast<double>(file.data().size()));
+	return 0;
+}
@@ -0,0 +1,552 @@
+#include <algorithm>
+#include <chrono>
+#include <cmrc/cmrc.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+#include "EventJournal.h"
+#include "EventWorker.h"
+#include "json.hpp"
+#include "Log.h"
+#include "Memory.h"
+#include "Profiler.h"
+#include "RepoId.h"
+#include "StatTracker.h"
+#include "Timeline.h"
+#include "Trace.h"
+#include "../common/MappedFile.h"
+
+CMRC_DECLARE(stealthometer);
+
+using Clock = std::chrono::steady_clock;
+
+// The plugin learns which actors are targets from the game's actor data, which isn't part of the journal.
+// Instead, anything the journal's events flag with IsTarget is treated as a target from the start of each contract.
+class ReplayTracker : public StatTracker
+{
+public:
+	ReplayTracker(const std::unordered_set<RepoId>& journalTargets) : journalTargets(journalTargets)
+	{
+		this->AddJournalTargets();
+	}
+
+	// The SA status computed from scratch by checking each witness and spotter by ID, as it was before the tracker
+	// kept NPC bitsets and counts. Used to check that the two always agree.
+	auto GetReferenceSilentAssassinStatus() const -> SilentAssassinStatus {
+		auto nonTargetKills = this->stats.kills.nonTargets.size() + this->stats.kills.crowd;
+		if (nonTargetKills > 0) return SilentAssassinStatus::Fail;
+
+		if (this->CountLivingNonTargets(this->stats.witnesses) > 0 || this->CountLivingNonTargets(this->stats.spottedBy) > 0)
+			return SilentAssassinStatus::Fail;
+
+		if (this->stats.bodies.foundMurderedByNonTarget > 0)
+			return SilentAssassinStatus::Fail;
+
+		auto spottedByTarget = this->stats.targetBodyWitnesses.size() > this->stats.bodies.targetBodyWitnessesKilled
+			|| this->stats.targetsSpottedBy.size() > this->stats.detection.targetsSpottedByAndKilled;
+
+		if (this->stats.detection.onCamera)
+			return spottedByTarget ? SilentAssassinStatus::RedeemableCameraAndTarget : SilentAssassinStatus::RedeemableCamera;
+
+		return spottedByTarget ? SilentAssassinStatus::RedeemableTarget : SilentAssassinStatus::OK;
+	}
+
+	// Whether the SA tracker's counts of living non-target witnesses and spotters are right. Checked separately from
+	// the status, which a non-target kill fails whatever the counts are.
+	auto CheckSilentAssassinCounts() const -> bool {
+		auto const& silentAssassin = this->stats.silentAssassin;
+		return silentAssassin.getNonTargetWitnesses() == this->CountLivingNonTargets(this->stats.witnesses)
+			&& silentAssassin.getNonTargetSpotters() == this->CountLivingNonTargets(this->stats.spottedBy);
+	}
+
+	// Whether the witness event store's latest bucket and a range query agree with scanning every retained event, as
+	// the handlers did before the store. Checked against the latest event's timestamp.
+	auto CheckWitnessEvents() const -> bool {
+		auto const& store = this->stats.witnessEvents;
+		auto const events = store.getEvents();
+		if (events.empty()) return true;
+
+		auto const now = events.back().timestamp;
+		size_t latest = 0;
+		for (auto it = events.rbegin(); it != events.rend() && it->timestamp == now; ++it) ++latest;
+
+		constexpr double window = 10;
+		size_t inWindow = 0;
+		for (auto const& ev : events) inWindow += ev.timestamp >= now - window && ev.timestamp <= now;
+
+		auto const bucket = store.getLatest(now);
+		auto const range = store.getRange(now - window, now);
+		return bucket.size() == latest && bucket.data() == events.data() + events.size() - latest
+			&& range.size() == inWindow && (range.empty() || range.back().timestamp == now);
+	}
+
+	// Arena use of each contract the journal finished, followed by the one still in progress.
+	auto GetContractMemory() const -> std::vector<ContractMemoryInfo> {
+		auto contracts = this->contractMemory;
+		contracts.push_back(ContractMemoryInfo{
+			.allocations = this->contractArena.getAllocations(),
+			.bytes = this->contractArena.getBytesUsed(),
+			.reservedBytes = this->contractArena.getBytesReserved(),
+		});
+		return contracts;
+	}
+
+protected:
+	auto NewContract() -> void override {
+		StatTracker::NewContract();
+		if (this->GetLastContractMemoryInfo().allocations)
+			this->contractMemory.push_back(this->GetLastContractMemoryInfo());
+		this->AddJournalTargets();
+	}
+
+private:
+	auto AddJournalTargets() -> void {
+		for (auto const& id : this->journalTargets)
+			this->AddTarget(id);
+	}
+
+	// Members of the set which are neither killed nor targets, looking each up by ID.
+	auto CountLivingNonTargets(const NPCSet& set) const -> int {
+		auto count = 0;
+		this->stats.npcs.forEachId(set, [&](const RepoId& id) {
+			auto const killed = this->stats.npcs.contains(this->stats.kills.targets, id) || this->stats.npcs.contains(this->stats.kills.nonTargets, id);
+			count += !killed && !this->IsRepoIdTargetNPC(id);
+		});
+		return count;
+	}
+
+private:
+	const std::unordered_set<RepoId>& journalTargets;
+	std::vector<ContractMemoryInfo> contractMemory;
+};
+
+struct ReplayResult
+{
+	std::vector<double> latencies;
+	double seconds = 0;
+	uint64_t handled = 0;
+	uint64_t errors = 0;
+	uint64_t silentAssassinMismatches = 0;
+	uint64_t witnessMismatches = 0;
+	bool checkSilentAssassin = false;
+	bool checkWitnesses = false;
+	// From creating the first tracker (including loading the repo) to its first event being handled.
+	Clock::time_point started;
+	double firstEventSeconds = 0;
+};
+
+// Loads a text or binary journal. Binary events are decoded back to JSON into storage, as the tracker consumes text.
+static auto loadJournal(std::string_view data, std::vector<std::string>& storage) -> std::vector<EventJournalEntry> {
+	if (!EventJournal::isBinary(data)) return EventJournal::parseText(data);
+
+	std::vector<EventJournalEntry> entries;
+	auto decoder = EventJournalDecoder(data);
+	auto entry = EventJournalEntry{};
+	std::string json;
+
+	while (decoder.next(entry, json)) {
+		storage.push_back(json);
+		entries.push_back(entry);
+	}
+
+	// Views are only taken once storage has stopped reallocating.
+	for (size_t i = 0; i < entries.size(); ++i)
+		entries[i].data = storage[i];
+
+	return entries;
+}
+
+static auto collectTargets(const std::vector<EventJournalEntry>& entries) {
+	std::unordered_set<RepoId> targets;
+
+	for (auto const& entry : entries) {
+		auto const json = nlohmann::json::parse(entry.data.begin(), entry.data.end(), nullptr, false);
+		if (!json.is_object()) continue;
+		auto const value = json.find("Value");
+		if (value == json.end() || !value->is_object()) continue;
+		if (!value->value("IsTarget", false)) continue;
+		auto const id = RepoId(value->value("RepositoryId", ""));
+		if (!id.empty()) targets.emplace(id);
+	}
+
+	return targets;
+}
+
+static auto loadTracker(ReplayTracker& tracker) -> void {
+	auto const fs = cmrc::stealthometer::get_filesystem();
+	auto const repo = fs.open("data/repo.bin");
+	tracker.LoadRepository(std::string_view(repo.begin(), repo.size()));
+}
+
+static auto handleEvent(ReplayTracker& tracker, std::string_view data, ReplayResult& result) -> void {
+	try {
+		result.handled += tracker.HandleEvent(data);
+	}
+	catch (const nlohmann::json::exception& ex) {
+		++result.errors;
+		Logger::Error("JSON exception: {}", ex.what());
+	}
+	catch (const std::exception& ex) {
+		++result.errors;
+		Logger::Error("Exception handling event: {}", ex.what());
+	}
+
+	if (!result.firstEventSeconds)
+		result.firstEventSeconds = std::chrono::duration<double>(Clock::now() - result.started).count();
+}
+
+// Feeds every event straight through on this thread, timing each one. Display stats are committed whenever the
+// recorded frame number moves on, as the plugin does once per frame.
+static auto replayDirect(ReplayTracker& tracker, const std::vector<EventJournalEntry>& entries, ReplayResult& result) -> void {
+	auto const start = Clock::now();
+	auto frame = entries.front().frame;
+
+	for (auto const& entry : entries) {
+		auto const eventStart = Clock::now();
+		if (entry.frame != frame) {
+			tracker.CommitDisplayStats();
+			frame = entry.frame;
+		}
+		handleEvent(tracker, entry.data, result);
+		result.latencies.push_back(std::chrono::duration<double, std::nano>(Clock::now() - eventStart).count());
+
+		if (result.checkSilentAssassin && (tracker.GetSilentAssassinStatus() != tracker.GetReferenceSilentAssassinStatus() || !tracker.CheckSilentAssassinCounts())) {
+			if (!result.silentAssassinMismatches++)
+				std::fprintf(stderr, "SA status mismatch after event %zu: %.*s\n", static_cast<size_t>(&entry - entries.data()), static_cast<int>(entry.data.size()), entry.data.data());
+		}
+
+		if (result.checkWitnesses && !tracker.CheckWitnessEvents()) {
+			if (!result.witnessMismatches++)
+				std::fprintf(stderr, "Witness event mismatch after event %zu: %.*s\n", static_cast<size_t>(&entry - entries.data()), static_cast<int>(entry.data.size()), entry.data.data());
+		}
+	}
+
+	tracker.CommitDisplayStats();
+
+	result.seconds += std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Posts every event to an EventWorker as the plugin does in threaded mode. Latency is measured from posting to the
+// handler finishing, so it includes time spent queued behind earlier events.
+static auto replayThreaded(ReplayTracker& tracker, const std::vector<EventJournalEntry>& entries, ReplayResult& result) -> void {
+	EventWorker worker;
+	auto const start = Clock::now();
+
+	worker.start([&](std::string_view data, EventWorker::Clock::time_point pushed) {
+		handleEvent(tracker, data, result);
+		result.latencies.push_back(std::chrono::duration<double, std::nano>(EventWorker::Clock::now() - pushed).count());
+	});
+
+	// Events too large for the ring are handled here once the worker has caught up, as the plugin does.
+	for (auto const& entry : entries) {
+		if (worker.post(entry.data)) continue;
+		worker.drain();
+		handleEvent(tracker, entry.data, result);
+	}
+
+	worker.stop();
+	tracker.CommitDisplayStats();
+	result.seconds += std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+static auto getSilentAssassinName(SilentAssassinStatus status) -> const char* {
+	switch (status) {
+		case SilentAssassinStatus::OK: return "OK";
+		case SilentAssassinStatus::Fail: return "Fail";
+		case SilentAssassinStatus::RedeemableCamera: return "Redeemable (camera)";
+		case SilentAssassinStatus::RedeemableTarget: return "Redeemable (target)";
+		case SilentAssassinStatus::RedeemableCameraAndTarget: return "Redeemable (camera and target)";
+	}
+	return "?";
+}
+
+static auto getKillMethodName(KillMethod method) -> const char* {
+	switch (method) {
+		case KillMethod::Accident: return "accident";
+		case KillMethod::Headshot: return "headshot";
+		case KillMethod::Melee: return "melee";
+		case KillMethod::Unarmed: return "unarmed";
+		case KillMethod::Thrown: return "thrown";
+		case KillMethod::Pistol: return "pistol";
+		case KillMethod::SMG: return "smg";
+		case KillMethod::Shotgun: return "shotgun";
+		case KillMethod::PistolElim: return "pistol elimination";
+		case KillMethod::SilencedWeapon: return "silenced weapon";
+		case KillMethod::Drown: return "drown";
+		case KillMethod::Push: return "push";
+		case KillMethod::Burn: return "burn";
+		case KillMethod::AccidentExplosion: return "accident explosion";
+		case KillMethod::FallingObject: return "falling object";
+		case KillMethod::None: break;
+	}
+	return "?";
+}
+
+static auto printStats(const StatTracker& tracker) -> void {
+	auto const& stats = tracker.GetStats();
+	auto const& display = tracker.GetDisplayStats();
+	auto const playStyle = display.playstyle.rating ? display.playstyle.rating->getTitle(display.playstyle.index).c_str() : "-";
+
+	std::printf("DisplayStats\n");
+	std::printf("  %-28s %s\n", "silentAssassin", getSilentAssassinName(display.silentAssassin));
+	std::printf("  %-28s %.2f\n", "stealthRating", display.stealthRating);
+	std::printf("  %-28s %s\n", "playstyle", playStyle);
+	std::printf("  %-28s %d\n", "tension", display.tension);
+	std::printf("  %-28s %d\n", "spotted", display.spotted);
+	std::printf("  %-28s %d\n", "witnesses", display.witnesses);
+	std::printf("  %-28s %d\n", "bodiesFound", display.bodiesFound);
+	std::printf("  %-28s %d\n", "bodiesHidden", display.bodiesHidden);
+	std::printf("  %-28s %d\n", "guardKills", display.guardKills);
+	std::printf("  %-28s %d\n", "civilianKills", display.civilianKills);
+	std::printf("  %-28s %d\n", "noticedKills", display.noticedKills);
+	std::printf("  %-28s %d\n", "pacifications", display.pacifications);
+	std::printf("  %-28s %d\n", "disguisesTaken", display.disguisesTaken);
+	std::printf("  %-28s %d\n", "disguisesBlown", display.disguisesBlown);
+	std::printf("  %-28s %s\n", "recorded", display.recorded ? "yes" : "no");
+	std::printf("  %-28s %s\n", "targetsFound", display.targetsFound ? "yes" : "no");
+
+	std::printf("Stats\n");
+	std::printf("  %-28s %d (%zu targets, %zu non-targets, %d crowd)\n", "kills", stats.kills.total, stats.kills.targets.size(), stats.kills.nonTargets.size(), stats.kills.crowd);
+	std::printf("  %-28s %d (%d noticed, %d unnoticed)\n", "pacifies", stats.pacifies.total, stats.pacifies.noticed, stats.pacifies.unnoticed);
+	std::printf("  %-28s %d (%d murdered, %d accidents, %d crowd)\n", "bodies found", stats.bodies.found, stats.bodies.foundMurdered, stats.bodies.foundAccidents, stats.bodies.foundCrowd);
+	std::printf("  %-28s %zu (%zu targets)\n", "spotted by", stats.spottedBy.size(), stats.targetsSpottedBy.size());
+	std::printf("  %-28s %zu (%d killed)\n", "witnesses", stats.witnesses.size(), stats.detection.witnessesKilled);
+	std::printf("  %-28s %s\n", "on camera", stats.detection.onCamera ? "yes" : "no");
+	std::printf("  %-28s %zu obtained, %zu disposed\n", "items", stats.itemsObtained.size(), stats.itemsDisposed.size());
+	std::printf("  %-28s %d\n", "tension level", stats.tension.level);
+	std::printf("  %-28s %zu (%zu retained)\n", "witness events", stats.witnessEvents.getAdded(), stats.witnessEvents.size());
+
+	std::printf("Kill methods\n");
+	for (size_t i = 0; i < static_cast<size_t>(KillMethod::None); ++i) {
+		auto const method = static_cast<KillMethod>(i);
+		if (!stats.killMethods.get(method) && !stats.pacifyMethods.get(method)) continue;
+		std::printf("  %-28s %d kills (%d targets), %d pacifies\n", getKillMethodName(method), stats.killMethods.get(method), stats.killMethods.getTargets(method), stats.pacifyMethods.get(method));
+	}
+}
+
+// Events nothing handled, by name, from the last tracker's history.
+static auto printUnhandledEvents(const StatTracker& tracker) -> void {
+	auto const& history = tracker.GetEventHistory();
+	std::printf("Event history (%llu recorded, %zu kept)\n", static_cast<unsigned long long>(history.getTotal()), history.size());
+
+	for (size_t i = 0; i < EventCount; ++i) {
+		auto const event = static_cast<Events>(i);
+		if (auto const count = history.getUnhandledCount(event)) {
+			auto const name = getEventName(event);
+			std::printf("  %-28.*s %llu unhandled\n", static_cast<int>(name.size()), name.data(), static_cast<unsigned long long>(count));
+		}
+	}
+	history.forEachUnknown([](std::string_view name, uint64_t count) {
+		std::printf("  %-28.*s %llu unknown\n", static_cast<int>(name.size()), name.data(), static_cast<unsigned long long>(count));
+	});
+}
+
+static auto printDisplayUpdates(const StatTracker& tracker) -> void {
+	auto const& counters = tracker.GetDisplayUpdateCounters();
+	std::printf("Display updates (last contract)\n");
+	std::printf("  %-28s %d\n", "requested", counters.requested);
+	std::printf("  %-28s %d (%d saved)\n", "committed", counters.committed, counters.requested - counters.committed);
+	std::printf("  %-28s %d\n", "silent assassin checks", counters.silentAssassin);
+	std::printf("  %-28s %d\n", "stealth rating checks", counters.stealthRating);
+	std::printf("  %-28s %d\n", "play style checks", counters.playStyle);
+}
+
+static auto printLatencies(std::vector<double>& latencies) -> void {
+	if (latencies.empty()) return;
+	std::sort(latencies.begin(), latencies.end());
+
+	auto const percentile = [&](double p) {
+		auto const index = static_cast<size_t>(p / 100.0 * static_cast<double>(latencies.size() - 1));
+		return latencies[index];
+	};
+
+	std::printf("  %-28s %12.1f ns\n", "p50", percentile(50));
+	std::printf("  %-28s %12.1f ns\n", "p90", percentile(90));
+	std::printf("  %-28s %12.1f ns\n", "p99", percentile(99));
+	std::printf("  %-28s %12.1f ns\n", "p99.9", percentile(99.9));
+	std::printf("  %-28s %12.1f ns\n", "max", latencies.back());
+}
+
+// Heap held by the last tracker at the end of the replay, and the peak over the whole run.
+static auto printMemory(const StatTracker& tracker) -> void {
+	std::printf("Memory\n");
+	Memory::forEachSubsystem([](MemorySubsystem subsystem, const MemoryUsage& usage) {
+		std::printf("  %-28s %10lld live %10lld peak %10llu allocations\n", Memory::getSubsystemName(subsystem), static_cast<long long>(usage.liveBytes),
+			static_cast<long long>(usage.peakBytes), static_cast<unsigned long long>(usage.allocations));
+	});
+	std::printf("  %-28s %10zu embedded\n", "repo index", tracker.GetRepositoryLoadInfo().bytes);
+}
+
+static auto printContractMemory(const ReplayTracker& tracker) -> void {
+	auto const contracts = tracker.GetContractMemory();
+	std::printf("Contract arena (%zu KB reserved in %zu blocks)\n", tracker.GetContractArena().getBytesReserved() / 1024, tracker.GetContractArena().getBlockCount());
+
+	for (size_t i = 0; i < contracts.size(); ++i) {
+		auto const& contract = contracts[i];
+		auto const last = i + 1 == contracts.size();
+		std::printf("  %-28s %10llu allocations %10zu bytes", last ? "current" : ("contract " + std::to_string(i + 1)).c_str(),
+			static_cast<unsigned long long>(contract.allocations), contract.bytes);
+		if (!last) std::printf(" %8.2f us reset", contract.resetMicroseconds);
+		std::printf("\n");
+	}
+}
+
+// The same histograms the plugin's profiler window shows, over every replay. Only the parts of the mod the tracker
+// covers are timed here; the hook, frame and UI sections stay empty.
+static auto printProfile() -> void {
+	std::printf("Profiler\n");
+	std::fflush(stdout);
+	Profiler::writeReport(std::cout);
+	std::cout.flush();
+}
+
+static auto printTimeline(const char* path) -> void {
+	auto const counters = Timeline::getCounters();
+	std::printf("Timeline (%s)\n", path);
+	std::printf("  %-28s %12llu\n", "recorded", static_cast<unsigned long long>(counters.recorded));
+	std::printf("  %-28s %12llu\n", "dropped", static_cast<unsigned long long>(counters.dropped));
+	std::printf("  %-28s %12llu\n", "written", static_cast<unsigned long long>(counters.written));
+}
+
+static auto printTrace() -> void {
+	auto const counters = Trace::getCounters();
+	std::printf("Trace\n");
+	std::printf("  %-28s %12llu\n", "recorded", static_cast<unsigned long long>(counters.recorded));
+	std::printf("  %-28s %12llu\n", "dropped", static_cast<unsigned long long>(counters.dropped));
+	std::printf("  %-28s %12llu\n", "logged", static_cast<unsigned long long>(counters.formatted));
+}
+
+static auto usage() -> int {
+	std::fprintf(stderr, "Usage: stealthometer-replay [--threaded] [--check-sa] [--check-witnesses] [--witness-retention S] [--repeat N] [--profile] [--timeline FILE] [--trace] [--verbose] <journal>\n");
+	std::fprintf(stderr, "  --threaded              dispatch through an EventWorker, as with threaded event processing\n");
+	std::fprintf(stderr, "  --check-sa              compare the SA status against a from-scratch evaluation after every event (direct only)\n");
+	std::fprintf(stderr, "  --check-witnesses       compare witness event lookups against scanning the whole store after every event (direct only)\n");
+	std::fprintf(stderr, "  --witness-retention S   keep witness events for S seconds of game time\n");
+	std::fprintf(stderr, "  --repeat N              replay the journal N times with a fresh tracker each time\n");
+	std::fprintf(stderr, "  --profile               report the mod's profiler histograms for the parse, dispatch, handlers and display stats\n");
+	std::fprintf(stderr, "  --timeline FILE         write a Chrome trace-event timeline of the replay to FILE\n");
+	std::fprintf(stderr, "  --trace                 log the traced events to stderr as the mod does with tracing enabled\n");
+	std::fprintf(stderr, "  --verbose               enable the mod's info and debug logging (slows the replay down)\n");
+	return 1;
+}
+
+auto main(int argc, char** argv) -> int {
+	const char* path = nullptr;
+	auto threaded = false;
+	auto repeat = 1;
+	auto checkSilentAssassin = false;
+	auto checkWitnesses = false;
+	auto witnessRetention = -1.0;
+	auto trace = false;
+	auto profile = false;
+	const char* timeline = nullptr;
+
+	for (auto i = 1; i < argc; ++i) {
+		auto const arg = std::string_view(argv[i]);
+		if (arg == "--threaded") threaded = true;
+		else if (arg == "--check-sa") checkSilentAssassin = true;
+		else if (arg == "--check-witnesses") checkWitnesses = true;
+		else if (arg == "--witness-retention" && i + 1 < argc) witnessRetention = std::max(std::atof(argv[++i]), 0.0);
+		else if (arg == "--profile") profile = true;
+		else if (arg == "--timeline" && i + 1 < argc) timeline = argv[++i];
+		else if (arg == "--trace") trace = true;
+		else if (arg == "--verbose") Logger::level = Logger::Level::Debug;
+		else if (arg == "--repeat" && i + 1 < argc) repeat = std::max(std::atoi(argv[++i]), 1);
+		else if (!path && !arg.starts_with("--")) path = argv[i];
+		else return usage();
+	}
+
+	if (!path) return usage();
+
+	auto const file = MappedFile(path);
+	if (!file.isOpen()) {
+		std::fprintf(stderr, "Failed to read %s\n", path);
+		return 1;
+	}
+
+	std::vector<std::string> storage;
+	auto const loadStart = Clock::now();
+	auto entries = std::vector<EventJournalEntry>();
+
+	try {
+		entries = loadJournal(file.data(), storage);
+	}
+	catch (const std::exception& ex) {
+		std::fprintf(stderr, "Failed to load %s: %s\n", path, ex.what());
+		return 1;
+	}
+
+	auto const loadSeconds = std::chrono::duration<double>(Clock::now() - loadStart).count();
+
+	if (entries.empty()) {
+		std::fprintf(stderr, "No events in %s\n", path);
+		return 1;
+	}
+
+	auto const targets = collectTargets(entries);
+	auto result = ReplayResult{};
+	result.checkSilentAssassin = checkSilentAssassin;
+	result.checkWitnesses = checkWitnesses;
+	auto tracker = std::unique_ptr<ReplayTracker>();
+	result.latencies.reserve(entries.size() * repeat);
+
+	if (trace) {
+		Logger::level = std::min(Logger::level, Logger::Level::Info);
+		Trace::start();
+	}
+
+	if (timeline) {
+		if (!Timeline::start(timeline)) {
+			std::fprintf(stderr, "Failed to open %s\n", timeline);
+			return 1;
+		}
+		Timeline::setThreadName("Replay");
+	}
+
+	result.started = Clock::now();
+
+	for (auto i = 0; i < repeat; ++i) {
+		tracker = std::make_unique<ReplayTracker>(targets);
+		loadTracker(*tracker);
+		if (witnessRetention >= 0) tracker->SetWitnessRetention(witnessRetention);
+
+		if (threaded) replayThreaded(*tracker, entries, result);
+		else replayDirect(*tracker, entries, result);
+	}
+
+	// Formats whatever the trace thread hasn't yet, before the report.
+	Trace::stop();
+	Timeline::stop();
+
+	auto const total = static_cast<double>(entries.size()) * repeat;
+
+	std::printf("Replayed %zu events x%d (%s) from %s\n", entries.size(), repeat, threaded ? "threaded" : "direct", path);
+	std::printf("  %-28s %12.3f ms (%zu bytes, %s)\n", "load", loadSeconds * 1000.0, file.data().size(), EventJournal::isBinary(file.data()) ? "binary" : "text");
+	auto const& repo = tracker->GetRepositoryLoadInfo();
+	std::printf("  %-28s %12.3f ms (%zu items, %zu NPCs)\n", "repo load", repo.milliseconds, repo.items, repo.npcs);
+	std::printf("  %-28s %12.3f ms\n", "first event", result.firstEventSeconds * 1000.0);
+	std::printf("  %-28s %12llu\n", "handled", static_cast<unsigned long long>(result.handled));
+	std::printf("  %-28s %12llu\n", "errors", static_cast<unsigned long long>(result.errors));
+	if (checkSilentAssassin)
+		std::printf("  %-28s %12llu\n", "SA mismatches", static_cast<unsigned long long>(result.silentAssassinMismatches));
+	if (checkWitnesses)
+		std::printf("  %-28s %12llu\n", "witness mismatches", static_cast<unsigned long long>(result.witnessMismatches));
+	std::printf("  %-28s %12.3f ms\n", "total", result.seconds * 1000.0);
+	std::printf("  %-28s %12.0f\n", "events/sec", total / result.seconds);
+	printLatencies(result.latencies);
+	printStats(*tracker);
+	printDisplayUpdates(*tracker);
+	printUnhandledEvents(*tracker);
+	printMemory(*tracker);
+	printContractMemory(*tracker);
+	if (profile) printProfile();
+	if (timeline) printTimeline(timeline);
+	if (trace) printTrace();
+	return 0;
+}
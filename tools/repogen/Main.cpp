@@ -0,0 +1,157 @@
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "json.hpp"
+#include "Enums.h"
+#include "RepoId.h"
+#include "RepoIndex.h"
+#include "../common/MappedFile.h"
+
+using namespace RepoIndexFormat;
+
+// Deduplicating string pool. Many NPCs share a name and many items share a type or icon.
+class StringPool
+{
+public:
+	auto add(std::string_view str) -> StringRef {
+		auto [it, inserted] = this->offsets.try_emplace(std::string(str), static_cast<uint32_t>(this->data.size()));
+		if (inserted) this->data += str;
+		return {it->second, static_cast<uint32_t>(str.size())};
+	}
+
+	auto getData() const -> const std::string& {
+		return this->data;
+	}
+
+private:
+	std::string data;
+	std::unordered_map<std::string, uint32_t> offsets;
+};
+
+// Returns the ID of a repo/npc entry, or an empty ID if it doesn't have a valid one.
+static auto getEntryId(const nlohmann::json& entry) -> RepoId {
+	if (!entry.is_object()) return {};
+	auto const id = entry.find("ID_");
+	if (id == entry.end() || !id->is_string()) return {};
+	return RepoId(id->get_ref<const std::string&>());
+}
+
+static auto getString(const nlohmann::json& entry, const char* key) -> std::string_view {
+	auto const it = entry.find(key);
+	if (it == entry.end() || !it->is_string()) return {};
+	return it->get_ref<const std::string&>();
+}
+
+template<typename TRecord>
+static auto sortRecords(std::vector<TRecord>& records) -> void {
+	// Entries are unique by ID, but if that ever changes, keep the first as the JSON loaders did.
+	std::stable_sort(records.begin(), records.end(), [](const TRecord& a, const TRecord& b) {
+		return RepoId(a.idHigh, a.idLow) < RepoId(b.idHigh, b.idLow);
+	});
+	records.erase(std::unique(records.begin(), records.end(), [](const TRecord& a, const TRecord& b) {
+		return a.idHigh == b.idHigh && a.idLow == b.idLow;
+	}), records.end());
+}
+
+static auto parseFile(const char* path) -> nlohmann::json {
+	auto const file = MappedFile(path);
+	if (!file.isOpen()) throw std::runtime_error(std::string("failed to read ") + path);
+
+	auto json = nlohmann::json::parse(file.data().begin(), file.data().end());
+	if (!json.is_array()) throw std::runtime_error(std::string(path) + " is not an array");
+	return json;
+}
+
+static auto build(const char* repoPath, const char* npcPath) -> std::string {
+	auto const repo = parseFile(repoPath);
+	auto const npcs = parseFile(npcPath);
+
+	StringPool strings;
+	std::vector<ItemRecord> items;
+	std::vector<NPCRecord> npcRecords;
+
+	for (auto const& entry : repo) {
+		auto const id = getEntryId(entry);
+		if (id.empty()) continue;
+
+		auto const isHitmanSuit = entry.find("IsHitmanSuit");
+		auto const infoType = getItemInfoTypeFromRepo(getString(entry, "ItemType"), getString(entry, "InventoryCategoryIcon"));
+		items.push_back(ItemRecord{
+			.idHigh = id.high(),
+			.idLow = id.low(),
+			.title = strings.add(getString(entry, "Title")),
+			.commonName = strings.add(getString(entry, "CommonName")),
+			.flags = isHitmanSuit != entry.end() && isHitmanSuit->is_boolean() && isHitmanSuit->get<bool>() ? IsHitmanSuit : 0u,
+			.infoType = static_cast<uint32_t>(infoType),
+		});
+	}
+
+	for (auto const& entry : npcs) {
+		auto const id = getEntryId(entry);
+		if (id.empty()) continue;
+		auto const name = entry.find("Name");
+		if (name == entry.end() || !name->is_string()) continue;
+
+		npcRecords.push_back(NPCRecord{
+			.idHigh = id.high(),
+			.idLow = id.low(),
+			.name = strings.add(name->get_ref<const std::string&>()),
+		});
+	}
+
+	sortRecords(items);
+	sortRecords(npcRecords);
+
+	Header header{};
+	std::copy(std::begin(Magic), std::end(Magic), header.magic);
+	header.version = Version;
+	header.itemCount = static_cast<uint32_t>(items.size());
+	header.npcCount = static_cast<uint32_t>(npcRecords.size());
+	header.itemsOffset = sizeof(Header);
+	header.npcsOffset = header.itemsOffset + static_cast<uint32_t>(items.size() * sizeof(ItemRecord));
+	header.stringsOffset = header.npcsOffset + static_cast<uint32_t>(npcRecords.size() * sizeof(NPCRecord));
+	header.stringsSize = static_cast<uint32_t>(strings.getData().size());
+
+	std::string out;
+	out.append(reinterpret_cast<const char*>(&header), sizeof(header));
+	out.append(reinterpret_cast<const char*>(items.data()), items.size() * sizeof(ItemRecord));
+	out.append(reinterpret_cast<const char*>(npcRecords.data()), npcRecords.size() * sizeof(NPCRecord));
+	out += strings.getData();
+
+	std::printf("%zu items, %zu NPCs, %zu bytes of strings -> %zu bytes\n", items.size(), npcRecords.size(), strings.getData().size(), out.size());
+	return out;
+}
+
+// Compiles repo.json and npc.json into the binary index the mod embeds (see RepoIndex.h). Run as part of the build.
+auto main(int argc, char** argv) -> int {
+	static_assert(std::endian::native == std::endian::little, "the repo index is written in host byte order");
+
+	if (argc != 4) {
+		std::fprintf(stderr, "Usage: stealthometer-repogen <repo.json> <npc.json> <output>\n");
+		return 1;
+	}
+
+	std::string out;
+
+	try {
+		out = build(argv[1], argv[2]);
+	}
+	catch (const std::exception& ex) {
+		std::fprintf(stderr, "stealthometer-repogen: %s\n", ex.what());
+		return 1;
+	}
+
+	std::ofstream file(argv[3], std::ios::binary | std::ios::trunc);
+	file.write(out.data(), static_cast<std::streamsize>(out.size()));
+	if (!file.good()) {
+		std::fprintf(stderr, "stealthometer-repogen: failed to write %s\n", argv[3]);
+		return 1;
+	}
+	return 0;
+}